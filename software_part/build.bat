@@ -13,9 +13,9 @@ SET LKF_FILE=%OUT_DIR%\%TARGET%.lkf
 REM Base include folders (always needed)
 SET INCLUDE_FLAGS=-i"%COMPILER_PATH%\Hstm8" -i"platform_dependencies\registers_include"
 
-REM Auto-discover all include folders (folders with .h files)
+REM Auto-discover all include folders (folders with .h files, host tests excluded)
 echo Discovering include directories...
-for /f "delims=" %%D in ('dir /S /B /AD ^| findstr /V /I "Debug \.git"') do (
+for /f "delims=" %%D in ('dir /S /B /AD ^| findstr /V /I "Debug \.git \\tests"') do (
     if exist "%%D\*.h" (
         SET INCLUDE_FLAGS=!INCLUDE_FLAGS! -i"%%D"
     )
@@ -29,11 +29,11 @@ REM Clean old debug files
 del /Q %OUT_DIR%\*.sm8 %OUT_DIR%\*.map %OUT_DIR%\*.s19 %OUT_DIR%\*.ihx %OUT_DIR%\*.elf 2>NUL
 
 echo ==========================================
-echo [1/5] Compiling Source Files...
+echo [1/6] Compiling Source Files...
 echo ==========================================
 
-REM Compile ALL .c files recursively (except interrupt vectors)
-for /f "delims=" %%F in ('dir /S /B *.c ^| findstr /V /I "Debug stm8_interrupt_vector.c"') do (
+REM Compile ALL .c files recursively (except interrupt vectors and host tests)
+for /f "delims=" %%F in ('dir /S /B *.c ^| findstr /V /I "Debug stm8_interrupt_vector.c \\tests"') do (
     echo Compiling %%F...
     "%COMPILER_PATH%\cxstm8" +mods0 +debug -no %INCLUDE_FLAGS% -cl%OUT_DIR% -co%OUT_DIR% "%%F"
     if !errorlevel! neq 0 goto error
@@ -47,7 +47,7 @@ for /f "delims=" %%F in ('dir /S /B stm8_interrupt_vector.c 2^>NUL') do (
 )
 
 echo ==========================================
-echo [2/5] Generating Linker Script...
+echo [2/6] Generating Linker Script...
 echo ==========================================
 
 REM Generate LKF file
@@ -60,12 +60,18 @@ REM Generate LKF file
     echo # Segment Eeprom:
     echo +seg .eeprom -b 0x4000 -m 0x280 -n .eeprom
     echo # Segment Zero Page:
-    echo +seg .bsct   -b 0x0    -m 0x100 -n .bsct
+    echo +seg .bsct   -b 0x0    -m 0xd8  -n .bsct
     echo +seg .ubsct  -a .bsct           -n .ubsct
     echo +seg .bit    -a .ubsct          -n .bit   -id
     echo +seg .share  -a .bit            -n .share -is
-    echo # Segment Ram:
-    echo +seg .data   -b 0x100  -m 0x100 -n .data
+    echo # Segment No-init: top of zero page, not cleared by startup, survives reset.
+    echo # Fixed base and size: an oversized record or zero page data growing into
+    echo # it fails the link instead of overlapping the persistent record
+    echo +seg .noinit -b 0xd8   -m 0x28  -n .noinit
+    echo # Segment Ram: 0x100-0x27f, stack 0x280-0x3ff = 384 bytes, was 512.
+    echo # Static data no longer fits 0x100-0x1ff. Keep stack_monitor.h in sync:
+    echo # the log reports the peak stack depth measured on the board
+    echo +seg .data   -b 0x100  -m 0x180 -n .data
     echo +seg .bss    -a .data           -n .bss
     echo.
     
@@ -76,8 +82,8 @@ REM Generate LKF file
     echo # Object files list
 ) > "%LKF_FILE%"
 
-REM Add all object files EXCEPT interrupt vectors
-for /f "delims=" %%F in ('dir /S /B *.c ^| findstr /V /I "Debug stm8_interrupt_vector.c"') do (
+REM Add all object files EXCEPT interrupt vectors and host tests
+for /f "delims=" %%F in ('dir /S /B *.c ^| findstr /V /I "Debug stm8_interrupt_vector.c \\tests"') do (
     echo %OUT_DIR%\%%~nF.o >> "%LKF_FILE%"
 )
 
@@ -98,24 +104,35 @@ REM Add libraries and INTERRUPT VECTORS (vectors at the end!)
     echo +def __endzp=@.ubsct
     echo +def __memory=@.bss
     echo +def __startmem=@.bss
-    echo +def __endmem=0x1ff
+    echo +def __endmem=0x27f
     echo +def __stack=0x3ff
 ) >> "%LKF_FILE%"
 
 echo ==========================================
-echo [3/5] Linking...
+echo [3/6] Linking...
 echo ==========================================
 "%COMPILER_PATH%\clnk" -o %OUT_DIR%\%TARGET%.sm8 -m %OUT_DIR%\%TARGET%.map -l"%LIB_PATH%" "%LKF_FILE%"
 if !errorlevel! neq 0 goto error
 
 echo ==========================================
-echo [4/5] Converting to Hex...
+echo [4/6] Checking for floating-point runtime...
+echo ==========================================
+
+REM Firmware must stay float-free: fail if any Cosmic float helper got linked
+findstr /I /C:"c_fadd" /C:"c_fsub" /C:"c_fmul" /C:"c_fdiv" /C:"c_fcmp" /C:"c_fneg" /C:"c_ftol" /C:"c_ftoi" /C:"c_ltof" /C:"c_itof" /C:"c_uitof" /C:"c_ultof" /C:"c_ftoul" %OUT_DIR%\%TARGET%.map
+if !errorlevel! equ 0 (
+    echo Floating-point helpers found in %OUT_DIR%\%TARGET%.map
+    goto error
+)
+
+echo ==========================================
+echo [5/6] Converting to Hex...
 echo ==========================================
 "%COMPILER_PATH%\chex" -fi -o %OUT_DIR%\%TARGET%.ihx %OUT_DIR%\%TARGET%.sm8
 if !errorlevel! neq 0 goto error
 
 echo ==========================================
-echo [5/5] Creating Debug Info (ELF)...
+echo [6/6] Creating Debug Info (ELF)...
 echo ==========================================
 "%COMPILER_PATH%\cvdwarf" -o %OUT_DIR%\%TARGET%.elf %OUT_DIR%\%TARGET%.sm8
 if !errorlevel! neq 0 goto error
@@ -10,12 +10,29 @@
   * 
   * @note Підтримувані кнопки: MODE, UP, DOWN
   *
+  * Крім поточного стану, драйвер формує події натискання та
+  * відпускання (черга spsc_queue): обробник отримує кожне
+  * натискання рівно один раз, незалежно від тривалості утримання.
+  * Утримання кнопки додає події автоповтору з лічильником
+  * повторів - за ним споживач прискорює реакцію.
+  *
+  * Над потоком подій працює розпізнавач жестів (клік, подвійний
+  * клік, довге натискання, натискання при утриманій кнопці) -
+  * бізнес-логіка споживає жести через get_button_gesture().
+  *
+  * Межі рівнів кнопок калібруються покроково (калібрування
+  * веде бізнес-логіка за підказками button_calibration_process())
+  * і зберігаються в EEPROM.
+  *
   */
 
 
 #ifndef __BUTTONS_HANDLE_H
 #define __BUTTONS_HANDLE_H
 
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
 /**
  * @brief Ідентифікатори кнопок
  * 
@@ -23,6 +40,15 @@
  */
 
 
+//==================== DEFINES =========================
+
+/**
+ * @brief Кількість кнопок (BTN_MODE..BTN_DOWN)
+ * 
+ * Індекс у таблицях за кнопками - ButtonID - BTN_MODE.
+ */
+#define BUTTON_COUNT    3
+
 //==================== TYPEDEFS ========================
 
 typedef enum {
@@ -32,15 +58,74 @@ typedef enum {
     BTN_DOWN        /**< Кнопка зменшення порогового значення (threshold) на 10; Вхід в режим зміни порогового значення */
 } ButtonID;
 
+/**
+ * @brief Подія кнопки (зміна підтвердженого стану)
+ */
+typedef struct {
+    uint16_t time_ms;   /**< Час фронту - перше зчитування нового стану (молодші 16 біт системного часу), мс */
+    uint8_t  button;    /**< ButtonID */
+    uint8_t  pressed;   /**< 1 - натискання (або автоповтор), 0 - відпускання */
+    uint8_t  repeat;    /**< 0 - фронт, 1..255 - номер автоповтору (насичується) */
+} ButtonEvent;
+
+/**
+ * @brief Тип жесту
+ */
+typedef enum {
+    BUTTON_GESTURE_PRESS = 1,       /**< Натискання (фронт), одразу */
+    BUTTON_GESTURE_REPEAT,          /**< Автоповтор утримуваної кнопки */
+    BUTTON_GESTURE_CLICK,           /**< Коротке натискання (після відпускання / вікна подвійного кліку) */
+    BUTTON_GESTURE_DOUBLE_CLICK,    /**< Друге натискання у вікні подвійного кліку */
+    BUTTON_GESTURE_LONG_PRESS,      /**< Утримання довше порогу (одноразово, ще під час утримання) */
+    BUTTON_GESTURE_CHORD            /**< Натискання при утриманій іншій кнопці */
+} ButtonGestureType;
+
+/**
+ * @brief Розпізнаний жест
+ */
+typedef struct {
+    uint16_t time_ms;   /**< Момент, коли жест став однозначним (молодші 16 біт системного часу), мс */
+    uint16_t edge_ms;   /**< Час фронту, з якого почався жест (натискання; для CLICK - відпускання), мс */
+    uint8_t  type;      /**< ButtonGestureType */
+    uint8_t  button;    /**< ButtonID */
+    uint8_t  param;     /**< REPEAT - номер повтору, CHORD - утримана кнопка (ButtonID), інакше 0 */
+} ButtonGesture;
+
+/**
+ * @brief Пороги жестів для кожної кнопки (індекс - ButtonID - BTN_MODE)
+ * 
+ * Таблиця належить споживачу: вмикаються лише потрібні жести,
+ * щоб решта кнопок не чекала вікна подвійного кліку.
+ */
+typedef struct {
+    uint16_t long_press_ms[BUTTON_COUNT];   /**< Поріг довгого натискання (0 - вимкнено) */
+    uint16_t double_click_ms[BUTTON_COUNT]; /**< Вікно подвійного кліку (0 - клік одразу при відпусканні) */
+} ButtonGesturePolicy;
+
+/**
+ * @brief Крок калібрування драбини (підказка оператору)
+ */
+typedef enum {
+    BUTTON_CAL_OFF = 0,     /**< Калібрування не запускалось */
+    BUTTON_CAL_RELEASE,     /**< Відпустити всі кнопки */
+    BUTTON_CAL_PRESS_MODE,  /**< Натиснути та утримувати MODE */
+    BUTTON_CAL_PRESS_UP,    /**< Натиснути та утримувати UP */
+    BUTTON_CAL_PRESS_DOWN,  /**< Натиснути та утримувати DOWN */
+    BUTTON_CAL_DONE,        /**< Таблицю збережено та застосовано */
+    BUTTON_CAL_FAILED       /**< Рівні не розрізняються або помилка EEPROM */
+} ButtonCalibrationStep;
+
 
 //================== FUNCTIONS PROTOTYPES ==================
 
 /**
  * @brief Зчитати стан кнопок з дебаунсом
  * 
- * Виконує зчитування стану кнопок через ADC, декодування
- * аналогового значення в ідентифікатор кнопки та програмний
- * дебаунс для усунення помилкових спрацювань.
+ * Повертає останній підтверджений стан. Зчитування ADC,
+ * декодування аналогового значення в ідентифікатор кнопки
+ * та інтегруючий дебаунс виконуються у фоні, по одній
+ * вибірці ADC за тік - лише поки на драбині є активність;
+ * у спокої ADC чекає натискання на аналоговому watchdog.
  * 
  * @return Ідентифікатор натиснутої кнопки
  * @retval BTN_NONE Жодна кнопка не натиснута
@@ -48,16 +133,108 @@ typedef enum {
  * @retval BTN_UP   Натиснута кнопка UP
  * @retval BTN_DOWN Натиснута кнопка DOWN
  * 
- * @note Функція виконує блокуюче зчитування ADC з дебаунсом.
- *       Час виконання: ~100 мкс (без змін) або ~20 мс (при зміні стану)
+ * @note Не блокує: новий стан з'являється через
+ *       DEBOUNCE_DELAY_MS (20 мс) стабільного рівня на ADC
  * 
  * @warning ADC має бути попередньо ініціалізований
  * 
  * @see ButtonID
- * @see button_read()
- * @see debounce_button()
+ * @see get_button_event()
  */
 ButtonID get_button_value(void);
 
+/**
+ * @brief Зчитати наступну подію кнопки
+ * 
+ * Події формуються дебаунсом (переривання ADC) у момент
+ * підтвердження нового стану: відпускання попередньої
+ * кнопки, потім натискання нової.
+ * Час події - момент фронту, тобто на час дебаунсу раніше
+ * за появу події.
+ * 
+ * Поки кнопка утримується, через BUTTON_REPEAT_DELAY_MS після
+ * фронту і далі кожні BUTTON_REPEAT_PERIOD_MS додаються події
+ * натискання з repeat > 0 (час - момент повтору).
+ * 
+ * @param[out] event Кнопка, тип події та час
+ * 
+ * @return Наявність події
+ * @retval 1 Подія зчитана
+ * @retval 0 Нових подій немає
+ * 
+ * @note При переповненні черги (BUTTON_EVENT_QUEUE_SIZE)
+ *       нові події відкидаються
+ * 
+ * @see ButtonEvent
+ */
+uint8_t get_button_event(ButtonEvent *event);
+
+/**
+ * @brief Встановлення порогів жестів
+ * 
+ * @param[in] policy Таблиця порогів (має існувати весь час роботи)
+ * 
+ * @note Без таблиці всі жести, крім PRESS/REPEAT/CLICK/CHORD,
+ *       вимкнені
+ */
+void button_set_gesture_policy(const ButtonGesturePolicy *policy);
+
+/**
+ * @brief Зчитати наступний жест
+ * 
+ * Розпізнає жести з черги подій get_button_event() (її не
+ * слід читати паралельно) за таблицею переходів зі сталою
+ * пам'яттю. Таймаути (довге натискання, вікно подвійного
+ * кліку) рахуються за часом подій та системним часом, тому
+ * не залежать від частоти виклику.
+ * 
+ * Послідовності:
+ * - PRESS ... CLICK: коротке натискання
+ * - PRESS ... LONG_PRESS: утримання (клік після нього не видається)
+ * - PRESS, CLICK відкладається, DOUBLE_CLICK: два натискання
+ *   у вікні (кліку немає)
+ * - CHORD: на драбині одночасне натискання дає рівень однієї
+ *   кнопки, тому CHORD - це перехід з утримуваної кнопки на
+ *   іншу без відпускання (відпускання та натискання з одним
+ *   часом). Відпускання утримуваної не дає CLICK, натискання
+ *   нової - не дає PRESS/CLICK
+ * 
+ * @param[out] gesture Жест
+ * 
+ * @return Наявність жесту
+ * @retval 1 Жест зчитано
+ * @retval 0 Нових жестів немає
+ * 
+ * @note Викликається з основного циклу, поки не поверне 0
+ */
+uint8_t get_button_gesture(ButtonGesture *gesture);
+
+/**
+ * @brief Запуск калібрування драбини
+ * 
+ * ADC перестає переходити в очікування, щоб бачити рівень
+ * без натискань. Поки калібрування триває, події кнопок
+ * формуються за старою таблицею - їх слід ігнорувати.
+ * 
+ * @see button_calibration_process()
+ */
+void button_calibration_start(void);
+
+/**
+ * @brief Крок калібрування
+ * 
+ * Чекає, поки рівень ADC стабілізується на BUTTON_CAL_SETTLE_MS,
+ * та записує його для кнопки з підказки: спершу рівень без
+ * натискань, далі MODE, UP, DOWN, кожна з відпусканням після.
+ * Межі смуг - середини між сусідніми рівнями.
+ * 
+ * @return Поточна підказка; BUTTON_CAL_DONE / BUTTON_CAL_FAILED -
+ *         калібрування завершене (повертається до нового запуску)
+ * 
+ * @note Викликається періодично з основного циклу
+ * @warning На кроці збереження блокує до ~25 мс (запис EEPROM)
+ */
+ButtonCalibrationStep button_calibration_process(void);
+
 
 #endif /* __BUTTONS_HANDLE_H */
\ No newline at end of file
@@ -48,6 +48,16 @@
  */
 #define DISPLAY_BRIGHTNESS_DEFAULT  5
 
+//==================== TYPEDEFS ========================
+
+/**
+ * @brief Лічильники кадрів з моменту display_reset_frame_stats()
+ */
+typedef struct {
+    uint16_t sent;              /**< Кадри, передані в контролер (лише змінені розряди) */
+    uint16_t skipped;           /**< Кадри без змін, що не передавались */
+} DisplayFrameStats;
+
 //================== FUNCTION PROTOTYPES ==================
 
 /**
@@ -68,7 +78,7 @@ void initialize_display(void);
  * 
  * Підтримувані символи:
  * - Цифри: '0'-'9'
- * - Літери: A, b, C, E, F, H, L, P, r, U (верхній/нижній регістр)
+ * - Літери: A, b, C, d, E, F, H, L, n, o, P, r, U (верхній/нижній регістр)
  * - Спеціальні: ' ' (пробіл), '-' (дефіс), '_' (підкреслення)
  * 
  * @param[in] text Вказівник на null-terminated рядок для відображення
@@ -121,4 +131,22 @@ void display_show_threshold(uint16_t threshold);
  */
 void display_clear(void);
 
+/**
+ * @brief Лічильники переданих та пропущених кадрів
+ * 
+ * display_show_*() з тим самим вмістом, що вже на дисплеї,
+ * не звертаються до контролера і рахуються як пропущені.
+ * 
+ * @param[out] stats Лічильники з моменту останнього скидання
+ * 
+ * @note Лічильники 16-бітні: вікно звіту має бути коротшим
+ *       за ~65 тис. кадрів
+ */
+void display_get_frame_stats(DisplayFrameStats *stats);
+
+/**
+ * @brief Початок нового вікна обліку кадрів
+ */
+void display_reset_frame_stats(void);
+
 #endif /* __DISPLAY_H */
\ No newline at end of file
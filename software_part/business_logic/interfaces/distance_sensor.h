@@ -12,7 +12,8 @@
  * Принцип роботи:
  * 1. Датчик посилає ультразвуковий імпульс
  * 2. Вимірюється час відбиття сигналу (echo)
- * 3. Час конвертується у відстань (см або дюйми)
+ * 3. Час конвертується у відстань в міліметрах (фіксована кома)
+ * 4. Одиниці відображення (см або дюйми) отримуються з міліметрів
  * 
  * Діапазон вимірювань:
  * - Мінімум: 2 см
@@ -30,17 +31,53 @@
 
 //==================== DEFINES =========================
 
+/**
+ * @brief Кількість датчиків відстані (1-2)
+ * 
+ * Має збігатися з HCSR04_SENSOR_COUNT апаратного драйвера.
+ * Датчики вимірюють по черзі, по одному на період.
+ */
+#ifndef DISTANCE_SENSOR_COUNT
+#define DISTANCE_SENSOR_COUNT           1
+#endif
+
 /**
  * @brief Таймаут вимірювання в мікросекундах
  * 
  * Максимальний час очікування відбитого сигналу.
  * 30000 мкс відповідає максимальній відстані ~5 метрів.
+ * Дедлайн контролюється апаратно (TIM2, 1 тік = 1 мкс),
+ * допустимий діапазон: 1-65535 мкс.
  * 
  * Розрахунок: 
  * - Швидкість звуку = 340 м/с = 29 мкс/см (в один бік)
  * - Для 500 см туди-назад: 500 * 2 / 340 * 10^6 ≈ 29400 мкс
  */
-#define DISTANCE_SENSOR_TIMEOUT_US      30000UL
+#define DISTANCE_SENSOR_TIMEOUT_US      30000U
+
+/**
+ * @brief Час відновлення датчика після дедлайну ECHO (мкс)
+ * 
+ * HC-SR04 вимагає цикл вимірювання не менше 60 мс: після
+ * відсутності відбиття лінія ECHO може залишатись у HIGH
+ * ще деякий час, і новий TRIG до цього буде проігноровано.
+ */
+#define DISTANCE_SENSOR_ECHO_GUARD_US   30000U
+
+/**
+ * @brief Мінімальний допустимий період вимірювань (мкс)
+ * 
+ * Дедлайн ECHO + час відновлення = 60 мс (≈16.7 Гц).
+ */
+#define DISTANCE_SENSOR_MIN_PERIOD_US   (DISTANCE_SENSOR_TIMEOUT_US + DISTANCE_SENSOR_ECHO_GUARD_US)
+
+/**
+ * @brief Максимальна відстань в міліметрах
+ * 
+ * Внутрішнє представлення відстані. Усі одиниці відображення
+ * отримуються з цього значення.
+ */
+#define DISTANCE_SENSOR_MAX_MM          4000
 
 /**
  * @brief Максимальна відстань в сантиметрах
@@ -57,6 +94,96 @@
  */
 #define DISTANCE_SENSOR_MAX_INCH        157
 
+/**
+ * @brief Мінімальна тривалість ECHO валідного вимірювання (мкс)
+ * 
+ * 2 см * 58 мкс/см. Коротші імпульси - об'єкт у сліпій зоні датчика.
+ */
+#define DISTANCE_SENSOR_MIN_ECHO_US     116U
+
+/**
+ * @brief Максимальна тривалість ECHO валідного вимірювання (мкс)
+ * 
+ * DISTANCE_SENSOR_MAX_CM * 58 мкс/см.
+ */
+#define DISTANCE_SENSOR_MAX_ECHO_US     23200U
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Класифікація вимірювання
+ */
+typedef enum {
+    DISTANCE_STATUS_OK = 0,             /**< Валідне вимірювання */
+    DISTANCE_STATUS_NO_ECHO,            /**< Датчик не відповів на тригер */
+    DISTANCE_STATUS_ECHO_STUCK_HIGH,    /**< Лінія ECHO в HIGH на момент тригера */
+    DISTANCE_STATUS_TOO_CLOSE,          /**< Об'єкт ближче мінімальної відстані */
+    DISTANCE_STATUS_BEYOND_RANGE,       /**< Відбиття немає або об'єкт далі максимуму */
+    DISTANCE_STATUS_COUNT
+} DistanceStatus;
+
+/**
+ * @brief Результат одного вимірювання
+ */
+typedef struct {
+    uint32_t timestamp_us;      /**< Час тригера від старту вимірювань, мкс */
+    uint16_t ticks;             /**< Тривалість ECHO в тіках TIM2 (1 тік = 1 мкс) */
+    uint8_t  status;            /**< DistanceStatus */
+    uint8_t  sensor;            /**< Номер датчика (0 - DISTANCE_SENSOR_COUNT-1) */
+} DistanceResult;
+
+/**
+ * @brief Оцінка стану об'єкта трекером
+ * 
+ * Швидкість від'ємна, коли об'єкт наближається до датчика.
+ * Вікно [window_min_mm; window_max_mm] - діапазон, в якому
+ * очікується наступне вимірювання; значення поза ним
+ * відкидаються як фізично неможливий стрибок.
+ */
+typedef struct {
+    uint16_t distance_mm;       /**< Оцінка відстані, мм */
+    int16_t  velocity_mm_s;     /**< Оцінка швидкості, мм/с */
+    uint16_t window_min_mm;     /**< Нижня межа наступного вимірювання, мм */
+    uint16_t window_max_mm;     /**< Верхня межа наступного вимірювання, мм */
+} DistanceTrack;
+
+/**
+ * @brief Режими частоти вимірювань
+ */
+typedef enum {
+    DISTANCE_RATE_FAST = 0,     /**< Максимальна безпечна частота */
+    DISTANCE_RATE_SLOW,         /**< Keep-alive частота для стабільної сцени */
+    DISTANCE_RATE_MODE_COUNT
+} DistanceRateMode;
+
+/**
+ * @brief Політика адаптивної частоти вимірювань
+ * 
+ * Налаштовується бізнес-логікою та передається в
+ * distance_sensor_set_rate_policy().
+ */
+typedef struct {
+    uint16_t period_us;         /**< Період режиму FAST, мкс (>= DISTANCE_SENSOR_MIN_PERIOD_US) */
+    uint8_t  slow_divider;      /**< Режим SLOW: вимірювання в кожному N-му періоді */
+    uint16_t activity_mm;       /**< Зміна відстані між вимірюваннями, що вважається активністю */
+    uint8_t  settle_samples;    /**< Стабільних вимірювань поспіль до переходу в SLOW */
+} DistanceRatePolicy;
+
+/**
+ * @brief Статистика режиму частоти
+ * 
+ * Час простою - сон CPU між задачами (scheduler_idle()),
+ * поки діяв режим, тобто простій усієї системи, а не лише
+ * обробки вимірювань.
+ */
+typedef struct {
+    uint32_t samples;           /**< Кількість вимірювань */
+    uint32_t elapsed_ms;        /**< Час у режимі, мс */
+    uint32_t idle_ms;           /**< Час простою CPU у режимі, мс */
+    uint16_t samples_per_s_x10; /**< Середня частота, 0.1 вимірювання/с */
+    uint8_t  idle_percent;      /**< Частка часу простою CPU, % */
+} DistanceRateStats;
+
 
 //================== FUNCTIONS PROTOTYPES ==================
 
@@ -70,80 +197,217 @@
  * - Встановлення початкового стану
  * 
  * @note Має викликатись один раз при старті системи
- *       перед першим використанням distance_sensor_measure_raw()
+ *       перед distance_sensor_start_ranging()
  * 
- * @see distance_sensor_measure_raw()
+ * @see distance_sensor_start_ranging()
  */
 void initialize_distance_sensor(void);
 
 /**
- * @brief Вимірювання часу відбиття ультразвукового сигналу
+ * @brief Запуск вимірювань з фіксованою частотою
+ * 
+ * Вимірювання виконуються апаратним планувальником незалежно
+ * від основного циклу: кожні period_us мікросекунд генерується
+ * тригерний імпульс, фронти ECHO захоплюються в перериванні,
+ * а результат кладеться в невеликий буфер.
+ * 
+ * Частота вимірювань = 1000000 / period_us Гц і не залежить
+ * від тривалості відбиття, дебаунсу кнопок чи оновлення дисплея.
+ * 
+ * @param[in] period_us Період вимірювань в мікросекундах
+ *                      (DISTANCE_SENSOR_MIN_PERIOD_US - 65535)
+ *                      Менші значення обмежуються мінімумом
+ * 
+ * @note Має викликатись після initialize_distance_sensor()
+ * 
+ * @note Адаптивна частота вимикається, див.
+ *       distance_sensor_set_rate_policy()
+ * 
+ * @see distance_sensor_read()
+ * @see DISTANCE_SENSOR_MIN_PERIOD_US
+ */
+void distance_sensor_start_ranging(uint16_t period_us);
+
+/**
+ * @brief Запуск вимірювань з адаптивною частотою
+ * 
+ * Планувальник запускається з періодом policy->period_us
+ * (режим FAST). Кожне вимірювання порівнюється з попереднім:
+ * - зміна більше activity_mm - одразу режим FAST
+ * - settle_samples стабільних вимірювань поспіль - режим SLOW,
+ *   вимірювання лише в кожному slow_divider-му періоді
+ * 
+ * Перемикання не перезапускає таймер і не обриває поточне
+ * вимірювання. Лічильники статистики скидаються.
  * 
- * Функція виконує наступні кроки:
- * 1. Генерує тригерний імпульс (10 мкс)
- * 2. Очікує rising edge сигналу ECHO
- * 3. Вимірює тривалість HIGH рівня ECHO
- * 4. Повертає час у мікросекундах
+ * @param[in] policy Політика частоти (копіюється)
  * 
- * Час вимірювання відповідає подвійній відстані до об'єкта
+ * @note Має викликатись після initialize_distance_sensor()
+ * 
+ * @see distance_sensor_get_rate_mode()
+ * @see distance_sensor_get_rate_stats()
+ */
+void distance_sensor_set_rate_policy(const DistanceRatePolicy *policy);
+
+/**
+ * @brief Поточний режим частоти вимірювань
+ * 
+ * @return DISTANCE_RATE_FAST або DISTANCE_RATE_SLOW
+ */
+DistanceRateMode distance_sensor_get_rate_mode(void);
+
+/**
+ * @brief Статистика режиму частоти вимірювань
+ * 
+ * Повертає накопичені лічильники режиму та середні значення:
+ * вимірювань за секунду та частку часу простою CPU.
+ * 
+ * @param[in]  mode  Режим (DISTANCE_RATE_FAST / DISTANCE_RATE_SLOW)
+ * @param[out] stats Статистика режиму
+ * 
+ * @note Містить 32-бітні ділення - не для критичних ділянок
+ */
+void distance_sensor_get_rate_stats(DistanceRateMode mode, DistanceRateStats *stats);
+
+/**
+ * @brief Зчитування наступного вимірювання з буфера
+ * 
+ * Неблокуюча функція: повертає найстаріше непрочитане
+ * вимірювання. Час відповідає подвійній відстані до об'єкта
  * (сигнал проходить туди і назад).
  * 
- * @return Тривалість імпульсу ECHO в мікросекундах
- * @retval 0 Об'єкт не виявлено або перевищено таймаут
- * @retval >0 Виміряний час (58-23200 мкс для 1-400 см)
+ * Кожне вимірювання класифікується (DistanceStatus):
+ * - rising edge не було, ECHO в LOW      - NO_ECHO
+ * - rising edge не було, ECHO в HIGH     - ECHO_STUCK_HIGH
+ * - ECHO < DISTANCE_SENSOR_MIN_ECHO_US   - TOO_CLOSE
+ * - falling edge не було до дедлайну або
+ *   ECHO > DISTANCE_SENSOR_MAX_ECHO_US   - BEYOND_RANGE
+ * 
+ * Валідні вимірювання проходять через фільтр викидів
+ * (медіана або усічене середнє останніх SENSOR_FILTER_WINDOW
+ * вимірювань), тому поодиноке хибне відбиття не потрапляє
+ * на дисплей.
+ * 
+ * @param[out] result Результат: статус, тривалість ECHO в тіках
+ *                    (для OK - після фільтра) та час тригера
+ * 
+ * @return Наявність нового вимірювання
+ * @retval 1 Вимірювання зчитане в result
+ * @retval 0 Нових вимірювань немає
  * 
- * @note Функція блокуюча - виконання зупиняється до завершення
- *       вимірювання або таймауту (~30 мс максимум)
+ * @note Конвертацію та оновлення дисплея варто виконувати
+ *       лише для DISTANCE_STATUS_OK
+ * @note Кожен датчик має власний фільтр; результат також
+ *       записується в таблицю distance_sensor_get_sample()
  * 
- * @warning Між послідовними вимірюваннями необхідна пауза
- *          мінімум 60 мс для стабілізації датчика
+ * @see distance_sensor_start_ranging()
+ * @see distance_sensor_convert_to_mm()
+ */
+uint8_t distance_sensor_read(DistanceResult *result);
+
+/**
+ * @brief Останнє вимірювання датчика з таблиці вимірювань
+ * 
+ * Таблиця оновлюється в distance_sensor_read() і містить
+ * останній результат кожного датчика (після фільтра).
  * 
- * @see distance_sensor_convert_to_cm()
- * @see distance_sensor_convert_to_inch()
- * @see DISTANCE_SENSOR_TIMEOUT_US
+ * @param[in]  sensor Номер датчика (0 - DISTANCE_SENSOR_COUNT-1)
+ * @param[out] result Останній результат датчика
+ * 
+ * @return 1 якщо датчик вже має вимірювання, 0 якщо ні
+ *         (або номер датчика поза діапазоном)
+ * 
+ * @see distance_sensor_read()
  */
-uint16_t distance_sensor_measure_raw(void);
+uint8_t distance_sensor_get_sample(uint8_t sensor, DistanceResult *result);
 
 /**
- * @brief Конвертація часу у відстань в сантиметрах
+ * @brief Конвертація часу у відстань в міліметрах
  * 
  * Перетворює виміряний час відбиття у відстань до об'єкта.
+ * Результат є єдиним внутрішнім представленням відстані.
  * 
- * Формула: distance = time_us / 58
+ * Формула: distance = time_us * 10 / 58
  * Пояснення:
- * - Швидкість звуку = 340 м/с = 0.034 см/мкс
- * - Туди-назад: 0.034 * 2 = 0.0588 см/мкс
- * - Інверсія: 1 см = 58.8 мкс ≈ 58 мкс/см
+ * - Швидкість звуку = 340 м/с = 0.34 мм/мкс
+ * - Туди-назад: 1 мм = 5.8 мкс
  * 
- * @param[in] raw_time Виміряний час у мікросекундах
- *                     (результат distance_sensor_measure_raw)
+ * Ділення замінене множенням на обернене значення з фіксованою
+ * комою та зсувом (STM8 не має апаратного 32-бітного ділення).
+ * Похибка не перевищує 0.6 мм.
  * 
- * @return Відстань до об'єкта в сантиметрах
+ * @param[in] ticks Тривалість ECHO в мікросекундах
+ *                  (DistanceResult::ticks валідного вимірювання)
  * 
- * @see distance_sensor_measure_raw()
- * @see DISTANCE_SENSOR_MAX_CM
+ * @return Відстань до об'єкта в міліметрах
+ *         (0 - DISTANCE_SENSOR_MAX_MM)
+ * 
+ * @see distance_sensor_read()
+ * @see DISTANCE_SENSOR_MAX_MM
  */
-uint16_t distance_sensor_convert_to_cm(uint16_t raw_time);
+uint16_t distance_sensor_convert_to_mm(uint16_t ticks);
 
 /**
- * @brief Конвертація часу у відстань в дюймах
+ * @brief Конвертація міліметрів у сантиметри
  * 
- * Перетворює виміряний час відбиття у відстань до об'єкта.
+ * Округлення до найближчого сантиметра без ділення.
  * 
- * Формула: distance = time_us / 148
- * Пояснення:
- * - 1 дюйм = 2.54 см
- * - Час для 1 дюйма = 58 * 2.54 ≈ 148 мкс/дюйм
+ * @param[in] distance_mm Відстань в міліметрах
+ *                        (результат distance_sensor_convert_to_mm)
  * 
- * @param[in] raw_time Виміряний час у мікросекундах
- *                     (результат distance_sensor_measure_raw)
+ * @return Відстань в сантиметрах
  * 
- * @return Відстань до об'єкта в дюймах
+ * @see distance_sensor_convert_to_mm()
+ * @see DISTANCE_SENSOR_MAX_CM
+ */
+uint16_t distance_sensor_mm_to_cm(uint16_t distance_mm);
+
+/**
+ * @brief Конвертація міліметрів у дюйми
+ * 
+ * Формула: distance = mm / 25.4, округлення до найближчого
+ * дюйма без ділення.
+ * 
+ * @param[in] distance_mm Відстань в міліметрах
+ *                        (результат distance_sensor_convert_to_mm)
  * 
+ * @return Відстань в дюймах
  * 
- * @see distance_sensor_measure_raw()
+ * @see distance_sensor_convert_to_mm()
  * @see DISTANCE_SENSOR_MAX_INCH
  */
-uint16_t distance_sensor_convert_to_inch(uint16_t raw_time);
+uint16_t distance_sensor_mm_to_inch(uint16_t distance_mm);
+
+/**
+ * @brief Оновлення трекера відстані та швидкості
+ * 
+ * Альфа-бета фільтр з фіксованою комою: на кожному
+ * вимірюванні прогнозує наступну відстань, порівнює її
+ * з виміряною та коригує оцінки відстані й швидкості.
+ * 
+ * Вимірювання поза вікном очікуваного відбиття (прогноз
+ * ± SENSOR_TRACKER_GATE_MM) відкидаються, оцінка рухається
+ * за прогнозом. Після SENSOR_TRACKER_MAX_MISSES відкинутих
+ * поспіль трекер перезахоплює об'єкт з нового значення
+ * (або скидається, якщо відбиття немає).
+ * 
+ * @param[in]  sensor      Номер датчика (DistanceResult::sensor)
+ * @param[in]  distance_mm Відстань в міліметрах
+ *                         (результат distance_sensor_convert_to_mm)
+ *                         0 - невалідне вимірювання
+ * @param[out] track       Оцінка відстані, швидкості та вікно
+ *                         наступного вимірювання
+ * 
+ * @return Результат перевірки вимірювання
+ * @retval 1 Вимірювання прийняте, оцінка оновлена
+ * @retval 0 Вимірювання відкинуте або невалідне
+ * 
+ * @note Швидкість розраховується для періоду вимірювань
+ *       датчика: період планувальника * дільник * кількість датчиків
+ * 
+ * @see distance_sensor_convert_to_mm()
+ * @see DistanceTrack
+ */
+uint8_t distance_sensor_track(uint8_t sensor, uint16_t distance_mm, DistanceTrack *track);
 
 #endif /* __DISTANCE_SENSOR_H */
\ No newline at end of file
@@ -9,6 +9,12 @@
  * Модуль забезпечує простий інтерфейс для виведення відладочної
  * інформації по UART. Активується через logger_config.h
  * 
+ * Функції не блокують: рядок ставиться в чергу передачі UART
+ * цілим або, якщо місця немає, відкидається. Вивід великих
+ * звітів розбивається на частини з перевіркою logger_ready().
+ * Виняток - звіт про запуск в initialize_logger(): він чекає
+ * на місце, поки IWDG ще не запущено.
+ * 
  * @note Якщо LOGGER_UART_ENABLE не визначено, всі функції стають no-op
  */
 
@@ -31,6 +37,9 @@ void initialize_logger(void); //Ініціалізує лише UART TX,  PD5, 9
  * @brief Відправляє текст по UART TX.
  *
  * @param msg "Null-terminated" строка.
+ * 
+ * @note Автоматично додає '\r\n' в кінці
+ * @note Не блокує: без місця в черзі рядок відкидається
  */
 void write_message_in_logger(const char *msg);
 
@@ -44,11 +53,25 @@ void write_message_in_logger(const char *msg);
  * 
  * @note Автоматично додає '\r\n' в кінці
  * @note Якщо LOGGER_UART_ENABLE не визначено, функція нічого не робить
- * @note Блокуюча функція
+ * @note Не блокує: без місця в черзі рядок відкидається
  * 
  * @see write_message_in_logger()
  * @see uart1_tx_number()
  */
 void write_number_in_logger(int32_t number);
 
+/**
+ * @brief Перевірка місця під частину звіту
+ * 
+ * @param[in] bytes Найбільша довжина частини (рядки з '\r\n')
+ * 
+ * @retval 1 Частина вміститься в чергу передачі (або черга
+ *           порожня, або логер вимкнено)
+ * @retval 0 Відкласти вивід: черга ще передається
+ * 
+ * @note Порожня черга - завжди 1: частина довша за чергу
+ *       виводиться з відкиданням рядків, а не блокує звіт
+ */
+uint8_t logger_ready(uint8_t bytes);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,265 @@
+/**
+ * @file    scheduler.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Інтерфейс кооперативного планувальника задач
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Планувальник викликає задачі бізнес-логіки з основного
+ * циклу за системним годинником 1 мс замість блокуючих
+ * затримок. Задачі не витісняють одна одну: кожна має
+ * швидко завершитись і повернути керування.
+ *
+ * Типи задач:
+ * - Періодична (period_ms > 0): запускається кожні period_ms,
+ *   фаза зберігається (відставання не накопичується)
+ * - Одноразова (period_ms = 0): запускається лише після
+ *   scheduler_run_after(), потім знімається з черги
+ *
+ * Для кожної задачі ведеться статистика: кількість запусків
+ * та найдовший час виконання (WCET, роздільна здатність 4 мкс).
+ *
+ * Якщо жодна задача не готова, основний цикл викликає
+ * scheduler_idle(): CPU засинає (wfi) до наступного
+ * переривання, час сну рахується як простій. Навантаження
+ * CPU = 1 - простій / загальний час.
+ *
+ * Монітор дедлайнів:
+ * - Задача з deadline_ms > 0 має завершитись не пізніше
+ *   deadline_ms від запланованого часу запуску, інакше
+ *   фіксується перевищення (кількість та найбільше, мс)
+ * - Сторожовий таймер IWDG оновлюється в кінці
+ *   scheduler_dispatch(), лише якщо всі задачі встигли і жодна
+ *   задача в черзі не прострочена. Зависання задачі або
+ *   постійні перевищення призводять до скидання MCU
+ * - Таблиця перевищень, номер задачі, що виконувалась, та
+ *   причина останнього скидання зберігаються в RAM без
+ *   ініціалізації (секція .noinit) і переживають скидання
+ *   (очищуються при вмиканні живлення та прошивці)
+ *
+ * Використання RAM: 8 байт на задачу (SCHEDULER_MAX_TASKS)
+ * + 12 байт облік простою; .noinit: 4 байти на задачу + 8 байт
+ */
+
+#ifndef __SCHEDULER_H
+#define __SCHEDULER_H
+
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Максимальна кількість задач (1-8)
+ */
+#ifndef SCHEDULER_MAX_TASKS
+#define SCHEDULER_MAX_TASKS     6
+#endif
+
+#if (SCHEDULER_MAX_TASKS < 1) || (SCHEDULER_MAX_TASKS > 8)
+#error "SCHEDULER_MAX_TASKS must be in range 1..8"
+#endif
+
+/**
+ * @brief Максимальний період або затримка задачі (мс)
+ *
+ * Час запуску зберігається 16-бітним, порівняння виконується
+ * через знакову різницю.
+ */
+#define SCHEDULER_MAX_DELAY_MS  32767U
+
+/**
+ * @brief Невалідний номер задачі (поза задачею, причина невідома)
+ */
+#define SCHEDULER_NO_TASK       0xFF
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Функція задачі
+ */
+typedef void (*SchedulerTaskFunction)(void);
+
+/**
+ * @brief Опис задачі (зберігається у flash)
+ */
+typedef struct {
+    SchedulerTaskFunction run;  /**< Функція задачі */
+    uint16_t period_ms;         /**< Період (0 - одноразова задача) */
+    uint16_t deadline_ms;       /**< Дедлайн від запланованого запуску до завершення (0 - без контролю) */
+} SchedulerTask;
+
+/**
+ * @brief Навантаження CPU з моменту scheduler_reset_load()
+ */
+typedef struct {
+    uint32_t elapsed_ms;        /**< Загальний час */
+    uint32_t idle_ms;           /**< Час у режимі WAIT */
+    uint8_t  load_percent;      /**< Навантаження CPU, % */
+} SchedulerLoadStats;
+
+/**
+ * @brief Статистика задачі
+ */
+typedef struct {
+    uint32_t runs;              /**< Кількість запусків */
+    uint16_t wcet_us;           /**< Найдовший час виконання, мкс */
+} SchedulerTaskStats;
+
+/**
+ * @brief Перевищення дедлайну задачі (з моменту вмикання живлення)
+ */
+typedef struct {
+    uint16_t count;             /**< Кількість перевищень (насичення 0xFFFF) */
+    uint16_t max_over_ms;       /**< Найбільше перевищення, мс */
+} SchedulerOverrunStats;
+
+/**
+ * @brief Причина поточного запуску
+ */
+typedef struct {
+    uint8_t reset_flags;        /**< WATCHDOG_RESET_* останнього скидання (0 - живлення або NRST) */
+    uint8_t watchdog_resets;    /**< Скидань IWDG з моменту вмикання живлення */
+    uint8_t task;               /**< Задача, через яку був останній скид IWDG (SCHEDULER_NO_TASK - невідомо) */
+    uint8_t hung;               /**< 1 - задача зависла під час виконання, 0 - перевищувала дедлайн */
+} SchedulerResetInfo;
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Реєстрація таблиці задач
+ *
+ * Періодичні задачі стартують на першому виклику
+ * scheduler_dispatch(), одноразові чекають scheduler_run_after().
+ * Номер задачі - її індекс у таблиці.
+ *
+ * Запускає сторожовий таймер IWDG.
+ *
+ * @param[in] tasks Таблиця задач (має існувати весь час роботи)
+ * @param[in] count Кількість задач (до SCHEDULER_MAX_TASKS)
+ *
+ * @note Викликається після initialize_hardware()
+ * @warning Після виклику scheduler_dispatch() має викликатись
+ *          частіше за WATCHDOG_TIMEOUT_MS
+ */
+void scheduler_init(const SchedulerTask *tasks, uint8_t count);
+
+/**
+ * @brief Запуск задачі через задану затримку
+ *
+ * Одноразова задача ставиться в чергу, для періодичної
+ * переноситься наступний запуск (далі період зберігається).
+ * Повторний виклик до запуску переносить час запуску.
+ *
+ * @param[in] task_id  Номер задачі
+ * @param[in] delay_ms Затримка (0 - на найближчому scheduler_dispatch(),
+ *                     не більше SCHEDULER_MAX_DELAY_MS)
+ *
+ * @note Можна викликати з самої задачі
+ */
+void scheduler_run_after(uint8_t task_id, uint16_t delay_ms);
+
+/**
+ * @brief Зняття задачі з черги
+ *
+ * Періодична задача зупиняється до наступного scheduler_run_after().
+ *
+ * @param[in] task_id Номер задачі
+ */
+void scheduler_cancel(uint8_t task_id);
+
+/**
+ * @brief Виконання всіх задач, час яких настав
+ *
+ * Задачі виконуються в порядку таблиці (менший номер -
+ * вищий пріоритет), кожна не більше одного разу за виклик.
+ *
+ * Перевіряє дедлайни та оновлює сторожовий таймер.
+ *
+ * @return Кількість виконаних задач (0 - нічого не було готове)
+ *
+ * @note Викликається з основного циклу
+ */
+uint8_t scheduler_dispatch(void);
+
+/**
+ * @brief Сон до наступного переривання з обліком простою
+ *
+ * Викликається з основного циклу, коли scheduler_dispatch()
+ * повернув 0. Задачі запускаються лише на межі мілісекунди,
+ * тому системний тік завжди будить CPU вчасно.
+ *
+ * @note Час обробників переривань під час сну рахується
+ *       як простій
+ */
+void scheduler_idle(void);
+
+/**
+ * @brief Навантаження CPU з моменту останнього скидання
+ *
+ * @param[out] stats Загальний час, час простою та навантаження
+ *
+ * @note Якщо вікно перевищує ~35 хв, обидва лічильники
+ *       діляться навпіл (співвідношення зберігається)
+ */
+void scheduler_get_load(SchedulerLoadStats *stats);
+
+/**
+ * @brief Початок нового вікна обліку навантаження
+ */
+void scheduler_reset_load(void);
+
+/**
+ * @brief Сумарний час простою з запуску
+ *
+ * Не залежить від вікна scheduler_get_load(): модулі
+ * рахують простій за власні інтервали різницею двох значень.
+ *
+ * @return Час у режимі WAIT, мкс (по колу 2^32)
+ */
+uint32_t scheduler_idle_us(void);
+
+/**
+ * @brief Статистика задачі
+ *
+ * @param[in]  task_id Номер задачі
+ * @param[out] stats   Кількість запусків та WCET
+ */
+void scheduler_get_stats(uint8_t task_id, SchedulerTaskStats *stats);
+
+/**
+ * @brief Монотонний час системи в мілісекундах
+ *
+ * @return Час від запуску, мс
+ */
+uint32_t scheduler_time_ms(void);
+
+/**
+ * @brief Облік причини скидання в таблиці монітора
+ *
+ * Перевіряє таблицю в RAM без ініціалізації (після вмикання
+ * живлення або прошивки - очищує) та, якщо MCU скинув IWDG,
+ * зберігає задачу, що виконувалась або прострочила дедлайн.
+ *
+ * @note Викликається з initialize_hardware() один раз,
+ *       до initialize_logger()
+ */
+void scheduler_monitor_boot(void);
+
+/**
+ * @brief Перевищення дедлайну задачі
+ *
+ * @param[in]  task_id Номер задачі (0 - SCHEDULER_MAX_TASKS-1)
+ * @param[out] stats   Кількість та найбільше перевищення
+ */
+void scheduler_get_overrun(uint8_t task_id, SchedulerOverrunStats *stats);
+
+/**
+ * @brief Причина поточного запуску
+ *
+ * @param[out] info Прапорці скидання, кількість скидань IWDG
+ *                  та задача-винуватець
+ */
+void scheduler_get_reset_info(SchedulerResetInfo *info);
+
+#endif /* __SCHEDULER_H */
@@ -0,0 +1,125 @@
+/**
+ * @file    soft_timer.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Інтерфейс програмних таймерів (timer wheel)
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Відкладені події (підтвердження дебаунсу, таймаути) без
+ * блокування CPU. Таймери рахують системний тік 1 мс,
+ * callback викликається з основного циклу в soft_timer_process().
+ *
+ * Реалізація - хешоване колесо таймерів:
+ * - SOFT_TIMER_WHEEL_SIZE комірок по 1 мс, комірка = час спрацювання
+ *   за модулем розміру колеса
+ * - Довші затримки - кількість повних обертів колеса (rounds)
+ * - Запуск та скасування O(1), обробка тіку - лише таймери
+ *   однієї комірки
+ * - Статичний пул SOFT_TIMER_SLOTS таймерів (без heap)
+ *
+ * Використання RAM: 4 байти на таймер + 1 байт на комірку + 3 байти
+ */
+
+#ifndef __SOFT_TIMER_H
+#define __SOFT_TIMER_H
+
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Кількість таймерів у пулі (1-254)
+ */
+#ifndef SOFT_TIMER_SLOTS
+#define SOFT_TIMER_SLOTS            4
+#endif
+
+/**
+ * @brief Кількість комірок колеса (степінь двійки)
+ *
+ * Більше колесо - менше таймерів в одній комірці,
+ * але більше RAM під голови списків.
+ */
+#ifndef SOFT_TIMER_WHEEL_SIZE
+#define SOFT_TIMER_WHEEL_SIZE       16
+#endif
+
+#if (SOFT_TIMER_SLOTS < 1) || (SOFT_TIMER_SLOTS > 254)
+#error "SOFT_TIMER_SLOTS must be in range 1..254"
+#endif
+
+#if (SOFT_TIMER_WHEEL_SIZE & (SOFT_TIMER_WHEEL_SIZE - 1)) != 0
+#error "SOFT_TIMER_WHEEL_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief Максимальна затримка таймера (мс)
+ *
+ * Обмежена 8-бітним лічильником обертів колеса (запас
+ * в один оберт на відставання обробки від системного тіку).
+ */
+#define SOFT_TIMER_MAX_DELAY_MS     ((uint16_t)(SOFT_TIMER_WHEEL_SIZE * 255UL))
+
+/**
+ * @brief Невалідний ідентифікатор таймера
+ */
+#define SOFT_TIMER_NONE             0xFF
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Функція, що викликається при спрацюванні таймера
+ */
+typedef void (*SoftTimerCallback)(void);
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Ініціалізація сервісу таймерів (всі таймери вільні)
+ *
+ * @note Викликається після initialize_hardware()
+ */
+void soft_timer_init(void);
+
+/**
+ * @brief Запуск одноразового таймера
+ *
+ * @param[in] callback Функція, що викличеться при спрацюванні
+ * @param[in] delay_ms Затримка (0 трактується як 1,
+ *                     не більше SOFT_TIMER_MAX_DELAY_MS)
+ *
+ * @return Ідентифікатор таймера
+ * @retval SOFT_TIMER_NONE Вільних таймерів немає
+ *
+ * @note Таймер звільняється перед викликом callback, тому
+ *       з callback можна запустити новий таймер
+ */
+uint8_t soft_timer_start(SoftTimerCallback callback, uint16_t delay_ms);
+
+/**
+ * @brief Скасування таймера
+ *
+ * Callback не буде викликаний. Таймер повертається в пул,
+ * коли колесо дійде до його комірки.
+ *
+ * @param[in] timer_id Ідентифікатор з soft_timer_start()
+ *                     (SOFT_TIMER_NONE ігнорується)
+ *
+ * @warning Не скасовувати таймер, який вже спрацював:
+ *          його комірка може належати новому таймеру
+ */
+void soft_timer_cancel(uint8_t timer_id);
+
+/**
+ * @brief Обробка тіків, що минули з попереднього виклику
+ *
+ * Викликає callback таймерів, час яких настав.
+ *
+ * @return Кількість викликаних callback
+ *
+ * @note Викликається з основного циклу
+ */
+uint8_t soft_timer_process(void);
+
+#endif /* __SOFT_TIMER_H */
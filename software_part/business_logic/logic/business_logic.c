@@ -1,9 +1,47 @@
 #include "business_logic.h"
 #include "system_init.h"
 #include "logger.h"
+#include "scheduler.h"
+#include "soft_timer.h"
+#include "profiler.h"
+#include "latency_probe.h"
+#include "stack_monitor.h"
 
 //==================== PRIVATE STATE ===================
 
+/**
+ * @brief Задачі бізнес-логіки (номер = пріоритет, менший - вищий)
+ */
+typedef enum {
+    TASK_INPUT = 0,             /**< Кнопки та машина станів */
+    TASK_SENSE,                 /**< Забір вимірювань з буфера датчика */
+    TASK_DISPLAY,               /**< Оновлення дисплея (одноразова) */
+    TASK_LEDS,                  /**< Оновлення LED-індикації (одноразова) */
+    TASK_LOG,                   /**< Статистика в лог */
+    TASK_COUNT
+} BusinessTaskID;
+
+/**
+ * @brief Кроки звіту статистики (частина на крок, див. report_statistics())
+ */
+#define REPORT_STEP_CPU             0
+#define REPORT_STEP_TASKS           1   /**< TASK_COUNT кроків, по задачі */
+#define REPORT_STEP_LATENCY         (REPORT_STEP_TASKS + TASK_COUNT)
+#define REPORT_STEP_LATENCY_BINS    (REPORT_STEP_LATENCY + 1)
+#define REPORT_STEP_DISPLAY         (REPORT_STEP_LATENCY + 2)
+#define REPORT_STEP_STACK           (REPORT_STEP_LATENCY + 3)
+#define REPORT_STEP_ZONES           (REPORT_STEP_LATENCY + 4)   /**< PROFILER_ZONE_COUNT кроків */
+#ifdef PROFILER_ENABLE
+#define REPORT_STEP_COUNT           (REPORT_STEP_ZONES + PROFILER_ZONE_COUNT)
+#else
+#define REPORT_STEP_COUNT           REPORT_STEP_ZONES
+#endif
+
+/* Кошик гістограми - до 7 байт ("65535\r\n") */
+#if (LATENCY_PROBE_BINS * 7) > LOG_SECTION_MAX_BYTES
+#error "Latency histogram bins must fit one log section"
+#endif
+
 /**
  * @brief Приватний стан системи (інкапсульований)
  */
@@ -11,27 +49,89 @@ static struct {
     SystemState state;          /**< Поточний стан машини станів */
     MeasurementUnit unit;       /**< Поточна одиниця виміру */
     uint16_t threshold_cm;      /**< Порогове значення в см */
+    DistanceRateMode rate_mode; /**< Останній відомий режим частоти вимірювань */
+    uint16_t distance_mm[DISTANCE_SENSOR_COUNT]; /**< Відстань від трекера кожного датчика */
+    uint16_t warning_mm[DISTANCE_SENSOR_COUNT];  /**< Прогноз для LED кожного датчика */
+    uint8_t  sensor_valid;      /**< Маска датчиків, що бачать об'єкт */
+    uint8_t  last_status;       /**< Статус останнього невалідного вимірювання */
+    uint8_t  cal_step;          /**< Показаний крок калібрування (ButtonCalibrationStep) */
+    uint16_t frozen_mm;         /**< Зафіксована відстань на дисплеї (DISTANCE_NOT_FROZEN - показ поточної) */
+    uint8_t  report_step;       /**< Наступна частина звіту статистики (REPORT_STEP_COUNT - звіт виведено) */
+    uint8_t  gesture_redraw;    /**< Запит дисплея від жесту: перемальовування завершить вимірювання затримки */
 } app_state;
 
+/**
+ * @brief Політика адаптивної частоти вимірювань
+ */
+static const DistanceRatePolicy measurement_rate_policy = {
+    MEASUREMENT_PERIOD_US,
+    MEASUREMENT_SLOW_DIVIDER,
+    MEASUREMENT_ACTIVITY_MM,
+    MEASUREMENT_SETTLE_SAMPLES
+};
+
+/**
+ * @brief Жести кнопок (MODE, UP, DOWN)
+ */
+static const ButtonGesturePolicy button_gesture_policy = {
+    { MODE_LONG_PRESS_MS, 0, 0 },
+    { MODE_DOUBLE_CLICK_MS, 0, 0 }
+};
+
 
 
 //============= STATIC INTERNAL FUNCTIONS PROTOTYPES ==============
 
-static void handle_measure_state(ButtonID button);
-static void handle_setup_state(ButtonID button);
+static void handle_buttons(void);
+static void handle_measure_state(const ButtonGesture *gesture);
+static void handle_setup_state(const ButtonGesture *gesture);
+static void toggle_display_freeze(void);
+static void handle_calibrate_state(void);
+static void finish_calibration(void);
+static void show_calibration_step(void);
 
 
 static void perform_distance_measurement(void);
+static void update_display(void);
+static void update_led_indication(void);
+static void report_statistics(void);
+static void request_outputs_update(void);
+static void request_gesture_redraw(void);
+static uint8_t find_nearest_distance(uint16_t *distance_mm, uint16_t *warning_mm);
+static void show_measurement_error(uint8_t status);
+static void report_rate_stats(DistanceRateMode mode);
+static void report_section(uint8_t step);
+static void report_cpu_stats(void);
+static void report_task_stats(uint8_t task);
+static void report_latency_stats(void);
+static void report_latency_bins(void);
+static void report_display_stats(void);
+static void report_stack_stats(void);
+#ifdef PROFILER_ENABLE
+static void report_profiler_zone(uint8_t zone);
+#endif
 static void update_threshold_display(void);
 static void adjust_threshold(int16_t delta);
 static uint16_t convert_threshold_to_current_unit(void);
-static uint16_t convert_distance_to_current_unit(uint16_t distance_cm);
+static uint16_t convert_distance_to_current_unit(uint16_t distance_mm);
 
 static void business_logic_init(void);
 static void business_logic_run(void);
+
+/**
+ * @brief Таблиця задач (порядок відповідає BusinessTaskID)
+ */
+static const SchedulerTask business_tasks[TASK_COUNT] = {
+    { handle_buttons,               INPUT_TASK_PERIOD_MS, TASK_DEADLINE_MS },
+    { perform_distance_measurement, SENSE_TASK_PERIOD_MS, TASK_DEADLINE_MS },
+    { update_display,               0,                    TASK_DEADLINE_MS },
+    { update_led_indication,        0,                    TASK_DEADLINE_MS },
+    { report_statistics,            LOG_TASK_PERIOD_MS,   TASK_DEADLINE_MS }
+};
 //============== PUBLIC FUNCTION IMPLEMENTATIONS ===============
 
 void business_logic_loop(void){
+    stack_monitor_init();
     initialize_hardware();
     business_logic_init();
     
@@ -50,6 +150,8 @@ void business_logic_loop(void){
  * - STATE_MEASURE
  * - UNIT_CM
  * - threshold = 0 (індикація вимкнена)
+ * - запуск планувальника вимірювань з адаптивною частотою
+ * - ініціалізація програмних таймерів та реєстрація задач
  * 
  * @param[in] None
  * @retval None
@@ -61,38 +163,98 @@ static void business_logic_init(void) {
     app_state.state = STATE_MEASURE;
     app_state.unit = UNIT_CM;
     app_state.threshold_cm = THRESHOLD_MIN;
+    app_state.rate_mode = DISTANCE_RATE_FAST;
+    app_state.sensor_valid = 0;
+    app_state.last_status = DISTANCE_STATUS_NO_ECHO;
+    app_state.frozen_mm = DISTANCE_NOT_FROZEN;
+    app_state.report_step = REPORT_STEP_COUNT;
+    
+    distance_sensor_set_rate_policy(&measurement_rate_policy);
+    button_set_gesture_policy(&button_gesture_policy);
+    soft_timer_init();
+    scheduler_init(business_tasks, TASK_COUNT);
 }
 
 /**
- * @brief Виконання одної ітерації машини станів
+ * @brief Виконання одної ітерації основного циклу
+ * 
+ * Запускає задачі, час яких настав:
+ * 1. TASK_INPUT   - читання кнопки та обробка поточного стану
+ * 2. TASK_SENSE   - забір нових вимірювань
+ * 3. TASK_DISPLAY - оновлення дисплея (за запитом)
+ * 4. TASK_LEDS    - оновлення LED (за запитом)
+ * 5. TASK_LOG     - статистика
  * 
- * Функція виконує:
- * 1. Читання кнопки
- * 2. Обробку поточного стану
- * 3. Оновлення виходів (дисплей, LED)
+ * Далі - callback програмних таймерів, час яких настав.
  * 
  * @param[in] None
  * @retval None
  * 
  * @note Викликається циклічно з main loop
- * @note Час виконання: ~70 мс (STATE_MEASURE) або ~100 мс (STATE_SETUP)
+ * @note Якщо жодна задача не готова, CPU засинає до наступного
+ *       переривання (не пізніше за системний тік 1 мс)
  */
 static void business_logic_run(void) {
-    ButtonID button = get_button_value();
+    uint8_t executed = scheduler_dispatch();
     
-    switch (app_state.state) {
-        case STATE_MEASURE:
-            handle_measure_state(button);
-            break;
-            
-        case STATE_SETUP:
-            handle_setup_state(button);
-            break;
-            
-        default:
-            /* Невідомий стан - повертаємось до MEASURE */
-            app_state.state = STATE_MEASURE;
-            break;
+    executed += soft_timer_process();
+    if (executed == 0) {
+        scheduler_idle();
+    }
+}
+
+/**
+ * @brief Задача TASK_INPUT: читання жестів кнопок та машина станів
+ * 
+ * Стани споживають жести (button_gesture_policy), а не сирі
+ * фронти: MEASURE реагує на клік, довге натискання та
+ * подвійний клік MODE, SETUP - на натискання та автоповтори
+ * UP/DOWN (з прискоренням) і CHORD з MODE.
+ * 
+ * Жест, що змінює показ, запитує дисплей через
+ * request_gesture_redraw(): вимірювання затримки до дисплея
+ * починається з фронту, з якого почався жест (разом з очікуванням
+ * вікна подвійного кліку та порогу довгого натискання).
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void handle_buttons(void) {
+    ButtonGesture gesture;
+    uint8_t redraw = app_state.gesture_redraw;
+    
+    while (get_button_gesture(&gesture)) {
+        /* Під час калібрування жести за старою таблицею не мають сенсу */
+        if (app_state.state == STATE_CALIBRATE) {
+            continue;
+        }
+        
+        app_state.gesture_redraw = 0;
+        switch (app_state.state) {
+            case STATE_MEASURE:
+                handle_measure_state(&gesture);
+                break;
+                
+            case STATE_SETUP:
+                handle_setup_state(&gesture);
+                break;
+                
+            default:
+                /* Невідомий стан - повертаємось до MEASURE */
+                app_state.state = STATE_MEASURE;
+                break;
+        }
+        
+        /* Вимірюються лише жести, що змінили показ на дисплеї */
+        if (app_state.gesture_redraw) {
+            latency_probe_start(gesture.edge_ms);
+            redraw = 1;
+        }
+    }
+    app_state.gesture_redraw = redraw;
+    
+    if (app_state.state == STATE_CALIBRATE) {
+        handle_calibrate_state();
     }
 }
 
@@ -100,99 +262,707 @@ static void business_logic_run(void) {
 /**
  * @brief Обробка стану MEASURE (вимірювання)
  * 
- * @param[in] button Ідентифікатор натиснутої кнопки
+ * - PRESS MODE протягом CALIBRATION_ENTRY_WINDOW_MS після
+ *   ввімкнення - калібрування кнопок
+ * - CLICK MODE - перемикання одиниць виміру
+ * - LONG_PRESS MODE - фіксація показу відстані (повторно - вихід)
+ * - DOUBLE_CLICK MODE - вимкнення порогу (LED-індикації)
+ * - PRESS UP/DOWN - перехід до налаштування порогу
+ * 
+ * @param[in] gesture Жест кнопок
  * @retval None
  */
-static void handle_measure_state(ButtonID button) {
-    switch (button) {
+static void handle_measure_state(const ButtonGesture *gesture) {
+    switch ((ButtonID)gesture->button) {
         case BTN_MODE:
-            /* Перемикання одиниць виміру */
-            app_state.unit = (app_state.unit == UNIT_CM) ? UNIT_INCH : UNIT_CM;
+            switch (gesture->type) {
+                case BUTTON_GESTURE_PRESS:
+                    /* MODE, утримана при ввімкненні - калібрування кнопок */
+                    if (systick_ms() < CALIBRATION_ENTRY_WINDOW_MS) {
+                        button_calibration_start();
+                        app_state.state = STATE_CALIBRATE;
+                        app_state.cal_step = BUTTON_CAL_RELEASE;
+                        request_gesture_redraw();
+                    }
+                    break;
+                    
+                case BUTTON_GESTURE_CLICK:
+                    /* Перемикання одиниць виміру */
+                    app_state.unit = (app_state.unit == UNIT_CM) ? UNIT_INCH : UNIT_CM;
+                    request_gesture_redraw();
+                    scheduler_run_after(TASK_LEDS, 0);
+                    break;
+                    
+                case BUTTON_GESTURE_LONG_PRESS:
+                    toggle_display_freeze();
+                    break;
+                    
+                case BUTTON_GESTURE_DOUBLE_CLICK:
+                    /* Швидке вимкнення індикації */
+                    app_state.threshold_cm = THRESHOLD_MIN;
+                    request_gesture_redraw();
+                    scheduler_run_after(TASK_LEDS, 0);
+                    break;
+                    
+                default:
+                    break;
+            }
             break;
             
         case BTN_UP:
         case BTN_DOWN:
-            /* Перехід до режиму налаштування */
-            app_state.state = STATE_SETUP;
+            /* Перехід до режиму налаштування (автоповтори вже змінюють поріг) */
+            if (gesture->type == BUTTON_GESTURE_PRESS) {
+                app_state.state = STATE_SETUP;
+                app_state.frozen_mm = DISTANCE_NOT_FROZEN;
+                request_gesture_redraw();
+            }
             break;
             
         case BTN_NONE:
         default:
-            /* Виконання вимірювання */
-            perform_distance_measurement();
-            _delay_ms(MEASUREMENT_DELAY_MS);
+            /* Нові вимірювання обробляє TASK_SENSE */
             break;
     }
 }
 
+/**
+ * @brief Фіксація показу відстані на дисплеї (або вихід з неї)
+ * 
+ * Вимірювання та LED-індикація продовжують працювати,
+ * дисплей показує зафіксовану відстань у поточних одиницях.
+ * Без об'єкта фіксувати нічого - жест ігнорується.
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void toggle_display_freeze(void) {
+    uint16_t distance_mm;
+    uint16_t warning_mm;
+    
+    if (app_state.frozen_mm != DISTANCE_NOT_FROZEN) {
+        app_state.frozen_mm = DISTANCE_NOT_FROZEN;
+    } else if (find_nearest_distance(&distance_mm, &warning_mm)) {
+        app_state.frozen_mm = distance_mm;
+    } else {
+        return;
+    }
+    request_gesture_redraw();
+}
+
 /**
  * @brief Обробка стану SETUP (налаштування порогу)
  * 
- * @param[in] button Ідентифікатор натиснутої кнопки
+ * Кожне натискання UP/DOWN змінює поріг на THRESHOLD_STEP.
+ * Утримання дає автоповтори драйвера кнопок: після
+ * THRESHOLD_FAST_AFTER_REPEATS повторів крок зростає до
+ * THRESHOLD_FAST_STEP. Темп задається часом подій, а не
+ * частотою опитування.
+ * 
+ * Клік MODE повертає до MEASURE. Натискання MODE при
+ * утриманій UP/DOWN (CHORD) ставить поріг у максимум /
+ * мінімум.
+ * 
+ * @param[in] gesture Жест кнопок
  * @retval None
  */
-static void handle_setup_state(ButtonID button) {
-    update_threshold_display();
+static void handle_setup_state(const ButtonGesture *gesture) {
+    int16_t step = THRESHOLD_STEP;
+    
+    if (gesture->type == BUTTON_GESTURE_REPEAT &&
+        gesture->param > THRESHOLD_FAST_AFTER_REPEATS) {
+        step = THRESHOLD_FAST_STEP;
+    }
     
-    switch (button) {
+    switch ((ButtonID)gesture->button) {
         case BTN_MODE:
-            /* Повернення до режиму вимірювання */
-            app_state.state = STATE_MEASURE;
-            break;
+            if (gesture->type == BUTTON_GESTURE_CHORD) {
+                /* Крайні значення порогу: від утримуваної кнопки */
+                if (gesture->param == BTN_UP) {
+                    adjust_threshold(THRESHOLD_MAX);
+                } else if (gesture->param == BTN_DOWN) {
+                    adjust_threshold(-THRESHOLD_MAX);
+                }
+                break;
+            }
+            if (gesture->type == BUTTON_GESTURE_CLICK) {
+                /* Повернення до режиму вимірювання */
+                app_state.state = STATE_MEASURE;
+                request_gesture_redraw();
+                scheduler_run_after(TASK_LEDS, 0);
+            }
+            return;
             
         case BTN_UP:
-            /* Збільшення порогу */
-            adjust_threshold(THRESHOLD_STEP);
-            break;
-            
         case BTN_DOWN:
-            /* Зменшення порогу */
-            adjust_threshold(-THRESHOLD_STEP);
+            if (gesture->type != BUTTON_GESTURE_PRESS &&
+                gesture->type != BUTTON_GESTURE_REPEAT) {
+                return;
+            }
+            /* Збільшення / зменшення порогу */
+            adjust_threshold(((ButtonID)gesture->button == BTN_UP) ? step : -step);
             break;
             
         case BTN_NONE:
         default:
-            /* Просто відображаємо поточне значення */
-            break;
+            return;
     }
     
-    _delay_ms(SETUP_DELAY_MS);
+    request_gesture_redraw();
 }
 
 /**
- * @brief Виконання вимірювання відстані
+ * @brief Обробка стану CALIBRATE (калібрування драбини кнопок)
+ * 
+ * Веде калібрування та оновлює підказку на дисплеї при
+ * зміні кроку. Результат показується CALIBRATION_RESULT_MS,
+ * після чого система повертається до MEASURE.
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void handle_calibrate_state(void) {
+    ButtonCalibrationStep step = button_calibration_process();
+    
+    if (step == app_state.cal_step) {
+        return;
+    }
+    
+    app_state.cal_step = step;
+    scheduler_run_after(TASK_DISPLAY, 0);
+    
+    if (step == BUTTON_CAL_DONE || step == BUTTON_CAL_FAILED) {
+        if (soft_timer_start(finish_calibration, CALIBRATION_RESULT_MS) == SOFT_TIMER_NONE) {
+            finish_calibration();
+        }
+    }
+}
+
+/**
+ * @brief Завершення показу результату калібрування
+ * 
+ * @param[in] None
+ * @retval None
+ * 
+ * @note Callback програмного таймера
+ */
+static void finish_calibration(void) {
+    app_state.state = STATE_MEASURE;
+    request_outputs_update();
+}
+
+/**
+ * @brief Задача TASK_SENSE: обробка вимірювань відстані
+ * 
+ * Вимірювання виконуються апаратним планувальником з адаптивною
+ * частотою (measurement_rate_policy). Функція лише забирає готові результати
+ * з буфера та оновлює стан; якщо нових даних немає - нічого
+ * не робить. Виходи оновлюють задачі TASK_DISPLAY та TASK_LEDS.
+ * 
+ * Невалідні вимірювання не конвертуються: на дисплей
+ * виводиться текст помилки відповідно до статусу.
+ * 
+ * Кожне валідне вимірювання проходить через трекер відстані:
+ * - стрибки поза вікном очікуваного відбиття відкидаються,
+ *   на дисплеї залишається попереднє значення
+ * - LED-індикація враховує швидкість наближення
+ *   (APPROACH_LOOKAHEAD_SHIFT) і спрацьовує раніше
+ * 
+ * Кожен датчик має власний трекер. Дисплей та LED показують
+ * найближчий об'єкт серед датчиків; помилка виводиться,
+ * лише якщо жоден датчик не бачить об'єкт.
  * 
  * @param[in] None
  * @retval None
  */
 static void perform_distance_measurement(void) {
-    uint16_t raw_time;
-    uint16_t distance_cm;
-    uint16_t distance_display;
-    uint16_t threshold_display;
-    /*Отримання вимірів в необробленому вигляді*/
-    raw_time = distance_sensor_measure_raw();
-    
-    /* Перевірка валідності */
-    if (raw_time == 0) {
-        /* Об'єкт не виявлено */
-        display_show_number(DISPLAY_ERROR_VALUE);
+    DistanceResult result;
+    uint16_t distance_mm;
+    uint16_t warning_mm;
+    uint16_t approach_mm;
+    DistanceTrack track;
+    uint8_t updated = 0;
+    
+    PROFILER_ENTER(PROFILER_ZONE_MEASUREMENT);
+    
+    /*Отримання класифікованих вимірів*/
+    while (distance_sensor_read(&result)) {
+        
+        /* Перевірка валідності */
+        if (result.status != DISTANCE_STATUS_OK) {
+            /* Трекер рухається за прогнозом (або втрачає об'єкт) */
+            (void)distance_sensor_track(result.sensor, 0, &track);
+            app_state.sensor_valid &= (uint8_t)~(1 << result.sensor);
+            app_state.last_status = result.status;
+            updated = 1;
+            continue;
+        }
+        
+        /* Конвертація в міліметри (базова одиниця) */
+        distance_mm = distance_sensor_convert_to_mm(result.ticks);
+        
+        /* Трекер відстані та швидкості */
+        if (!distance_sensor_track(result.sensor, distance_mm, &track)) {
+            /* Неможливий стрибок - попереднє значення залишається */
+            continue;
+        }
+        
+        /* Прогноз відстані для раннього попередження */
+        warning_mm = track.distance_mm;
+        if (track.velocity_mm_s < 0) {
+            approach_mm = (uint16_t)(-track.velocity_mm_s) >> APPROACH_LOOKAHEAD_SHIFT;
+            warning_mm = (warning_mm > approach_mm) ? (warning_mm - approach_mm) : 0;
+        }
+        
+        app_state.distance_mm[result.sensor] = track.distance_mm;
+        app_state.warning_mm[result.sensor] = warning_mm;
+        app_state.sensor_valid |= (uint8_t)(1 << result.sensor);
+        updated = 1;
+    }
+    
+    /* В режимі SETUP дисплей показує поріг */
+    if (updated && app_state.state == STATE_MEASURE) {
+        request_outputs_update();
+    }
+    
+    PROFILER_EXIT(PROFILER_ZONE_MEASUREMENT);
+}
+
+/**
+ * @brief Задача TASK_DISPLAY: оновлення дисплея
+ * 
+ * MEASURE - найближча відстань (або зафіксована утриманням MODE)
+ * чи текст помилки,
+ * SETUP - порогове значення, CALIBRATE - підказка калібрування.
+ * 
+ * Перемальовування за запитом жесту завершує вимірювання
+ * затримки кнопки. Оновлення від нових вимірювань його не
+ * завершують: вони не показують результат натискання.
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void update_display(void) {
+    uint16_t distance_mm;
+    uint16_t warning_mm;
+    
+    if (app_state.state == STATE_SETUP) {
+        update_threshold_display();
+    } else if (app_state.state == STATE_CALIBRATE) {
+        show_calibration_step();
+    } else if (app_state.frozen_mm != DISTANCE_NOT_FROZEN) {
+        display_show_number(convert_distance_to_current_unit(app_state.frozen_mm));
+    } else if (find_nearest_distance(&distance_mm, &warning_mm)) {
+        display_show_number(convert_distance_to_current_unit(distance_mm));
+    } else {
+        show_measurement_error(app_state.last_status);
+    }
+    
+    /* Показано результат жесту - кінець вимірювання затримки кнопки */
+    if (app_state.gesture_redraw) {
+        app_state.gesture_redraw = 0;
+        latency_probe_stop();
+    }
+}
+
+/**
+ * @brief Задача TASK_LEDS: оновлення LED-індикації
+ * 
+ * Об'єкт у сліпій зоні ближче будь-якого порогу - LED-індикація
+ * як для мінімальної відстані, при інших помилках LED вимикаються.
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void update_led_indication(void) {
+    uint16_t distance_mm;
+    uint16_t warning_mm;
+    uint16_t warning_display;
+    
+    if (find_nearest_distance(&distance_mm, &warning_mm)) {
+        /* 0 для LED-індикації означає "немає об'єкта" - мінімум 1 */
+        warning_display = convert_distance_to_current_unit(warning_mm);
+        if (warning_display == 0) {
+            warning_display = 1;
+        }
+        led_indication_update(warning_display, convert_threshold_to_current_unit());
+    } else if (app_state.last_status == DISTANCE_STATUS_TOO_CLOSE) {
+        led_indication_update(1, convert_threshold_to_current_unit());
+    } else {
         led_indication_update(0, 0);  /* Вимкнути LED */
-        return;
+    }
+}
+
+/**
+ * @brief Задача TASK_LOG: статистика в лог
+ * 
+ * Звіт по режиму частоти вимірювань - при зміні режиму,
+ * статистика задач, гістограма затримки кнопок, кадри
+ * дисплея (та зони профілювання з PROFILER_ENABLE) - кожні
+ * TASK_STATS_REPORT_RUNS запусків.
+ * 
+ * Логер не блокує: звіт виводиться частинами до
+ * LOG_SECTION_MAX_BYTES, кожна - лише коли вміщується в
+ * чергу передачі. Решта - на наступних запусках, тож задача
+ * не тримає CPU на час передачі по UART.
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void report_statistics(void) {
+    SchedulerTaskStats stats;
+    
+    /* Зміна режиму частоти - звіт по режиму, що завершився */
+    if (distance_sensor_get_rate_mode() != app_state.rate_mode &&
+        logger_ready(LOG_SECTION_MAX_BYTES)) {
+        report_rate_stats(app_state.rate_mode);
+        app_state.rate_mode = distance_sensor_get_rate_mode();
+    }
+    
+    scheduler_get_stats(TASK_LOG, &stats);
+    if ((stats.runs % TASK_STATS_REPORT_RUNS) == 0 &&
+        app_state.report_step == REPORT_STEP_COUNT) {
+        app_state.report_step = REPORT_STEP_CPU;
+    }
+    
+    while (app_state.report_step < REPORT_STEP_COUNT &&
+           logger_ready(LOG_SECTION_MAX_BYTES)) {
+        report_section(app_state.report_step);
+        app_state.report_step++;
+    }
+}
+
+/**
+ * @brief Запит оновлення дисплея та LED на найближчому циклі
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void request_outputs_update(void) {
+    scheduler_run_after(TASK_DISPLAY, 0);
+    scheduler_run_after(TASK_LEDS, 0);
+}
+
+/**
+ * @brief Запит оновлення дисплея у відповідь на жест
+ * 
+ * Лише з обробників жестів (TASK_INPUT): перемальовування
+ * за цим запитом завершує вимірювання затримки кнопки.
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void request_gesture_redraw(void) {
+    app_state.gesture_redraw = 1;
+    scheduler_run_after(TASK_DISPLAY, 0);
+}
+
+/**
+ * @brief Пошук найближчого об'єкта серед датчиків
+ * 
+ * Відстань - найменша серед датчиків, прогноз - найменший
+ * прогноз (об'єкт може наближатись до іншого датчика
+ * швидше, ніж найближчий).
+ * 
+ * @param[out] distance_mm Найменша відстань, мм
+ * @param[out] warning_mm  Найменший прогноз для LED, мм
+ * @retval 1 Знайдено
+ * @retval 0 Жоден датчик не бачить об'єкт
+ */
+static uint8_t find_nearest_distance(uint16_t *distance_mm, uint16_t *warning_mm) {
+    uint8_t sensor;
+    
+    if (app_state.sensor_valid == 0) {
+        return 0;
     }
     
-    /* Конвертація в сантиметри (базова одиниця) */
-    distance_cm = distance_sensor_convert_to_cm(raw_time);
+    *distance_mm = 0xFFFF;
+    *warning_mm = 0xFFFF;
     
-    /* Конвертація для відображення */
-    distance_display = convert_distance_to_current_unit(distance_cm);
-    threshold_display = convert_threshold_to_current_unit();
+    for (sensor = 0; sensor < DISTANCE_SENSOR_COUNT; ++sensor) {
+        if (!(app_state.sensor_valid & (1 << sensor))) {
+            continue;
+        }
+        if (app_state.distance_mm[sensor] < *distance_mm) {
+            *distance_mm = app_state.distance_mm[sensor];
+        }
+        if (app_state.warning_mm[sensor] < *warning_mm) {
+            *warning_mm = app_state.warning_mm[sensor];
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Відображення помилки вимірювання
+ * 
+ * Кожен статус має власний текст на дисплеї, щоб помилку
+ * не можна було сплутати з реальним значенням.
+ * 
+ * @param[in] status Статус вимірювання (DistanceStatus, не OK)
+ * @retval None
+ */
+static void show_measurement_error(uint8_t status) {
+    switch (status) {
+        case DISTANCE_STATUS_TOO_CLOSE:
+            display_show_text(DISPLAY_TEXT_TOO_CLOSE);
+            break;
+            
+        case DISTANCE_STATUS_BEYOND_RANGE:
+            display_show_text(DISPLAY_TEXT_BEYOND_RANGE);
+            break;
+            
+        case DISTANCE_STATUS_ECHO_STUCK_HIGH:
+            display_show_text(DISPLAY_TEXT_STUCK_HIGH);
+            break;
+            
+        case DISTANCE_STATUS_NO_ECHO:
+        default:
+            display_show_text(DISPLAY_TEXT_NO_ECHO);
+            break;
+    }
+}
+
+/**
+ * @brief Вивід підказки або результату калібрування
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void show_calibration_step(void) {
+    switch (app_state.cal_step) {
+        case BUTTON_CAL_PRESS_MODE:
+            display_show_text(DISPLAY_TEXT_CAL_MODE);
+            break;
+            
+        case BUTTON_CAL_PRESS_UP:
+            display_show_text(DISPLAY_TEXT_CAL_UP);
+            break;
+            
+        case BUTTON_CAL_PRESS_DOWN:
+            display_show_text(DISPLAY_TEXT_CAL_DOWN);
+            break;
+            
+        case BUTTON_CAL_DONE:
+            display_show_text(DISPLAY_TEXT_CAL_DONE);
+            break;
+            
+        case BUTTON_CAL_FAILED:
+            display_show_text(DISPLAY_TEXT_CAL_FAILED);
+            break;
+            
+        case BUTTON_CAL_RELEASE:
+        default:
+            display_show_text(DISPLAY_TEXT_CAL_RELEASE);
+            break;
+    }
+}
+
+/**
+ * @brief Вивід статистики режиму частоти вимірювань в лог
+ * 
+ * Середня кількість вимірювань за секунду (x10) та частка
+ * часу простою CPU (%) накопичені за весь час роботи в режимі.
+ * До 40 байт.
+ * 
+ * @param[in] mode Режим частоти
+ * @retval None
+ * 
+ * @note Без LOGGER_UART_ENABLE виклики логера порожні
+ */
+static void report_rate_stats(DistanceRateMode mode) {
+    DistanceRateStats stats;
+    
+    distance_sensor_get_rate_stats(mode, &stats);
     
-    /* Оновлення виходів */
-    display_show_number(distance_display);
-    led_indication_update(distance_display, threshold_display);
+    write_message_in_logger((mode == DISTANCE_RATE_FAST) ? "rate fast: sps x10, idle %"
+                                                         : "rate slow: sps x10, idle %");
+    write_number_in_logger(stats.samples_per_s_x10);
+    write_number_in_logger(stats.idle_percent);
 }
 
+/**
+ * @brief Вивід однієї частини звіту статистики
+ * 
+ * Кожна частина - не більше LOG_SECTION_MAX_BYTES байт
+ * (числа - найбільшої довжини).
+ * 
+ * @param[in] step Крок звіту (REPORT_STEP_*)
+ * @retval None
+ */
+static void report_section(uint8_t step) {
+    if (step == REPORT_STEP_CPU) {
+        report_cpu_stats();
+    } else if (step < REPORT_STEP_LATENCY) {
+        report_task_stats((uint8_t)(step - REPORT_STEP_TASKS));
+    } else if (step == REPORT_STEP_LATENCY) {
+        report_latency_stats();
+    } else if (step == REPORT_STEP_LATENCY_BINS) {
+        report_latency_bins();
+    } else if (step == REPORT_STEP_DISPLAY) {
+        report_display_stats();
+    } else if (step == REPORT_STEP_STACK) {
+        report_stack_stats();
+    }
+#ifdef PROFILER_ENABLE
+    else {
+        report_profiler_zone((uint8_t)(step - REPORT_STEP_ZONES));
+    }
+#endif
+}
+
+/**
+ * @brief Вивід навантаження CPU в лог
+ * 
+ * Навантаження та простій з попереднього звіту, далі нове
+ * вікно. До 61 байта.
+ * 
+ * @param[in] None
+ * @retval None
+ * 
+ * @note Без LOGGER_UART_ENABLE виклики логера порожні
+ */
+static void report_cpu_stats(void) {
+    SchedulerLoadStats load;
+    
+    scheduler_get_load(&load);
+    scheduler_reset_load();
+    
+    write_message_in_logger("cpu: load %, idle ms, total ms");
+    write_number_in_logger(load.load_percent);
+    write_number_in_logger((int32_t)load.idle_ms);
+    write_number_in_logger((int32_t)load.elapsed_ms);
+}
+
+/**
+ * @brief Вивід статистики задачі планувальника в лог
+ * 
+ * Номер задачі, кількість запусків та найдовший час
+ * виконання (мкс). До 47 байт.
+ * 
+ * @param[in] task Номер задачі (BusinessTaskID)
+ * @retval None
+ * 
+ * @note Без LOGGER_UART_ENABLE виклики логера порожні
+ */
+static void report_task_stats(uint8_t task) {
+    SchedulerTaskStats stats;
+    
+    scheduler_get_stats(task, &stats);
+    
+    write_message_in_logger("task: id, runs, wcet us");
+    write_number_in_logger(task);
+    write_number_in_logger((int32_t)stats.runs);
+    write_number_in_logger(stats.wcet_us);
+}
+
+/**
+ * @brief Вивід найбільшої затримки "кнопка → дисплей" в лог
+ * 
+ * Заголовок гістограми та найбільша затримка (мс), кошики -
+ * наступною частиною (report_latency_bins()). До 41 байта.
+ * 
+ * @param[in] None
+ * @retval None
+ * 
+ * @note Без LOGGER_UART_ENABLE виклики логера порожні
+ */
+static void report_latency_stats(void) {
+    LatencyHistogram histogram;
+    
+    latency_probe_get(&histogram);
+    
+    write_message_in_logger("latency: max ms, presses per bin");
+    write_number_in_logger(histogram.max_ms);
+}
+
+/**
+ * @brief Вивід кошиків гістограми затримки в лог
+ * 
+ * Кількість натискань у кожному кошику по LATENCY_PROBE_BIN_MS,
+ * починаючи з 0 мс. Гістограма накопичується з моменту
+ * запуску. До 7 байт на кошик.
+ * 
+ * @param[in] None
+ * @retval None
+ * 
+ * @note Без LOGGER_UART_ENABLE виклики логера порожні
+ */
+static void report_latency_bins(void) {
+    LatencyHistogram histogram;
+    uint8_t bin;
+    
+    latency_probe_get(&histogram);
+    
+    for (bin = 0; bin < LATENCY_PROBE_BINS; ++bin) {
+        write_number_in_logger(histogram.bins[bin]);
+    }
+}
+
+/**
+ * @brief Вивід лічильників кадрів дисплея в лог
+ * 
+ * Передані та пропущені (без змін) кадри за вікно звіту,
+ * далі нове вікно. До 45 байт.
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void report_display_stats(void) {
+    DisplayFrameStats stats;
+    
+    display_get_frame_stats(&stats);
+    display_reset_frame_stats();
+    
+    write_message_in_logger("display: frames sent, skipped");
+    write_number_in_logger(stats.sent);
+    write_number_in_logger(stats.skipped);
+}
+
+/**
+ * @brief Вивід найбільшої глибини стеку в лог
+ * 
+ * Байт стеку, використаних з моменту запуску, та розмір
+ * стеку (build.bat). До 35 байт.
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void report_stack_stats(void) {
+    write_message_in_logger("stack: peak, size bytes");
+    write_number_in_logger(stack_monitor_peak());
+    write_number_in_logger(STACK_MONITOR_SIZE);
+}
+
+#ifdef PROFILER_ENABLE
+/**
+ * @brief Вивід зони профілювання в лог
+ * 
+ * Номер зони (ProfilerZone), кількість проходів, сумарний
+ * та найбільший час у тактах CPU. Після останньої зони
+ * таблиця очищується, наступний звіт - за новий інтервал.
+ * До 61 байта.
+ * 
+ * @param[in] zone Номер зони
+ * @retval None
+ */
+static void report_profiler_zone(uint8_t zone) {
+    ProfilerZoneStats stats;
+    
+    profiler_get_stats(zone, &stats);
+    
+    write_message_in_logger("zone: id, n, sum, max cyc");
+    write_number_in_logger(zone);
+    write_number_in_logger((int32_t)stats.count);
+    write_number_in_logger((int32_t)stats.total_cycles);
+    write_number_in_logger(stats.max_cycles);
+    
+    if (zone == PROFILER_ZONE_COUNT - 1) {
+        profiler_reset();
+    }
+}
+#endif
+
 /**
  * @brief Відображення порогу на дисплеї
  * 
@@ -225,6 +995,11 @@ static void adjust_threshold(int16_t delta) {
 
 /**
  * @brief Конвертація порогу в поточну одиницю виміру
+ * 
+ * Поріг переводиться в міліметри і конвертується тим самим
+ * цілочисельним шляхом, що й виміряна відстань, тому поріг
+ * і відстань на дисплеї округлюються однаково.
+ * 
  * @param None
  * @retval Порогове значення в поточних одиницях
  */
@@ -233,25 +1008,25 @@ static uint16_t convert_threshold_to_current_unit(void) {
         return app_state.threshold_cm;
     }
     
-    /* Конвертація в дюйми */
-    return (uint16_t)((float)app_state.threshold_cm / CM_TO_INCH_FACTOR);
+    /* Конвертація в дюйми (THRESHOLD_MAX * 10 вміщується в uint16_t) */
+    return distance_sensor_mm_to_inch(app_state.threshold_cm * 10);
 }
 
 /**
  * @brief Конвертація відстані в поточну одиницю виміру
  * 
- * @param distance_cm Відстань в сантиметрах
+ * Обидві одиниці отримуються з одного значення в міліметрах,
+ * тому похибка округлення не накопичується.
+ * 
+ * @param distance_mm Відстань в міліметрах
  * @retval Відстань в поточних одиницях
  */
-static uint16_t convert_distance_to_current_unit(uint16_t distance_cm) {
-    uint16_t raw_time;
+static uint16_t convert_distance_to_current_unit(uint16_t distance_mm) {
     if (app_state.unit == UNIT_CM) {
-        return distance_cm;
+        return distance_sensor_mm_to_cm(distance_mm);
     }
     
-    /* Конвертація в дюйми через драйвер */
-    raw_time = distance_cm * 58;  /* Reverse conversion */
-    return distance_sensor_convert_to_inch(raw_time);
+    return distance_sensor_mm_to_inch(distance_mm);
 }
 
 
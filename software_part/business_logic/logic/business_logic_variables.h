@@ -26,23 +26,144 @@
 /** @brief Крок зміни порогу при натисканні кнопок (см) */
 #define THRESHOLD_STEP          10
 
-/** @brief Затримка між вимірюваннями в режимі MEASURE (мс) */
-#define MEASUREMENT_DELAY_MS    65
+/**
+ * @brief Прискорений крок порогу при утриманні UP/DOWN (см)
+ *
+ * Перші THRESHOLD_FAST_AFTER_REPEATS автоповторів змінюють поріг
+ * на THRESHOLD_STEP, наступні - на THRESHOLD_FAST_STEP. З
+ * автоповтором 400 + 100 мс весь діапазон проходиться за ~1.6 с.
+ */
+#define THRESHOLD_FAST_STEP     50
+
+/** @brief Кількість автоповторів з дрібним кроком */
+#define THRESHOLD_FAST_AFTER_REPEATS 5
+
+/**
+ * @brief Жести MODE: утримання - фіксація показу (або вихід
+ *        з неї), подвійний клік - вимкнення порогу (мс)
+ *
+ * Вікно подвійного кліку затримує звичайний клік MODE
+ * (перемикання одиниць) на MODE_DOUBLE_CLICK_MS. UP/DOWN
+ * жестів не мають і реагують одразу.
+ */
+#define MODE_LONG_PRESS_MS      800
+#define MODE_DOUBLE_CLICK_MS    300
+
+/**
+ * @brief Показ відстані не зафіксовано (див. MODE_LONG_PRESS_MS)
+ */
+#define DISTANCE_NOT_FROZEN     0xFFFF
+
+/**
+ * @brief Період вимірювань у швидкому режимі (мкс)
+ * 
+ * Максимальна безпечна частота: 1000000 / 60000 ≈ 16.7 Гц.
+ * Не може бути меншим за DISTANCE_SENSOR_MIN_PERIOD_US (60 мс).
+ */
+#define MEASUREMENT_PERIOD_US   60000U
+
+/**
+ * @brief Дільник частоти у повільному режимі (keep-alive)
+ * 
+ * Вимірювання в кожному 8-му періоді: 60 мс * 8 = 480 мс (≈2 Гц).
+ */
+#define MEASUREMENT_SLOW_DIVIDER    8
+
+/**
+ * @brief Зміна відстані між вимірюваннями, що вважається рухом (мм)
+ */
+#define MEASUREMENT_ACTIVITY_MM     20
+
+/**
+ * @brief Стабільних вимірювань поспіль до переходу в повільний режим
+ * 
+ * 16 * 60 мс ≈ 1 с без руху.
+ */
+#define MEASUREMENT_SETTLE_SAMPLES  16
+
+/**
+ * @brief Горизонт раннього попередження при наближенні (2^-N с)
+ * 
+ * LED-індикація порівнює з порогом не поточну відстань, а
+ * прогноз через 1 / 2^N секунди з урахуванням швидкості
+ * наближення: 1 -> 0.5 с. Швидкий об'єкт спрацьовує раніше.
+ */
+#define APPROACH_LOOKAHEAD_SHIFT 1
+
+/** @brief Період задачі опитування кнопок (мс) */
+#define INPUT_TASK_PERIOD_MS    10
+
+/**
+ * @brief Період задачі забору вимірювань (мс)
+ * 
+ * Значно менший за період вимірювань (60 мс), щоб результат
+ * з'являвся на дисплеї без помітної затримки.
+ */
+#define SENSE_TASK_PERIOD_MS    10
+
+/**
+ * @brief Період задачі статистики (мс)
+ * 
+ * Задача виводить звіт частинами (LOG_SECTION_MAX_BYTES), поки
+ * черга логера має місце: частина на 9600 бод передається за
+ * ~67 мс, тож за період черга встигає звільнитись.
+ */
+#define LOG_TASK_PERIOD_MS      100
+
+/**
+ * @brief Дедлайн задач (мс)
+ * 
+ * Від запланованого часу запуску до завершення. Перевищення
+ * фіксуються в таблиці монітора, постійні перевищення
+ * (довше за WATCHDOG_TIMEOUT_MS ≈ 1 с) скидають MCU.
+ * Вивід у лог не блокує, тож дедлайн спільний для всіх задач.
+ */
+#define TASK_DEADLINE_MS        100
 
-/** @brief Затримка оновлення дисплея в режимі SETUP (мс) */
-#define SETUP_DELAY_MS          100
+/**
+ * @brief Найбільша довжина частини звіту статистики, байт
+ * 
+ * Частина виводиться лише тоді, коли вміщується в чергу
+ * передачі логера (UART1_TX_QUEUE_SIZE) цілою.
+ */
+#define LOG_SECTION_MAX_BYTES   64
 
-/** @brief Коефіцієнт конверсії см -> дюйми */
-#define CM_TO_INCH_FACTOR       2.54f
+/** @brief Статистика задач виводиться кожні N запусків задачі статистики (10 с) */
+#define TASK_STATS_REPORT_RUNS  100
 
 /** @brief Розмір буфера для форматування чисел */
 #define DISPLAY_BUFFER_SIZE     5
 
-/** @brief Значення для відображення помилки вимірювання */
-#define DISPLAY_ERROR_VALUE     0
+/** @brief Текст на дисплеї: датчик не відповідає на тригер */
+#define DISPLAY_TEXT_NO_ECHO        "Err "
+
+/** @brief Текст на дисплеї: лінія ECHO "залипла" в HIGH */
+#define DISPLAY_TEXT_STUCK_HIGH     "ErrH"
+
+/** @brief Текст на дисплеї: об'єкт у сліпій зоні датчика */
+#define DISPLAY_TEXT_TOO_CLOSE      "____"
+
+/** @brief Текст на дисплеї: об'єкт поза діапазоном */
+#define DISPLAY_TEXT_BEYOND_RANGE   " FAr"
+
+/**
+ * @brief Вхід у калібрування кнопок: MODE натиснута протягом
+ *        цього часу після ввімкнення (мс)
+ */
+#define CALIBRATION_ENTRY_WINDOW_MS 1000
+
+/** @brief Час показу результату калібрування (мс) */
+#define CALIBRATION_RESULT_MS       1500
+
+/** @brief Підказки калібрування: відпустити кнопки, утримувати MODE / UP / DOWN */
+#define DISPLAY_TEXT_CAL_RELEASE    "CAL "
+#define DISPLAY_TEXT_CAL_MODE       "CAL1"
+#define DISPLAY_TEXT_CAL_UP         "CAL2"
+#define DISPLAY_TEXT_CAL_DOWN       "CAL3"
 
-/** @brief Затримка для забезпечення стабільної роботи кнопок */
-#define DEBOUNCE_DELAY_MS 110
+/** @brief Результат калібрування: збережено / відхилено */
+#define DISPLAY_TEXT_CAL_DONE       "donE"
+#define DISPLAY_TEXT_CAL_FAILED     "CErr"
 
 //==================== SYSTEM STATES ===================
 
@@ -51,7 +172,8 @@
  */
 typedef enum {
     STATE_MEASURE,      /**< Режим вимірювання відстані */
-    STATE_SETUP         /**< Режим налаштування порогу */
+    STATE_SETUP,        /**< Режим налаштування порогу */
+    STATE_CALIBRATE     /**< Калібрування драбини кнопок */
 } SystemState;
 
 //==================== MEASUREMENT UNITS ===============
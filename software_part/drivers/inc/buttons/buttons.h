@@ -18,6 +18,129 @@
 //==================== INCLUDES ========================
 #include "stm8s.h"
 #include "buttons_handle.h"
+#include "spsc_queue.h"
+#include "systick.h"
+#include "adc.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Кількість смуг драбини (MODE, UP, DOWN)
+ * 
+ * Індекс смуги - ButtonID - BTN_MODE.
+ */
+#define BUTTON_BAND_COUNT           BUTTON_COUNT
+
+/**
+ * @brief Гістерезис декодера (відліки ADC)
+ * 
+ * Розпізнана кнопка тримається, поки рівень не вийде за
+ * її смугу більше ніж на гістерезис: шум на межі смуги
+ * не перемикає кнопки.
+ */
+#ifndef BUTTON_DECODE_HYSTERESIS
+#define BUTTON_DECODE_HYSTERESIS    12
+#endif
+
+/**
+ * @brief Зміщення запису калібрування в EEPROM (кратне 4)
+ */
+#define BUTTON_CAL_EEPROM_OFFSET    0
+
+/**
+ * @brief Калібрування: рівень вважається стабільним, якщо
+ *        BUTTON_CAL_SETTLE_MS не відходить далі за
+ *        BUTTON_CAL_TOLERANCE відліків
+ */
+#ifndef BUTTON_CAL_SETTLE_MS
+#define BUTTON_CAL_SETTLE_MS        300
+#endif
+
+#ifndef BUTTON_CAL_TOLERANCE
+#define BUTTON_CAL_TOLERANCE        8
+#endif
+
+/**
+ * @brief Мінімальна відстань між рівнями кнопок (відліки ADC)
+ * 
+ * Ближчі рівні не розрізняються надійно - калібрування
+ * відхиляється.
+ */
+#ifndef BUTTON_CAL_MIN_GAP
+#define BUTTON_CAL_MIN_GAP          64
+#endif
+
+#if BUTTON_CAL_MIN_GAP <= 2 * (BUTTON_DECODE_HYSTERESIS + BUTTON_CAL_TOLERANCE)
+#error "BUTTON_CAL_MIN_GAP must leave room for hysteresis on both band edges"
+#endif
+
+/**
+ * @brief Час стабільного стану для підтвердження натискання
+ *        або відпускання (мс)
+ * 
+ * Єдиний параметр дебаунсу: інтегратор рахує вибірки ADC
+ * (по одній кожні ADC_SAMPLE_PERIOD_MS).
+ */
+#ifndef DEBOUNCE_DELAY_MS
+#define DEBOUNCE_DELAY_MS           20
+#endif
+
+/**
+ * @brief Поріг інтегратора дебаунсу, вибірок
+ */
+#define DEBOUNCE_SAMPLES            ((DEBOUNCE_DELAY_MS + ADC_SAMPLE_PERIOD_MS - 1) / ADC_SAMPLE_PERIOD_MS)
+
+#if (DEBOUNCE_SAMPLES < 1) || (DEBOUNCE_SAMPLES > 255)
+#error "DEBOUNCE_DELAY_MS must give 1..255 ADC samples"
+#endif
+
+/**
+ * @brief Автоповтор утримуваної кнопки (мс)
+ * 
+ * Перший повтор - через BUTTON_REPEAT_DELAY_MS після фронту
+ * натискання, далі - кожні BUTTON_REPEAT_PERIOD_MS. Моменти
+ * повторів рахуються від попереднього запланованого, тому
+ * затримка обробки не накопичується.
+ */
+#ifndef BUTTON_REPEAT_DELAY_MS
+#define BUTTON_REPEAT_DELAY_MS      400
+#endif
+
+#ifndef BUTTON_REPEAT_PERIOD_MS
+#define BUTTON_REPEAT_PERIOD_MS     100
+#endif
+
+#if (BUTTON_REPEAT_DELAY_MS < 1) || (BUTTON_REPEAT_DELAY_MS > 32767) || \
+    (BUTTON_REPEAT_PERIOD_MS < 1) || (BUTTON_REPEAT_PERIOD_MS > 32767)
+#error "BUTTON_REPEAT_DELAY_MS and BUTTON_REPEAT_PERIOD_MS must be in range 1..32767"
+#endif
+
+/**
+ * @brief Ємність черги подій кнопок
+ * 
+ * Степінь двійки (не більше SPSC_QUEUE_MAX_CAPACITY).
+ * Зміна кнопки без паузи дає дві події (відпускання + натискання).
+ */
+#ifndef BUTTON_EVENT_QUEUE_SIZE
+#define BUTTON_EVENT_QUEUE_SIZE     4
+#endif
+
+#if (BUTTON_EVENT_QUEUE_SIZE & (BUTTON_EVENT_QUEUE_SIZE - 1)) != 0 || \
+    (BUTTON_EVENT_QUEUE_SIZE > SPSC_QUEUE_MAX_CAPACITY)
+#error "BUTTON_EVENT_QUEUE_SIZE must be a power of two up to SPSC_QUEUE_MAX_CAPACITY"
+#endif
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Таблиця смуг драбини (10-бітні рівні ADC, межі включно)
+ * 
+ * Рівні поза всіма смугами - BTN_NONE.
+ */
+typedef struct {
+    uint16_t low[BUTTON_BAND_COUNT];    /**< Нижня межа смуги */
+    uint16_t high[BUTTON_BAND_COUNT];   /**< Верхня межа смуги */
+} ButtonBands;
 
 //================== FUNCTIONS PROTOTYPES ==================
 
@@ -30,23 +153,32 @@
  * 
  * @note Має викликатись один раз при старті системи
  * 
- * @see button_read()
+ * @see button_debounce_init()
  */
 void initialize_buttons(void);
 
+/**
+ * @brief Запуск дебаунсу: очищення черги подій та підключення
+ *        інтегратора до переривання ADC
+ * 
+ * @note Викликається з initialize_buttons() після initialize_adc()
+ */
+void button_debounce_init(void);
+
 /**
  * @brief Декодування аналогового значення в ідентифікатор кнопки
  * 
- * Конвертує значення ADC з резистивної драбини в enum ButtonID
- * на основі порогових значень.
+ * Шукає смугу активної таблиці, в яку потрапляє значення.
+ * Попередньо розпізнана кнопка утримується, поки значення
+ * в межах її смуги ± BUTTON_DECODE_HYSTERESIS.
  * 
- * Порогові діапазони (10-bit ADC, 0-1023):
+ * Таблиця за замовчуванням (10-bit ADC, 0-1023):
  * - BTN_MODE: >920
  * - BTN_DOWN: 580-870
  * - BTN_UP:   100-580
  * - BTN_NONE: інші значення
  * 
- * @param[in] adc_value Значення ADC (0-1023)
+ * @param[in] adc_value Значення ADC (0-1023), середнє пачки
  * 
  * @return Ідентифікатор кнопки
  * @retval BTN_NONE Жодна кнопка не розпізнана
@@ -54,11 +186,65 @@ void initialize_buttons(void);
  * @retval BTN_UP   Розпізнана кнопка UP
  * @retval BTN_DOWN Розпізнана кнопка DOWN
  * 
- * @note Порогові значення підібрані експериментально для
- *       конкретної резистивної драбини
- * 
+ * @note Має стан (гістерезис): викликається лише з дебаунсу
+ *       (переривання ADC)
  */
 ButtonID button_decode(uint16_t adc_value);
 
+/**
+ * @brief Перехід ADC в очікування натискання
+ * 
+ * Якщо рівень драбини нижче найнижчої смуги з запасом на
+ * гістерезис (жодна кнопка не натиснута) і очікування
+ * дозволене, ADC перестає робити вибірки за тіком і чекає
+ * на аналоговому watchdog, поки напруга не перевищить
+ * button_idle_ceiling(). Інакше нічого не робить.
+ * 
+ * @param[in] adc_value Усереднене значення ADC (0-1023)
+ * 
+ * @note Викликається з обробника вибірки, коли дебаунс
+ *       у спокої (BTN_NONE, інтегратор порожній)
+ * 
+ * @see adc_watch_above()
+ */
+void button_idle_watch(uint16_t adc_value);
+
+/**
+ * @brief Дозвіл переходу ADC в очікування
+ * 
+ * @param[in] enable 0 - ADC робить вибірки постійно (калібрування
+ *                   потребує рівня без натискань), 1 - дозволено
+ */
+void button_idle_watch_enable(uint8_t enable);
+
+/**
+ * @brief Найвищий рівень ADC без натискання
+ * 
+ * @return Нижня межа найнижчої смуги мінус 1
+ */
+uint16_t button_idle_ceiling(void);
+
+/**
+ * @brief Завантаження таблиці смуг з EEPROM
+ * 
+ * Без валідного запису (ознака, контрольна сума, межі)
+ * використовується таблиця за замовчуванням.
+ * 
+ * @note Викликається з initialize_buttons() до дозволу переривань
+ */
+void button_bands_load(void);
+
+/**
+ * @brief Збереження таблиці смуг в EEPROM та її застосування
+ * 
+ * @param[in] bands Нова таблиця
+ * 
+ * @return 1 - збережено і застосовано, 0 - помилка запису
+ *         (активна таблиця не змінюється)
+ * 
+ * @warning Блокує на час запису EEPROM (до ~25 мс)
+ */
+uint8_t button_bands_save(const ButtonBands *bands);
+
 
 #endif
\ No newline at end of file
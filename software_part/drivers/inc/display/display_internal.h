@@ -38,7 +38,8 @@ void display_driver_init(void);
  * @brief Відправка тексту на дисплей
  * 
  * Конвертує текстовий рядок у 7-сегментний формат
- * та передає до HAL драйвера для відображення.
+ * та передає до HAL драйвера лише змінені розряди
+ * (кадр без змін не передається).
  * 
  * 
  * @param[in] text Null-terminated рядок для відображення
@@ -68,7 +69,8 @@ void display_format_number(uint16_t number, char *buffer);
 /**
  * @brief Встановлення яскравості дисплея
  * 
- * Передає команду зміни яскравості до HAL драйвера.
+ * Передає команду зміни яскравості до HAL драйвера,
+ * якщо яскравість відрізняється від останньої прийнятої.
  * 
  * @param[in] brightness Рівень яскравості (0-7)
  * 
@@ -78,4 +80,21 @@ void display_format_number(uint16_t number, char *buffer);
  */
 void display_driver_set_brightness(uint8_t brightness);
 
+/**
+ * @brief Лічильники кадрів з моменту останнього скидання
+ * 
+ * @param[out] sent    Кадри, передані в TM1637 (повністю або частково)
+ * @param[out] skipped Кадри без змін, що не передавались
+ * 
+ * @see display_get_frame_stats()
+ */
+void display_driver_get_frame_stats(uint16_t *sent, uint16_t *skipped);
+
+/**
+ * @brief Скидання лічильників кадрів
+ * 
+ * @see display_reset_frame_stats()
+ */
+void display_driver_reset_frame_stats(void);
+
 #endif /* __DISPLAY_INTERNAL_H */
\ No newline at end of file
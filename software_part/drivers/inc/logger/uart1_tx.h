@@ -16,6 +16,10 @@
  * - Stop bits: 1
  * - Flow control: None
  * 
+ * Передача через переривання TXE (IRQ17): функції відправки
+ * кладуть байти в чергу spsc_queue і повертаються, не чекаючи
+ * кінця передачі. Функції не блокують: байти, що не вмістились
+ * у чергу, відкидаються - місце перевіряється uart1_tx_free().
  */
 
 #ifndef __UART1_TX_H
@@ -23,6 +27,7 @@
 
 //==================== INCLUDES ========================
 #include "stm8s.h"
+#include "spsc_queue.h"
 //==================== CONSTANTS =======================
 
 /**
@@ -43,6 +48,29 @@
  */
 #define UART_SYSTEM_CLOCK   HSI_VALUE
 
+/**
+ * @brief Номер вектора переривання UART1 TX (TXE/TC)
+ * 
+ * Використовується в таблиці векторів (stm8_interrupt_vector.c).
+ */
+#define UART1_TX_IRQ_NUMBER 17
+
+/**
+ * @brief Ємність черги передачі, байт
+ * 
+ * Степінь двійки (не більше SPSC_QUEUE_MAX_CAPACITY). Пам'ять
+ * черги - у нульовій сторінці. 64 байти на 9600 бод
+ * передаються за ~67 мс.
+ */
+#ifndef UART1_TX_QUEUE_SIZE
+#define UART1_TX_QUEUE_SIZE 64
+#endif
+
+#if (UART1_TX_QUEUE_SIZE & (UART1_TX_QUEUE_SIZE - 1)) != 0 || \
+    (UART1_TX_QUEUE_SIZE > SPSC_QUEUE_MAX_CAPACITY)
+#error "UART1_TX_QUEUE_SIZE must be a power of two up to SPSC_QUEUE_MAX_CAPACITY"
+#endif
+
 //================== FUNCTION PROTOTYPES ===============
 
 /**
@@ -53,6 +81,7 @@
  * - No parity
  * - 1 stop bit
  * - Передатчик увімкнено, приймач вимкнено
+ * - Черга передачі порожня
  * 
  * @param[in] baud_rate Швидкість передачі (біт/с)
  *                      Рекомендовано: UART_BAUD_9600
@@ -68,6 +97,17 @@
  */
 void uart1_tx_init(uint32_t baud_rate, uint32_t f_master);
 
+/**
+ * @brief Вільне місце в черзі передачі
+ * 
+ * @return Кількість байтів, які можна поставити в чергу
+ *         без втрат (0 - UART1_TX_QUEUE_SIZE)
+ * 
+ * @note Знімок: переривання TXE може лише збільшити місце
+ *       після зчитування
+ */
+uint8_t uart1_tx_free(void);
+
 /**
  * @brief Відправка масиву байтів по UART
  * 
@@ -77,9 +117,9 @@ void uart1_tx_init(uint32_t baud_rate, uint32_t f_master);
  * @warning data не може бути NULL
  * @warning length має бути > 0
  * 
- * @note Блокуюча функція
+ * @note Не чекає: байти, що не вмістились у чергу, відкидаються
  * 
- * @see uart1_tx_byte()
+ * @see uart1_tx_free()
  * @see uart1_tx_string()
  */
 void uart1_tx_buffer(const uint8_t* data, uint16_t length);
@@ -93,9 +133,9 @@ void uart1_tx_buffer(const uint8_t* data, uint16_t length);
  * @warning Рядок має закінчуватись '\0'
  * 
  * @note Не додає '\r\n' автоматично
- * @note Блокуюча функція
+ * @note Не чекає: байти, що не вмістились у чергу, відкидаються
  * 
- * @see uart1_tx_byte()
+ * @see uart1_tx_free()
  * @see uart1_tx_buffer()
  */
 void uart1_tx_string(const char* str);
@@ -110,10 +150,20 @@ void uart1_tx_string(const char* str);
  * @param[in] number Ціле число для передачі (-2147483648 до 2147483647)
  * 
  * @note Не додає '\r\n' автоматично
- * @note Блокуюча функція
+ * @note Не чекає: байти, що не вмістились у чергу, відкидаються
  * 
  * @see uart1_tx_string()
  */
 void uart1_tx_number(int32_t number);
 
+/**
+ * @brief Обробник переривання UART1 TX (регістр даних вільний)
+ * 
+ * Передає наступний байт з черги, на порожній черзі
+ * вимикає переривання TXE.
+ * 
+ * @note Вказується у таблиці векторів як irq17
+ */
+INTERRUPT_HANDLER(uart1_tx_irq_handler, UART1_TX_IRQ_NUMBER);
+
 #endif /* UART1_TX_H */
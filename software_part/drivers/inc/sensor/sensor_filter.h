@@ -0,0 +1,111 @@
+/**
+ * @file    sensor_filter.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Внутрішній заголовок фільтра вимірювань датчика відстані
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Ковзне вікно останніх N значень часу відбиття з медіанним
+ * фільтром або усіченим середнім (trimmed mean). Фільтр
+ * усуває поодинокі хибні відбиття, які інакше потрапляють
+ * на дисплей та викликають мерехтіння LED-індикації.
+ *
+ * Реалізація:
+ * - Кільцевий буфер фіксованого розміру (без heap)
+ * - Паралельно підтримується відсортована копія вікна:
+ *   видалення найстарішого та вставка нового значення - O(N)
+ * - Медіана - O(1), усічене середнє - O(N)
+ *
+ * Кожен датчик має власне вікно.
+ *
+ * Використання RAM: (4 * SENSOR_FILTER_WINDOW + 2) байти на датчик
+ * (22 байти для вікна 5)
+ *
+ * @note Цей файл НЕ повинен включатись напряму в інші модулі!
+ *       Використовуйте distance_sensor.h замість цього.
+ */
+
+#ifndef __SENSOR_FILTER_H
+#define __SENSOR_FILTER_H
+
+//==================== INCLUDES ========================
+#include "distance_sensor.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Режим фільтра: медіана вікна
+ */
+#define SENSOR_FILTER_MODE_MEDIAN       0
+
+/**
+ * @brief Режим фільтра: усічене середнє вікна
+ *
+ * Відкидається SENSOR_FILTER_TRIM найменших та найбільших
+ * значень, решта усереднюється.
+ */
+#define SENSOR_FILTER_MODE_TRIMMED_MEAN 1
+
+/**
+ * @brief Розмір вікна фільтра (кількість вимірювань)
+ *
+ * Вибирається на етапі компіляції (1-15). Більше вікно краще
+ * придушує викиди, але збільшує затримку реакції:
+ * 5 вимірювань * 65 мс ≈ 0.3 с.
+ */
+#ifndef SENSOR_FILTER_WINDOW
+#define SENSOR_FILTER_WINDOW            5
+#endif
+
+/**
+ * @brief Режим фільтра (SENSOR_FILTER_MODE_*)
+ */
+#ifndef SENSOR_FILTER_MODE
+#define SENSOR_FILTER_MODE              SENSOR_FILTER_MODE_MEDIAN
+#endif
+
+/**
+ * @brief Кількість відкинутих значень з кожного краю (trimmed mean)
+ */
+#ifndef SENSOR_FILTER_TRIM
+#define SENSOR_FILTER_TRIM              1
+#endif
+
+#if (SENSOR_FILTER_WINDOW < 1) || (SENSOR_FILTER_WINDOW > 15)
+#error "SENSOR_FILTER_WINDOW must be in range 1..15"
+#endif
+
+#if (SENSOR_FILTER_MODE == SENSOR_FILTER_MODE_TRIMMED_MEAN) && \
+    ((2 * SENSOR_FILTER_TRIM) >= SENSOR_FILTER_WINDOW)
+#error "SENSOR_FILTER_TRIM leaves no samples to average"
+#endif
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Скидання фільтра (порожні вікна всіх датчиків)
+ *
+ * @see sensor_filter_update()
+ */
+void sensor_filter_reset(void);
+
+/**
+ * @brief Додавання вимірювання у вікно та обчислення результату
+ *
+ * Найстаріше значення витісняється з кільцевого буфера та
+ * з відсортованої копії, нове вставляється на своє місце.
+ * Поки вікно не заповнене, результат рахується по наявних
+ * значеннях.
+ *
+ * @param[in] sensor  Номер датчика (0 - DISTANCE_SENSOR_COUNT-1)
+ * @param[in] time_us Час відбиття в мікросекундах (ненульовий)
+ *
+ * @return Відфільтрований час відбиття в мікросекундах
+ *
+ * @note Невалідні вимірювання (статус не OK) у фільтр не передаються
+ *
+ * @see SENSOR_FILTER_MODE
+ */
+uint16_t sensor_filter_update(uint8_t sensor, uint16_t time_us);
+
+#endif /* __SENSOR_FILTER_H */
@@ -42,48 +42,85 @@
 void sensor_initialize(void);
 
 /**
- * @brief Вимірювання тривалості імпульсу ECHO
+ * @brief Запуск планувальника вимірювань
  * 
- * Виконує повний цикл вимірювання відстані:
- * 1. Генерація тригерного імпульсу
- * 2. Захоплення rising edge ECHO
- * 3. Захоплення falling edge ECHO
- * 4. Обчислення тривалості імпульсу
+ * Делегує виклик до hcsr04_ranging_start().
  * 
- * @param[in] timeout_us Максимальний час очікування в мікросекундах
+ * @param[in] period_us  Період вимірювань в мікросекундах
+ * @param[in] timeout_us Дедлайн очікування ECHO в мікросекундах
  * 
- * @return Тривалість імпульсу ECHO в мікросекундах
- * @retval 0 Таймаут або помилка вимірювання
- * @retval >0 Виміряна тривалість імпульсу
+ * @see distance_sensor_start_ranging()
+ */
+void sensor_start_ranging(uint16_t period_us, uint16_t timeout_us);
+
+/**
+ * @brief Встановлення дільника тригерів
+ * 
+ * Делегує виклик до hcsr04_set_trigger_divider().
+ * 
+ * @param[in] divider Вимірювання в кожному divider-му періоді
+ */
+void sensor_set_trigger_divider(uint8_t divider);
+
+/**
+ * @brief Час від запуску вимірювань в мікросекундах
  * 
- * @note Функція блокуюча
+ * Делегує виклик до hcsr04_time_us().
  * 
- * @see distance_sensor_measure_raw()
+ * @return Час в мікросекундах
  */
-uint16_t sensor_measure_pulse(uint32_t timeout_us);
+uint32_t sensor_time_us(void);
 
 /**
- * @brief Конвертація часу у сантиметри
+ * @brief Зчитування наступного вимірювання з буфера
+ * 
+ * Зчитує вимірювання через hcsr04_read_sample() та
+ * класифікує його: статус захоплення HAL перетворюється
+ * в DistanceStatus, тривалість ECHO перевіряється на
+ * DISTANCE_SENSOR_MIN_ECHO_US / DISTANCE_SENSOR_MAX_ECHO_US.
+ * 
+ * @param[out] result Класифіковане вимірювання (без фільтрації)
+ * 
+ * @return 1 якщо вимірювання зчитане, 0 якщо буфер порожній
+ * 
+ * @see distance_sensor_read()
+ */
+uint8_t sensor_read_sample(DistanceResult *result);
+
+/**
+ * @brief Конвертація часу у міліметри
  * 
  * Детальна реалізація описана в distance_sensor.h
  * 
  * @param[in] time_us Час у мікросекундах
+ * @return Відстань в міліметрах
+ * 
+ * @see distance_sensor_convert_to_mm()
+ */
+uint16_t sensor_convert_to_mm(uint16_t time_us);
+
+/**
+ * @brief Конвертація міліметрів у сантиметри
+ * 
+ * Детальна реалізація описана в distance_sensor.h
+ * 
+ * @param[in] distance_mm Відстань в міліметрах
  * @return Відстань в сантиметрах
  * 
- * @see distance_sensor_convert_to_cm()
+ * @see distance_sensor_mm_to_cm()
  */
-uint16_t sensor_convert_to_cm(uint16_t time_us);
+uint16_t sensor_mm_to_cm(uint16_t distance_mm);
 
 /**
- * @brief Конвертація часу у дюйми
+ * @brief Конвертація міліметрів у дюйми
  * 
  * Детальна реалізація описана в distance_sensor.h
  * 
- * @param[in] time_us Час у мікросекундах
+ * @param[in] distance_mm Відстань в міліметрах
  * @return Відстань в дюймах
  * 
- * @see distance_sensor_convert_to_inch()
+ * @see distance_sensor_mm_to_inch()
  */
-uint16_t sensor_convert_to_inch(uint16_t time_us);
+uint16_t sensor_mm_to_inch(uint16_t distance_mm);
 
 #endif /* __SENSOR_H */
\ No newline at end of file
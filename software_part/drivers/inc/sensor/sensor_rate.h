@@ -0,0 +1,97 @@
+/**
+ * @file    sensor_rate.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Внутрішній заголовок адаптивного керування частотою вимірювань
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Контролер перемикає два режими за політикою DistanceRatePolicy:
+ * - FAST: вимірювання в кожному періоді планувальника
+ *   (максимальна безпечна частота)
+ * - SLOW: вимірювання в кожному slow_divider-му періоді
+ *   (keep-alive, коли сцена стабільна)
+ *
+ * Будь-яка зміна відстані більше activity_mm повертає FAST
+ * одразу; settle_samples стабільних вимірювань поспіль
+ * переводять у SLOW. Зміна рахується відносно попереднього
+ * вимірювання того ж датчика, режим спільний для всіх датчиків.
+ *
+ * Для кожного режиму ведуться лічильники вимірювань, часу
+ * та часу обробки вимірювань основним циклом.
+ *
+ * @note Цей файл НЕ повинен включатись напряму в інші модулі!
+ *       Використовуйте distance_sensor.h замість цього.
+ */
+
+#ifndef __SENSOR_RATE_H
+#define __SENSOR_RATE_H
+
+//==================== INCLUDES ========================
+#include "distance_sensor.h"
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Встановлення політики та скидання лічильників
+ *
+ * @param[in] policy Політика частоти (NULL - фіксована частота,
+ *                   завжди режим FAST)
+ * @param[in] now_us  Поточний час sensor_time_us()
+ * @param[in] idle_us Поточний сумарний простій scheduler_idle_us()
+ *
+ * @see distance_sensor_set_rate_policy()
+ */
+void sensor_rate_configure(const DistanceRatePolicy *policy, uint32_t now_us,
+                           uint32_t idle_us);
+
+/**
+ * @brief Облік часу на кожному опитуванні буфера вимірювань
+ *
+ * Час з попереднього опитування та простій CPU за цей час
+ * (приріст лічильника планувальника) зараховуються
+ * поточному режиму.
+ *
+ * @param[in] now_us  Поточний час sensor_time_us()
+ * @param[in] idle_us Поточний сумарний простій scheduler_idle_us()
+ */
+void sensor_rate_account(uint32_t now_us, uint32_t idle_us);
+
+/**
+ * @brief Оновлення режиму новим вимірюванням
+ *
+ * @param[in] sensor  Номер датчика (0 - DISTANCE_SENSOR_COUNT-1)
+ * @param[in] time_us Відфільтрований час відбиття (0 - немає відбиття)
+ *
+ * @return 1 якщо режим змінився (потрібно застосувати дільник)
+ *
+ * @see sensor_rate_divider()
+ */
+uint8_t sensor_rate_update(uint8_t sensor, uint16_t time_us);
+
+/**
+ * @brief Поточний режим частоти
+ *
+ * @return DISTANCE_RATE_FAST або DISTANCE_RATE_SLOW
+ */
+DistanceRateMode sensor_rate_mode(void);
+
+/**
+ * @brief Дільник тригерів для поточного режиму
+ *
+ * @return 1 для FAST, slow_divider політики для SLOW
+ */
+uint8_t sensor_rate_divider(void);
+
+/**
+ * @brief Статистика режиму
+ *
+ * Детальна реалізація описана в distance_sensor.h
+ *
+ * @param[in]  mode  Режим
+ * @param[out] stats Лічильники та середні значення
+ *
+ * @see distance_sensor_get_rate_stats()
+ */
+void sensor_rate_get_stats(DistanceRateMode mode, DistanceRateStats *stats);
+
+#endif /* __SENSOR_RATE_H */
@@ -0,0 +1,119 @@
+/**
+ * @file    sensor_tracker.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Внутрішній заголовок альфа-бета трекера відстані
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Альфа-бета фільтр з фіксованою комою оцінює відстань до
+ * об'єкта та швидкість його наближення на кожному вимірюванні.
+ * Кожен датчик має власний стан трекера.
+ *
+ * На кожному кроці:
+ * 1. Прогноз: pred = pos + vel (vel - мм за період вимірювань)
+ * 2. Перевірка вікна: |z - pred| > SENSOR_TRACKER_GATE_MM -
+ *    фізично неможливий стрибок, вимірювання відкидається
+ * 3. Корекція: pos = pred + alpha * r, vel = vel + beta * r
+ *
+ * Формат чисел:
+ * - Позиція та швидкість: Q4 (1/16 мм, 1/16 мм за період)
+ * - Коефіцієнти alpha/beta: Q8 (1/256)
+ *
+ * @note Цей файл НЕ повинен включатись напряму в інші модулі!
+ *       Використовуйте distance_sensor.h замість цього.
+ */
+
+#ifndef __SENSOR_TRACKER_H
+#define __SENSOR_TRACKER_H
+
+//==================== INCLUDES ========================
+#include "distance_sensor.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Коефіцієнт корекції позиції alpha (Q8)
+ *
+ * 128 = 0.5: компроміс між придушенням шуму та затримкою.
+ */
+#ifndef SENSOR_TRACKER_ALPHA
+#define SENSOR_TRACKER_ALPHA        128
+#endif
+
+/**
+ * @brief Коефіцієнт корекції швидкості beta (Q8)
+ *
+ * Критично демпфований трекер: beta = alpha^2 / (2 - alpha),
+ * для alpha = 0.5 -> 0.167 ≈ 43 / 256.
+ */
+#ifndef SENSOR_TRACKER_BETA
+#define SENSOR_TRACKER_BETA         43
+#endif
+
+/**
+ * @brief Напівширина вікна очікуваного відбиття (мм)
+ *
+ * Відхилення від прогнозу більше за це значення вважається
+ * фізично неможливим стрибком: 200 мм за 65 мс відповідає
+ * прискоренню, недосяжному для об'єкта паркування/стикування.
+ */
+#ifndef SENSOR_TRACKER_GATE_MM
+#define SENSOR_TRACKER_GATE_MM      200
+#endif
+
+/**
+ * @brief Кількість відкинутих вимірювань поспіль до перезахоплення
+ *
+ * Якщо об'єкт дійсно змінився (прибрали перешкоду), трекер
+ * після цієї кількості промахів стартує з нового значення.
+ */
+#ifndef SENSOR_TRACKER_MAX_MISSES
+#define SENSOR_TRACKER_MAX_MISSES   3
+#endif
+
+#if (SENSOR_TRACKER_ALPHA < 1) || (SENSOR_TRACKER_ALPHA > 256) || \
+    (SENSOR_TRACKER_BETA < 1) || (SENSOR_TRACKER_BETA > SENSOR_TRACKER_ALPHA)
+#error "SENSOR_TRACKER_ALPHA/BETA out of range"
+#endif
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Скидання трекерів усіх датчиків (об'єкт не захоплено)
+ *
+ * @see sensor_tracker_update()
+ */
+void sensor_tracker_reset(void);
+
+/**
+ * @brief Встановлення періоду вимірювань для розрахунку швидкості
+ *
+ * Ділення модуля виконуються тут, при зміні частоти
+ * вимірювань, а не на кожному вимірюванні. При зміні
+ * дільника оцінка швидкості перераховується на новий
+ * період, при зміні періоду планувальника - скидається.
+ *
+ * @param[in] period_us Період планувальника в мікросекундах
+ * @param[in] divider   Кількість періодів між вимірюваннями одного
+ *                      датчика: дільник тригерів * кількість датчиків
+ *
+ * @see distance_sensor_start_ranging()
+ */
+void sensor_tracker_set_period(uint16_t period_us, uint16_t divider);
+
+/**
+ * @brief Оновлення трекера новим вимірюванням
+ *
+ * Детальна реалізація описана в distance_sensor.h
+ *
+ * @param[in]  sensor      Номер датчика (0 - DISTANCE_SENSOR_COUNT-1)
+ * @param[in]  distance_mm Відстань в міліметрах (0 - немає відбиття)
+ * @param[out] track       Оцінка стану та вікно наступного вимірювання
+ *
+ * @return 1 якщо вимірювання прийняте, 0 якщо відкинуте
+ *
+ * @see distance_sensor_track()
+ */
+uint8_t sensor_tracker_update(uint8_t sensor, uint16_t distance_mm, DistanceTrack *track);
+
+#endif /* __SENSOR_TRACKER_H */
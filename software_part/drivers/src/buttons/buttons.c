@@ -11,66 +11,209 @@
  * - ADC Channel: ADC1 Channel 3 (PD2)
  * - Резистивна драбина: 4 кнопки (MODE, UP, DOWN, NONE)
  * - Роздільна здатність ADC: 10 біт (0-1023)
+ * - Смуги кнопок з гістерезисом, таблиця калібрується
+ *   (buttons_calibration.c) та зберігається в EEPROM
+ * - Без натискання ADC очікує на аналоговому watchdog з
+ *   порогом нижньої смуги
  */
 
 //==================== INCLUDES ========================
 #include "buttons.h"
 #include "adc.h"
+#include "eeprom.h"
+#include "critical_section.h"
 
 //==================== DEFINES =========================
 
-
 /**
- * @brief Поріг ADC для кнопки MODE
- * 
- * Значення ADC вище цього порогу інтерпретується як
- * натискання кнопки MODE.
+ * @brief Ознака валідного запису калібрування в EEPROM
  */
-#define ADC_THRESHOLD_MODE          920
+#define BUTTON_CAL_MAGIC            ((uint16_t)0xCA1B)
+
+//==================== TYPES ===========================
 
 /**
- * @brief Мінімальний поріг ADC для кнопки DOWN
- * 
- * Нижня межа діапазону для розпізнавання кнопки DOWN.
+ * @brief Запис калібрування в EEPROM (16 байт, 4 слова)
  */
-#define ADC_THRESHOLD_DOWN_MIN      580
+typedef struct {
+    uint16_t    magic;              /**< BUTTON_CAL_MAGIC */
+    ButtonBands bands;              /**< Смуги кнопок */
+    uint16_t    checksum;           /**< Доповнення суми попередніх слів */
+} ButtonCalibrationRecord;
+
+//============= STATIC INTERNAL VARIABLES ==============
 
 /**
- * @brief Максимальний поріг ADC для кнопки DOWN
+ * @brief Смуги за замовчуванням (драбина з документації плати)
  * 
- * Верхня межа діапазону для розпізнавання кнопки DOWN.
+ * MODE: >920, DOWN: 580-870, UP: 100-580 (межі не включно).
  */
-#define ADC_THRESHOLD_DOWN_MAX      870
+static const ButtonBands button_default_bands = {
+    { 921, 101, 581 },
+    { 1023, 579, 869 }
+};
 
 /**
- * @brief Мінімальний поріг ADC для кнопки UP
+ * @brief Активна таблиця смуг та стан декодера
  * 
- * Нижня межа діапазону для розпізнавання кнопки UP.
- * Верхня межа неявно задана як ADC_THRESHOLD_DOWN_MIN.
+ * Нульова сторінка (TINY): основна RAM майже вичерпана.
+ * Таблицю читає переривання ADC, змінює лише
+ * button_bands_load() (до дозволу переривань) та
+ * button_bands_apply() з забороною переривань.
  */
-#define ADC_THRESHOLD_UP_MIN        100
+static TINY ButtonBands button_bands;
+static TINY ButtonID    decoded_button;
+static TINY uint8_t     idle_watch_enabled;
+
+//============= STATIC FUNCTION PROTOTYPES =============
+
+static void button_bands_apply(const ButtonBands *bands);
+static uint16_t button_record_checksum(const ButtonCalibrationRecord *record);
 
 //============ PUBLIC FUNCTION IMPLEMENTATIONS =========
 
 
 
 void initialize_buttons(void){
+    button_bands_load();
+    idle_watch_enabled = 1;
     initialize_adc();
+    button_debounce_init();
 }
 
 
 ButtonID button_decode(uint16_t adc_value){
-    if(adc_value > ADC_THRESHOLD_MODE){
-            return BTN_MODE;
+    uint8_t band;
+    
+    // Попередня кнопка тримається в смузі, розширеній на гістерезис
+    if (decoded_button != BTN_NONE) {
+        band = (uint8_t)(decoded_button - BTN_MODE);
+        if (adc_value + BUTTON_DECODE_HYSTERESIS >= button_bands.low[band] &&
+            adc_value <= button_bands.high[band] + BUTTON_DECODE_HYSTERESIS) {
+            return decoded_button;
         }
-        else if(adc_value > ADC_THRESHOLD_DOWN_MIN &&  adc_value < ADC_THRESHOLD_DOWN_MAX){
-            return BTN_DOWN;
+    }
+    
+    decoded_button = BTN_NONE;
+    for (band = 0; band < BUTTON_BAND_COUNT; ++band) {
+        if (adc_value >= button_bands.low[band] && adc_value <= button_bands.high[band]) {
+            decoded_button = (ButtonID)(band + BTN_MODE);
+            break;
         }
-        else if(adc_value > ADC_THRESHOLD_UP_MIN && adc_value < ADC_THRESHOLD_DOWN_MIN){
-            return BTN_UP;
-        } 
-        else {
-            return BTN_NONE; 
+    }
+    
+    return decoded_button;
+}
+
+
+uint16_t button_idle_ceiling(void){
+    uint16_t lowest = button_bands.low[0];
+    uint8_t band;
+    
+    for (band = 1; band < BUTTON_BAND_COUNT; ++band) {
+        if (button_bands.low[band] < lowest) {
+            lowest = button_bands.low[band];
         }
+    }
+    
+    return (uint16_t)(lowest - 1);
+}
+
+
+void button_idle_watch(uint16_t adc_value){
+    uint16_t ceiling;
+    
+    if (!idle_watch_enabled) {
+        return;
+    }
+    
+    // Рівень у проміжках драбини тримає вибірки, щоб AWD не спрацьовував безперервно
+    ceiling = button_idle_ceiling();
+    if (adc_value + BUTTON_DECODE_HYSTERESIS > ceiling) {
+        return;
+    }
+    adc_watch_above(ceiling);
 }
 
+
+void button_idle_watch_enable(uint8_t enable){
+    idle_watch_enabled = enable;
+    if (!enable) {
+        adc_watch_cancel();
+    }
+}
+
+
+void button_bands_load(void){
+    ButtonCalibrationRecord record;
+    uint8_t band;
+    
+    // До дозволу переривань: таблиця пишеться без заборони
+    button_bands = button_default_bands;
+    
+    eeprom_read(BUTTON_CAL_EEPROM_OFFSET, &record, sizeof(record));
+    if (record.magic != BUTTON_CAL_MAGIC ||
+        record.checksum != button_record_checksum(&record)) {
+        return;
+    }
+    
+    for (band = 0; band < BUTTON_BAND_COUNT; ++band) {
+        if (record.bands.low[band] == 0 ||
+            record.bands.low[band] > record.bands.high[band]) {
+            return;
+        }
+    }
+    
+    button_bands = record.bands;
+}
+
+
+uint8_t button_bands_save(const ButtonBands *bands){
+    ButtonCalibrationRecord record;
+    
+    record.magic = BUTTON_CAL_MAGIC;
+    record.bands = *bands;
+    record.checksum = button_record_checksum(&record);
+    
+    if (!eeprom_write(BUTTON_CAL_EEPROM_OFFSET, &record, sizeof(record))) {
+        return 0;
+    }
+    
+    button_bands_apply(bands);
+    return 1;
+}
+
+//============= STATIC INTERNAL FUNCTION IMPLEMENTATIONS =======
+
+/**
+ * @brief Заміна активної таблиці смуг
+ * 
+ * @param[in] bands Нова таблиця
+ * @retval None
+ */
+static void button_bands_apply(const ButtonBands *bands){
+    uint8_t cc;
+    
+    CRITICAL_SECTION_ENTER(cc);
+    button_bands = *bands;
+    decoded_button = BTN_NONE;
+    CRITICAL_SECTION_EXIT(cc);
+}
+
+/**
+ * @brief Контрольна сума запису (без поля checksum)
+ * 
+ * @param[in] record Запис калібрування
+ * @return Доповнення 16-бітної суми слів
+ */
+static uint16_t button_record_checksum(const ButtonCalibrationRecord *record){
+    uint16_t sum = record->magic;
+    uint8_t band;
+    
+    for (band = 0; band < BUTTON_BAND_COUNT; ++band) {
+        sum += record->bands.low[band];
+        sum += record->bands.high[band];
+    }
+    
+    return (uint16_t)~sum;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file    buttons_calibration.c
+ * @brief   Покрокове калібрування резистивної драбини кнопок
+ * @author  Olexandr Makedonskyi
+ *
+ * Оператор за підказками відпускає кнопки та по черзі утримує
+ * MODE, UP, DOWN. Для кожного кроку записується рівень ADC,
+ * стабільний протягом BUTTON_CAL_SETTLE_MS. Межі смуг - середини
+ * між сусідніми рівнями, таблиця зберігається в EEPROM.
+ *
+ * Рівень без натискань має бути найнижчим (підтяжка до GND),
+ * інакше очікування на AWD не побачить натискання.
+ */
+
+//==================== INCLUDES ========================
+
+#include "buttons.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Верхня межа шкали ADC
+ */
+#define BUTTON_CAL_ADC_MAX          1023
+
+//============= STATIC INTERNAL VARIABLES ==============
+
+/**
+ * @brief Стан калібрування (нульова сторінка, див. buttons.c)
+ */
+static TINY struct {
+    uint8_t  step;              /**< ButtonCalibrationStep */
+    uint8_t  next;              /**< ButtonID наступної кнопки (BTN_NONE - ще немає рівня спокою) */
+    uint16_t reference;         /**< Рівень, стабільність якого перевіряється */
+    uint16_t since_ms;          /**< Час, з якого рівень тримається біля reference */
+    uint16_t levels[BUTTON_BAND_COUNT + 1]; /**< Рівні за ButtonID */
+} calibration;
+
+//============= STATIC FUNCTION PROTOTYPES =============
+
+static uint16_t level_distance(uint16_t a, uint16_t b);
+static void calibration_accept(uint16_t level);
+static void calibration_finish(void);
+static uint8_t calibration_compute(ButtonBands *bands);
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+void button_calibration_start(void){
+    button_idle_watch_enable(0);
+
+    calibration.step = BUTTON_CAL_RELEASE;
+    calibration.next = BTN_NONE;
+    calibration.reference = adc_get_filtered();
+    calibration.since_ms = (uint16_t)systick_ms();
+}
+
+ButtonCalibrationStep button_calibration_process(void){
+    uint16_t now_ms;
+    uint16_t level;
+
+    if (calibration.step == BUTTON_CAL_OFF ||
+        calibration.step == BUTTON_CAL_DONE ||
+        calibration.step == BUTTON_CAL_FAILED) {
+        return (ButtonCalibrationStep)calibration.step;
+    }
+
+    now_ms = (uint16_t)systick_ms();
+    level = adc_get_filtered();
+
+    if (level_distance(level, calibration.reference) > BUTTON_CAL_TOLERANCE) {
+        calibration.reference = level;
+        calibration.since_ms = now_ms;
+    } else if ((uint16_t)(now_ms - calibration.since_ms) >= BUTTON_CAL_SETTLE_MS) {
+        calibration_accept(calibration.reference);
+        calibration.since_ms = now_ms;
+    }
+
+    return (ButtonCalibrationStep)calibration.step;
+}
+
+//============= STATIC INTERNAL FUNCTION IMPLEMENTATIONS =======
+
+/**
+ * @brief Відстань між двома рівнями ADC
+ */
+static uint16_t level_distance(uint16_t a, uint16_t b){
+    return (a > b) ? (uint16_t)(a - b) : (uint16_t)(b - a);
+}
+
+/**
+ * @brief Обробка стабільного рівня на поточному кроці
+ *
+ * RELEASE: перший раз - запис рівня спокою (лише нижче
+ * найнижчої смуги: MODE може ще бути затиснута після входу
+ * в калібрування), далі - очікування повернення до нього.
+ * PRESS_*: рівень, віддалений від спокою, записується для
+ * кнопки з підказки.
+ *
+ * @param[in] level Стабільний рівень ADC
+ * @retval None
+ */
+static void calibration_accept(uint16_t level){
+    if (calibration.step != BUTTON_CAL_RELEASE) {
+        if (level_distance(level, calibration.levels[BTN_NONE]) >= BUTTON_CAL_MIN_GAP) {
+            calibration.levels[calibration.next] = level;
+            calibration.next++;
+            calibration.step = BUTTON_CAL_RELEASE;
+        }
+        return;
+    }
+
+    if (calibration.next == BTN_NONE) {
+        if (level <= button_idle_ceiling()) {
+            calibration.levels[BTN_NONE] = level;
+            calibration.next = BTN_MODE;
+            calibration.step = BUTTON_CAL_PRESS_MODE;
+        }
+        return;
+    }
+
+    if (level_distance(level, calibration.levels[BTN_NONE]) >= BUTTON_CAL_MIN_GAP / 2) {
+        return;
+    }
+
+    if (calibration.next > BTN_DOWN) {
+        calibration_finish();
+    } else {
+        calibration.step = (uint8_t)(BUTTON_CAL_PRESS_MODE + calibration.next - BTN_MODE);
+    }
+}
+
+/**
+ * @brief Розрахунок, збереження та застосування таблиці
+ *
+ * @retval None
+ */
+static void calibration_finish(void){
+    ButtonBands bands;
+
+    if (calibration_compute(&bands) && button_bands_save(&bands)) {
+        calibration.step = BUTTON_CAL_DONE;
+    } else {
+        calibration.step = BUTTON_CAL_FAILED;
+    }
+
+    button_idle_watch_enable(1);
+}
+
+/**
+ * @brief Межі смуг за записаними рівнями
+ *
+ * Смуга кнопки - від середини до сусіднього нижчого рівня
+ * до середини до сусіднього вищого (верхня кнопка - до кінця
+ * шкали).
+ *
+ * @param[out] bands Таблиця смуг
+ * @return 1 - таблиця валідна, 0 - рівні ближчі за
+ *         BUTTON_CAL_MIN_GAP або спокій не найнижчий
+ */
+static uint8_t calibration_compute(ButtonBands *bands){
+    uint8_t button;
+    uint8_t other;
+    uint16_t level;
+    uint16_t below;
+    uint16_t above;
+
+    for (button = BTN_MODE; button <= BTN_DOWN; ++button) {
+        level = calibration.levels[button];
+        below = calibration.levels[BTN_NONE];
+        above = BUTTON_CAL_ADC_MAX + 1;
+
+        if (level < below + BUTTON_CAL_MIN_GAP) {
+            return 0;
+        }
+
+        for (other = BTN_MODE; other <= BTN_DOWN; ++other) {
+            if (other == button) {
+                continue;
+            }
+            if (level_distance(level, calibration.levels[other]) < BUTTON_CAL_MIN_GAP) {
+                return 0;
+            }
+            if (calibration.levels[other] < level) {
+                if (calibration.levels[other] > below) {
+                    below = calibration.levels[other];
+                }
+            } else if (calibration.levels[other] < above) {
+                above = calibration.levels[other];
+            }
+        }
+
+        bands->low[button - BTN_MODE] = (uint16_t)((below + level) / 2 + 1);
+        bands->high[button - BTN_MODE] = (above > BUTTON_CAL_ADC_MAX) ?
+            BUTTON_CAL_ADC_MAX : (uint16_t)((level + above) / 2);
+    }
+
+    return 1;
+}
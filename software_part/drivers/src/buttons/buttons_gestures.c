@@ -0,0 +1,315 @@
+/**
+ * @file    buttons_gestures.c
+ * @brief   Розпізнавання жестів кнопок (клік, подвійний клік,
+ *          довге натискання, натискання при утриманій кнопці)
+ * @author  Olexandr Makedonskyi
+ *
+ * Жести виводяться з черги подій драйвера (фронти з часом
+ * підтвердження та автоповтори) таблицею переходів. Драбина
+ * бачить одну кнопку одночасно, тому достатньо одного трекера:
+ * кнопка, стан, час фронту та один дедлайн. Пам'ять стала - 15 байт
+ * у нульовій сторінці.
+ *
+ * Таймаути порівнюються з часом наступної події (або
+ * системним часом мінус час підтвердження фронту, якщо черга
+ * порожня): результат не залежить від того, як часто
+ * викликається get_button_gesture(), а жести видаються із
+ * затримкою не більше DEBOUNCE_DELAY_MS після дедлайну.
+ */
+
+//==================== INCLUDES ========================
+
+#include "buttons.h"
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Стан трекера жестів
+ */
+typedef enum {
+    GESTURE_IDLE = 0,       /**< Кнопку не натиснуто */
+    GESTURE_DOWN,           /**< Натиснута, чекаємо відпускання або порогу довгого натискання */
+    GESTURE_WAIT_SECOND,    /**< Відпущена, чекаємо друге натискання у вікні подвійного кліку */
+    GESTURE_QUIET,          /**< Жест уже видано - решта утримання ігнорується */
+    GESTURE_STATE_COUNT
+} GestureState;
+
+/**
+ * @brief Вхід таблиці переходів
+ */
+typedef enum {
+    GESTURE_IN_PRESS = 0,   /**< Натискання нової кнопки */
+    GESTURE_IN_PRESS_SAME,  /**< Повторне натискання кнопки трекера */
+    GESTURE_IN_RELEASE,     /**< Відпускання */
+    GESTURE_IN_CHORD,       /**< Перехід з утримуваної кнопки на іншу */
+    GESTURE_IN_TIMEOUT,     /**< Настав дедлайн стану */
+    GESTURE_IN_COUNT
+} GestureInput;
+
+/**
+ * @brief Перехід: наступний стан, жест (0 - немає) та
+ *        ознака повторної обробки входу в новому стані
+ */
+typedef struct {
+    uint8_t next;
+    uint8_t gesture;
+    uint8_t refeed;
+} GestureTransition;
+
+//============= STATIC INTERNAL VARIABLES ==============
+
+/**
+ * @brief Таблиця переходів [стан][вхід]
+ */
+static const GestureTransition gesture_table[GESTURE_STATE_COUNT][GESTURE_IN_COUNT] = {
+    /* GESTURE_IDLE */
+    {
+        { GESTURE_DOWN,  BUTTON_GESTURE_PRESS, 0 },         /* PRESS */
+        { GESTURE_DOWN,  BUTTON_GESTURE_PRESS, 0 },         /* PRESS_SAME */
+        { GESTURE_IDLE,  0,                    0 },         /* RELEASE */
+        { GESTURE_QUIET, BUTTON_GESTURE_CHORD, 0 },         /* CHORD */
+        { GESTURE_IDLE,  0,                    0 }          /* TIMEOUT */
+    },
+    /* GESTURE_DOWN */
+    {
+        { GESTURE_IDLE,        0,                         1 },  /* PRESS (втрачене відпускання) */
+        { GESTURE_IDLE,        0,                         1 },  /* PRESS_SAME */
+        { GESTURE_WAIT_SECOND, 0,                         0 },  /* RELEASE */
+        { GESTURE_QUIET,       BUTTON_GESTURE_CHORD,      0 },  /* CHORD */
+        { GESTURE_QUIET,       BUTTON_GESTURE_LONG_PRESS, 0 }   /* TIMEOUT */
+    },
+    /* GESTURE_WAIT_SECOND */
+    {
+        { GESTURE_IDLE,  BUTTON_GESTURE_CLICK,        1 },  /* PRESS */
+        { GESTURE_QUIET, BUTTON_GESTURE_DOUBLE_CLICK, 0 },  /* PRESS_SAME */
+        { GESTURE_IDLE,  BUTTON_GESTURE_CLICK,        0 },  /* RELEASE */
+        { GESTURE_IDLE,  BUTTON_GESTURE_CLICK,        1 },  /* CHORD */
+        { GESTURE_IDLE,  BUTTON_GESTURE_CLICK,        0 }   /* TIMEOUT */
+    },
+    /* GESTURE_QUIET */
+    {
+        { GESTURE_DOWN,  BUTTON_GESTURE_PRESS, 0 },         /* PRESS */
+        { GESTURE_DOWN,  BUTTON_GESTURE_PRESS, 0 },         /* PRESS_SAME */
+        { GESTURE_IDLE,  0,                    0 },         /* RELEASE */
+        { GESTURE_QUIET, BUTTON_GESTURE_CHORD, 0 },         /* CHORD */
+        { GESTURE_QUIET, 0,                    0 }          /* TIMEOUT */
+    }
+};
+
+/**
+ * @brief Трекер жестів (нульова сторінка, див. buttons.c)
+ */
+static TINY struct {
+    uint8_t     state;          /**< GestureState */
+    uint8_t     button;         /**< ButtonID, за якою стежить трекер */
+    uint8_t     timer_armed;    /**< Дедлайн стану активний */
+    uint8_t     has_pending;    /**< pending містить ще не оброблену подію */
+    uint16_t    deadline_ms;    /**< Дедлайн стану (молодші 16 біт системного часу) */
+    uint16_t    edge_ms;        /**< Час фронту, яким трекер увійшов у стан */
+    ButtonEvent pending;        /**< Подія, прочитана наперед */
+    const ButtonGesturePolicy *policy; /**< Пороги жестів (0 - довге натискання та подвійний клік вимкнені) */
+} gesture;
+
+//============= STATIC FUNCTION PROTOTYPES =============
+
+static uint8_t gesture_next_event(ButtonEvent *event);
+static uint8_t gesture_classify(ButtonEvent *event, uint8_t *held);
+static uint8_t gesture_apply(uint8_t input, uint8_t button, uint16_t time_ms,
+                             uint8_t param, ButtonGesture *out);
+static void gesture_enter(uint8_t state, uint16_t time_ms);
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+void button_set_gesture_policy(const ButtonGesturePolicy *policy){
+    gesture.policy = policy;
+}
+
+uint8_t get_button_gesture(ButtonGesture *out){
+    ButtonEvent event;
+    uint8_t input;
+    uint8_t held;
+    uint16_t now_ms;
+
+    while (1) {
+        if (!gesture.has_pending) {
+            gesture.has_pending = get_button_event(&gesture.pending);
+        }
+
+        /*
+         * Дедлайн, що настав раніше за наступну подію, обробляється
+         * першим. Без подій - з запасом на підтвердження фронту:
+         * подія з часом до дедлайну може ще бути в інтеграторі
+         */
+        if (gesture.timer_armed) {
+            now_ms = gesture.has_pending ? gesture.pending.time_ms :
+                (uint16_t)((uint16_t)systick_ms() - DEBOUNCE_DELAY_MS);
+            if ((int16_t)(now_ms - gesture.deadline_ms) >= 0 &&
+                gesture_apply(GESTURE_IN_TIMEOUT, gesture.button, gesture.deadline_ms, 0, out)) {
+                return 1;
+            }
+        }
+
+        if (!gesture_next_event(&event)) {
+            return 0;
+        }
+
+        if (event.repeat != 0) {
+            out->time_ms = event.time_ms;
+            out->edge_ms = event.time_ms;
+            out->type = BUTTON_GESTURE_REPEAT;
+            out->button = event.button;
+            out->param = event.repeat;
+            return 1;
+        }
+
+        held = BTN_NONE;
+        input = gesture_classify(&event, &held);
+        if (gesture_apply(input, event.button, event.time_ms, held, out)) {
+            return 1;
+        }
+    }
+}
+
+//============= STATIC INTERNAL FUNCTION IMPLEMENTATIONS =======
+
+/**
+ * @brief Наступна подія (з буфера наперед або з черги драйвера)
+ *
+ * @param[out] event Подія
+ * @return 1 - подію прочитано, 0 - черга порожня
+ */
+static uint8_t gesture_next_event(ButtonEvent *event){
+    if (gesture.has_pending) {
+        *event = gesture.pending;
+        gesture.has_pending = 0;
+        return 1;
+    }
+    return get_button_event(event);
+}
+
+/**
+ * @brief Вхід таблиці для події (не автоповтору)
+ *
+ * Перехід драбини з кнопки на кнопку без відпускання
+ * драйвер видає як відпускання та натискання з одним часом
+ * (однією обробкою ADC, тобто обидві події вже в черзі).
+ * Така пара зливається в CHORD: подія стає натисканням нової
+ * кнопки, утримана кнопка повертається через held.
+ *
+ * @param[in,out] event Подія
+ * @param[out]    held  Утримана кнопка для CHORD
+ * @return GestureInput
+ */
+static uint8_t gesture_classify(ButtonEvent *event, uint8_t *held){
+    ButtonEvent *next = &gesture.pending;
+
+    if (event->pressed) {
+        return (gesture.state != GESTURE_IDLE && event->button == gesture.button) ?
+            GESTURE_IN_PRESS_SAME : GESTURE_IN_PRESS;
+    }
+
+    if (!gesture.has_pending) {
+        gesture.has_pending = get_button_event(next);
+    }
+    if (gesture.has_pending && next->pressed && next->repeat == 0 &&
+        next->time_ms == event->time_ms && next->button != event->button) {
+        *held = event->button;
+        *event = *next;
+        gesture.has_pending = 0;
+        return GESTURE_IN_CHORD;
+    }
+
+    return GESTURE_IN_RELEASE;
+}
+
+/**
+ * @brief Перехід трекера за таблицею
+ *
+ * Жести PRESS/CHORD належать кнопці входу, решта - кнопці
+ * трекера. CLICK та LONG_PRESS вирішуються пізніше за фронт
+ * (таймаут або наступна подія), тому їх час фронту - час
+ * входу трекера в стан: відпускання або натискання. При
+ * refeed вхід-подія повертається в буфер наперед і
+ * обробляється вже в новому стані.
+ *
+ * @param[in]  input   GestureInput
+ * @param[in]  button  Кнопка входу
+ * @param[in]  time_ms Час входу
+ * @param[in]  param   Утримана кнопка для CHORD
+ * @param[out] out     Жест
+ * @return 1 - видано жест
+ */
+static uint8_t gesture_apply(uint8_t input, uint8_t button, uint16_t time_ms,
+                             uint8_t param, ButtonGesture *out){
+    const GestureTransition *transition = &gesture_table[gesture.state][input];
+
+    if (transition->gesture != 0) {
+        out->time_ms = time_ms;
+        out->edge_ms = time_ms;
+        out->type = transition->gesture;
+        out->button = gesture.button;
+        out->param = 0;
+        if (transition->gesture == BUTTON_GESTURE_PRESS ||
+            transition->gesture == BUTTON_GESTURE_CHORD) {
+            out->button = button;
+            out->param = param;
+        } else if (transition->gesture == BUTTON_GESTURE_CLICK ||
+                   transition->gesture == BUTTON_GESTURE_LONG_PRESS) {
+            out->edge_ms = gesture.edge_ms;
+        }
+    }
+
+    if (input != GESTURE_IN_TIMEOUT) {
+        gesture.edge_ms = time_ms;
+    }
+
+    if (transition->refeed) {
+        /* CHORD повертається як натискання: утримана кнопка вже відпущена для трекера */
+        gesture.pending.time_ms = time_ms;
+        gesture.pending.button = button;
+        gesture.pending.pressed = 1;
+        gesture.pending.repeat = 0;
+        gesture.has_pending = 1;
+    } else if (input != GESTURE_IN_TIMEOUT && input != GESTURE_IN_RELEASE) {
+        gesture.button = button;
+    }
+
+    gesture_enter(transition->next, time_ms);
+    return (uint8_t)(transition->gesture != 0);
+}
+
+/**
+ * @brief Вхід у стан та постановка його дедлайну
+ *
+ * DOWN - поріг довгого натискання (якщо ввімкнено),
+ * WAIT_SECOND - вікно подвійного кліку (0 - дедлайн одразу,
+ * клік видається без очікування).
+ *
+ * @param[in] state   GestureState
+ * @param[in] time_ms Час входу в стан
+ */
+static void gesture_enter(uint8_t state, uint16_t time_ms){
+    uint16_t timeout_ms = 0;
+    uint8_t index = (uint8_t)(gesture.button - BTN_MODE);
+
+    gesture.state = state;
+    gesture.timer_armed = 0;
+
+    if (index >= BUTTON_COUNT) {
+        return;
+    }
+
+    if (state == GESTURE_DOWN) {
+        if (gesture.policy != 0) {
+            timeout_ms = gesture.policy->long_press_ms[index];
+        }
+        gesture.timer_armed = (uint8_t)(timeout_ms != 0);
+    } else if (state == GESTURE_WAIT_SECOND) {
+        if (gesture.policy != 0) {
+            timeout_ms = gesture.policy->double_click_ms[index];
+        }
+        gesture.timer_armed = 1;
+    }
+
+    gesture.deadline_ms = (uint16_t)(time_ms + timeout_ms);
+}
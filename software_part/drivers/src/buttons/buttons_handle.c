@@ -1,98 +1,192 @@
 //==================== INCLUDES ========================
 
 #include "buttons.h"
+#include "profiler.h"
 
-//===================== DEFINES =======================
+//============= STATIC INTERNAL VARIABLES ==============
 
-#define DEBOUNCE_DELAY_MS       20
+/**
+ * @brief Останній підтверджений (стабільний) стан кнопки
+ * 
+ * Пише переривання ADC, читає основний цикл (однобайтне
+ * читання - атомарне).
+ */
+static volatile ButtonID last_stable_button = BTN_NONE;
 
-//============= STATIC INTERNAL VARIABLES ==============
+/**
+ * @brief Кандидат на новий стан та інтегратор його вибірок
+ */
+static ButtonID candidate_button = BTN_NONE;
+static uint8_t  debounce_integrator;
+
+/**
+ * @brief Час першої вибірки candidate_button (фронт на ADC)
+ */
+static uint16_t candidate_time_ms;
+
+/**
+ * @brief Автоповтор утриманої кнопки: момент наступного
+ *        повтору та кількість вже виданих
+ */
+static uint16_t repeat_due_ms;
+static uint8_t  repeat_count;
+
+/**
+ * @brief Черга подій кнопок (пише переривання ADC, читає бізнес-логіка)
+ */
+static ButtonEvent button_event_storage[BUTTON_EVENT_QUEUE_SIZE];
+static SpscQueue   button_events;
 
-static ButtonID debounce_button(ButtonID current_button_value);
-static ButtonID button_read(void);
+static void debounce_sample(uint16_t adc_value);
+static void debounce_button(ButtonID sample_button);
+static void button_auto_repeat(void);
+static void button_push_event(ButtonID button, uint8_t pressed, uint8_t repeat, uint16_t time_ms);
 
 //============ PUBLIC FUNCTION IMPLEMENTATIONS =========
 
 ButtonID get_button_value(void){
-    ButtonID button_value;
-    button_value = button_read();
-    return debounce_button(button_value);
+    return last_stable_button;
+}
+
+uint8_t get_button_event(ButtonEvent *event){
+    return spsc_queue_pop(&button_events, event);
+}
+
+void button_debounce_init(void){
+    spsc_queue_init(&button_events, button_event_storage, sizeof(ButtonEvent), BUTTON_EVENT_QUEUE_SIZE);
+    adc_set_sample_handler(debounce_sample);
 }
 
 //============= STATIC INTERNAL FUNCTION IMPLEMENTATIONS =======
 
 /**
- * @brief Зчитування стану кнопки через ADC
+ * @brief Обробка вибірки ADC (викликається з переривання EOC)
  * 
- * Виконує одне зчитування ADC та декодування аналогового
- * значення у відповідний ідентифікатор кнопки.
+ * Декодує усереднене значення ADC у кнопку, передає
+ * її інтегратору дебаунсу та перевіряє автоповтор.
+ * Коли кнопку відпущено і відскоків немає, ADC переходить
+ * в очікування: наступна вибірка надійде лише з натисканням.
  * 
- * @return Ідентифікатор зчитаної кнопки
- * @retval BTN_NONE Жодна кнопка не натиснута
- * @retval BTN_MODE Натиснута кнопка MODE
- * @retval BTN_UP   Натиснута кнопка UP
- * @retval BTN_DOWN Натиснута кнопка DOWN
- * 
- * @note Час виконання: ~100 мкс при 16 МГц
- * @note Функція НЕ виконує дебаунс
+ * @param[in] adc_value Усереднене значення ADC (0-1023)
+ * @retval None
  * 
  * @see button_decode()
  */
-static ButtonID button_read(void){
-    ButtonID current_button;
-    uint16_t adc_value;
-    adc_start_single_conversion();
-    adc_value = adc_read();
-    current_button = button_decode(adc_value);
-    return current_button;
+static void debounce_sample(uint16_t adc_value){
+    PROFILER_ENTER(PROFILER_ZONE_DEBOUNCE);
+    debounce_button(button_decode(adc_value));
+    button_auto_repeat();
+    if (last_stable_button == BTN_NONE && debounce_integrator == 0) {
+        button_idle_watch(adc_value);
+    }
+    PROFILER_EXIT(PROFILER_ZONE_DEBOUNCE);
 }
 
 /**
- * @brief Програмний дебаунс кнопки
+ * @brief Інтегруючий дебаунс кнопки (одна вибірка за виклик)
+ * 
+ * Вибірки, що збігаються з кандидатом на новий стан,
+ * збільшують інтегратор, вибірки стабільного стану - зменшують.
+ * Стан приймається, коли інтегратор досягає DEBOUNCE_SAMPLES:
+ * без дребезгу - через DEBOUNCE_DELAY_MS, кожен відскок
+ * відсуває підтвердження. Інший новий стан (проміжний рівень
+ * драбини) стає кандидатом з нуля.
  * 
- * Усуває помилкові спрацювання (bouncing) шляхом перевірки
- * стабільності стану кнопки. При зміні стану виконується
- * затримка та повторне зчитування для підтвердження.
+ * Прийнятий стан публікується подіями в черзі: відпускання
+ * попередньої кнопки, потім натискання нової. Час події -
+ * перша вибірка кандидата.
  * 
- * @param[in] current_button_value Поточне значення кнопки
- * @return Підтверджене значення кнопки
- * @retval BTN_NONE Жодна кнопка не натиснута стабільно
- * @retval BTN_MODE Кнопка MODE натиснута стабільно
- * @retval BTN_UP   Кнопка UP натиснута стабільно
- * @retval BTN_DOWN Кнопка DOWN натиснута стабільно
+ * @param[in] sample_button Кнопка, декодована з поточної вибірки
+ * @retval None
  * 
- * @note Використовує static змінну для збереження останнього
- *       стабільного стану між викликами
- * @note Час виконання: ~0 (якщо стан не змінився) або 
- *       ~20 мс (при зміні стану)
+ * @note Викликається з переривання ADC, не блокує
  * 
  * @see DEBOUNCE_DELAY_MS
- * @see button_read()
  */
-static ButtonID debounce_button(ButtonID current_button_value){
-    static ButtonID last_stable_button = BTN_NONE;  // static!
-    ButtonID confirmed_button;
+static void debounce_button(ButtonID sample_button){
+    ButtonID stable = last_stable_button;
     
-    // Якщо зміни відсутні - повертаємо те саме значення 
-    if (current_button_value == last_stable_button) {  // current_button_value
-        return current_button_value;  // current_button_value
+    if (sample_button == stable) {
+        // Відскок назад до стабільного стану
+        if (debounce_integrator != 0) {
+            debounce_integrator--;
+        }
+        return;
     }
     
-    // В разі зміни чекаємо, після чого підтверджуємо натискання кнопки
-    _delay_ms(DEBOUNCE_DELAY_MS);
+    if (sample_button != candidate_button || debounce_integrator == 0) {
+        candidate_button = sample_button;
+        candidate_time_ms = (uint16_t)systick_ms_isr();
+        debounce_integrator = 0;
+    }
     
-    // Підтверджуємо натискання
-    confirmed_button = button_read();
+    if (++debounce_integrator < DEBOUNCE_SAMPLES) {
+        return;
+    }
     
-    // Якщо стабільно - оновлюємо 
-    if (confirmed_button == current_button_value) {  // current_button_value
-        last_stable_button = confirmed_button;
-        return confirmed_button;
+    if (stable != BTN_NONE) {
+        button_push_event(stable, 0, 0, candidate_time_ms);
+    }
+    if (sample_button != BTN_NONE) {
+        button_push_event(sample_button, 1, 0, candidate_time_ms);
     }
+    last_stable_button = sample_button;
+    debounce_integrator = 0;
     
-    // Bouncing - повертаємо стабільне значення
-    return last_stable_button;
+    repeat_due_ms = (uint16_t)(candidate_time_ms + BUTTON_REPEAT_DELAY_MS);
+    repeat_count = 0;
 }
 
+/**
+ * @brief Автоповтор утримуваної кнопки
+ * 
+ * Коли настає repeat_due_ms, а кнопка досі утримується,
+ * публікує подію натискання з номером повтору та планує
+ * наступний через BUTTON_REPEAT_PERIOD_MS. Порівняння часу
+ * знакове, тому коректне при переповненні 16-бітного часу.
+ * 
+ * @retval None
+ * 
+ * @note Викликається з переривання ADC після debounce_button()
+ * @note Повтор при повній черзі відкидається, наступний
+ *       все одно буде через період
+ */
+static void button_auto_repeat(void){
+    uint16_t now_ms;
+    
+    if (last_stable_button == BTN_NONE) {
+        return;
+    }
+    
+    now_ms = (uint16_t)systick_ms_isr();
+    if ((int16_t)(now_ms - repeat_due_ms) < 0) {
+        return;
+    }
+    
+    if (repeat_count != 0xFF) {
+        repeat_count++;
+    }
+    button_push_event(last_stable_button, 1, repeat_count, now_ms);
+    repeat_due_ms = (uint16_t)(repeat_due_ms + BUTTON_REPEAT_PERIOD_MS);
+}
 
-
+/**
+ * @brief Запис події в чергу
+ * 
+ * @param[in] button  Кнопка
+ * @param[in] pressed 1 - натискання, 0 - відпускання
+ * @param[in] repeat  0 - фронт, інакше номер автоповтору
+ * @param[in] time_ms Час фронту або повтору
+ * @retval None
+ * 
+ * @note При повній черзі подія відкидається
+ */
+static void button_push_event(ButtonID button, uint8_t pressed, uint8_t repeat, uint16_t time_ms){
+    ButtonEvent event;
+    
+    event.time_ms = time_ms;
+    event.button = (uint8_t)button;
+    event.pressed = pressed;
+    event.repeat = repeat;
+    (void)spsc_queue_push(&button_events, &event);
+}
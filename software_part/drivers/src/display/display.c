@@ -40,6 +40,16 @@ void display_clear(void) {
     display_driver_write_text("    ");
 }
 
+
+void display_get_frame_stats(DisplayFrameStats *stats) {
+    display_driver_get_frame_stats(&stats->sent, &stats->skipped);
+}
+
+
+void display_reset_frame_stats(void) {
+    display_driver_reset_frame_stats();
+}
+
 //============= STATIC INTERNAL FUNCTION IMPLEMENTATIONS =======
 
 /**
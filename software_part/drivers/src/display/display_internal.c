@@ -7,11 +7,16 @@
  * Забезпечує абстракцію між високорівневим API
  * та низькорівневим HAL драйвером TM1637.
  * 
+ * Останній надісланий кадр та яскравість кешуються: кадр без
+ * змін не передається, інакше передається лише суцільний
+ * діапазон змінених розрядів. Після NACK кеш скидається -
+ * наступний кадр передається повністю.
  */
 
 //==================== INCLUDES ========================
 #include "display_internal.h"
 #include "tm1637.h"
+#include "profiler.h"
 #include <stdio.h>  // For sprintf
 
 //==================== DEFINES =========================
@@ -61,9 +66,26 @@ static const uint8_t segment_map_digits[10] = {
     0x6F   // 9: ABCDFG
 };
 
+/**
+ * @brief Кеш вмісту TM1637 та лічильники кадрів
+ * 
+ * Нульова сторінка (TINY): основна RAM майже вичерпана.
+ * Вміст TM1637 після ввімкнення невідомий - перший кадр
+ * і перша яскравість передаються завжди.
+ */
+static TINY struct {
+    uint8_t  segments[DISPLAY_DIGITS_COUNT];    /**< Останній прийнятий кадр */
+    uint8_t  frame_valid;       /**< segments відповідає дисплею */
+    uint8_t  brightness;        /**< Остання прийнята яскравість */
+    uint8_t  brightness_valid;  /**< brightness відповідає дисплею */
+    uint16_t sent;              /**< Передані кадри */
+    uint16_t skipped;           /**< Пропущені кадри (без змін) */
+} frame_cache;
+
 //=============== PRIVATE FUNCTION PROTOTYPES ==========
 
 static uint8_t char_to_segment(char c);
+static void display_send_frame(const uint8_t *segments);
 
 //============ PUBLIC FUNCTION IMPLEMENTATIONS =========
 
@@ -82,6 +104,8 @@ void display_driver_write_text(const char *text) {
     int len = 0;
     uint8_t segments[DISPLAY_DIGITS_COUNT];
     
+    PROFILER_ENTER(PROFILER_ZONE_DISPLAY_WRITE);
+    
     // 1. Визначення довжини рядка (з обмеженням)
     if (text) {
         while (text[len] != '\0' && len < MAX_STRING_LENGTH) {
@@ -113,8 +137,10 @@ void display_driver_write_text(const char *text) {
         segments[i] = seg;
     }
     
-    // 4. Відправка сегментів до HAL драйвера
-    tm1637_write_segments(segments);
+    // 4. Відправка змінених розрядів до HAL драйвера
+    display_send_frame(segments);
+    
+    PROFILER_EXIT(PROFILER_ZONE_DISPLAY_WRITE);
 }
 
 
@@ -126,11 +152,65 @@ void display_format_number(uint16_t number, char *buffer) {
 
 
 void display_driver_set_brightness(uint8_t brightness) {
-    tm1637_set_brightness(brightness);
+    if (frame_cache.brightness_valid && frame_cache.brightness == brightness) {
+        return;
+    }
+    
+    frame_cache.brightness = brightness;
+    frame_cache.brightness_valid = (uint8_t)(tm1637_set_brightness(brightness) == 0);
+}
+
+
+void display_driver_get_frame_stats(uint16_t *sent, uint16_t *skipped) {
+    *sent = frame_cache.sent;
+    *skipped = frame_cache.skipped;
+}
+
+
+void display_driver_reset_frame_stats(void) {
+    frame_cache.sent = 0;
+    frame_cache.skipped = 0;
 }
 
 //=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
 
+/**
+ * @brief Передача кадру з урахуванням кешу
+ * 
+ * Розряди, що збігаються з кешем по краях кадру, не
+ * передаються: на шину йде діапазон від першого до
+ * останнього зміненого розряду. Кадр без змін лише
+ * рахується як пропущений.
+ * 
+ * @param[in] segments Кадр (DISPLAY_DIGITS_COUNT розрядів)
+ * @retval None
+ */
+static void display_send_frame(const uint8_t *segments) {
+    uint8_t first = 0;
+    uint8_t last = DISPLAY_DIGITS_COUNT;
+    uint8_t i;
+    
+    if (frame_cache.frame_valid) {
+        while (first < DISPLAY_DIGITS_COUNT && segments[first] == frame_cache.segments[first]) {
+            ++first;
+        }
+        if (first == DISPLAY_DIGITS_COUNT) {
+            frame_cache.skipped++;
+            return;
+        }
+        while (segments[last - 1] == frame_cache.segments[last - 1]) {
+            --last;
+        }
+    }
+    
+    frame_cache.sent++;
+    frame_cache.frame_valid = (uint8_t)(tm1637_write_segments(first, &segments[first],
+                                                              (uint8_t)(last - first)) == 0);
+    for (i = 0; i < DISPLAY_DIGITS_COUNT; ++i) {
+        frame_cache.segments[i] = segments[i];
+    }
+}
+
 /**
  * @brief Конвертація символу у 7-сегментний код
  * 
@@ -165,10 +245,13 @@ static uint8_t char_to_segment(char c) {
         case 'A': case 'a': return 0x77;  // ABCEFG
         case 'b':           return 0x7C;  // CDEFG (нижній регістр)
         case 'C': case 'c': return 0x58;  // DEG (маленьке C)
+        case 'd':           return 0x5E;  // BCDEG (нижній регістр)
         case 'E': case 'e': return 0x79;  // ADEFG
         case 'F': case 'f': return 0x71;  // AEFG
         case 'H': case 'h': return 0x76;  // BCEFG
         case 'L':           return 0x38;  // DEF
+        case 'n':           return 0x54;  // CEG (нижній регістр)
+        case 'o':           return 0x5C;  // CDEG (нижній регістр)
         case 'P': case 'p': return 0x73;  // ABEFG
         case 'r':           return 0x50;  // EG (маленьке r)
         case 'U': case 'u': return 0x3E;  // BCDEF
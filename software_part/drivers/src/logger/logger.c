@@ -4,7 +4,20 @@
 
 #ifdef LOGGER_UART_ENABLE
     #include "uart1_tx.h"
+    #include "scheduler.h"
     #include <string.h>
+
+/**
+ * @brief Рядки чекають на місце в черзі передачі замість відкидання
+ * 
+ * Лише під час initialize_logger(): IWDG ще не запущено,
+ * звіт про запуск виводиться повністю.
+ */
+static uint8_t logger_wait_for_room;
+
+static uint8_t logger_take_room(uint8_t bytes);
+static uint8_t number_length(int32_t number);
+static void report_boot_record(void);
 #endif
 
 //============ PUBLIC FUNCTION IMPLEMENTATIONS =========
@@ -13,6 +26,9 @@ void initialize_logger(void) {
 #ifdef LOGGER_UART_ENABLE
     /* Ініціалізація UART1 TX для логування */
     uart1_tx_init(UART_CURRENT_SPEED, UART_SYSTEM_CLOCK);
+    logger_wait_for_room = 1;
+    report_boot_record();
+    logger_wait_for_room = 0;
 #else
     /* Logger disabled - do nothing */
 #endif
@@ -20,8 +36,8 @@ void initialize_logger(void) {
 
 void write_message_in_logger(const char* msg) {
 #ifdef LOGGER_UART_ENABLE
-    /* Send message only if logger enabled */
-    if (msg != NULL) {
+    /* Рядок з '\r\n' ставиться в чергу цілим або відкидається */
+    if (msg != NULL && logger_take_room((uint8_t)(strlen(msg) + 2))) {
         uart1_tx_string(msg);
         uart1_tx_string("\r\n");  /* Add newline for readability */
     }
@@ -32,9 +48,108 @@ void write_message_in_logger(const char* msg) {
 
 void write_number_in_logger(int32_t number) {
 #ifdef LOGGER_UART_ENABLE
-    uart1_tx_number(number);
-    uart1_tx_string("\r\n");
+    if (logger_take_room((uint8_t)(number_length(number) + 2))) {
+        uart1_tx_number(number);
+        uart1_tx_string("\r\n");
+    }
 #else
     (void)number;
 #endif
-}
\ No newline at end of file
+}
+
+uint8_t logger_ready(uint8_t bytes) {
+#ifdef LOGGER_UART_ENABLE
+    uint8_t free_bytes = uart1_tx_free();
+    
+    return (uint8_t)(free_bytes >= bytes || free_bytes == UART1_TX_QUEUE_SIZE);
+#else
+    (void)bytes;
+    return 1;
+#endif
+}
+
+#ifdef LOGGER_UART_ENABLE
+//============= STATIC INTERNAL FUNCTION IMPLEMENTATIONS =======
+
+/**
+ * @brief Перевірка місця під рядок у черзі передачі
+ * 
+ * Поза ініціалізацією не чекає: рядок, що не вміщується,
+ * відкидається цілим (без обірваних рядків у лозі).
+ * 
+ * @param[in] bytes Довжина рядка з '\r\n'
+ * @return 1 - рядок можна ставити в чергу, 0 - відкинути
+ */
+static uint8_t logger_take_room(uint8_t bytes) {
+    if (bytes > UART1_TX_QUEUE_SIZE) {
+        bytes = UART1_TX_QUEUE_SIZE;
+    }
+    
+    if (logger_wait_for_room) {
+        while (uart1_tx_free() < bytes) {
+            /* Busy wait: передача з переривання TXE */
+        }
+    }
+    
+    return (uint8_t)(uart1_tx_free() >= bytes);
+}
+
+/**
+ * @brief Кількість символів десяткового запису числа (зі знаком)
+ * 
+ * @param[in] number Число
+ * @return 1 - 11
+ */
+static uint8_t number_length(int32_t number) {
+    uint8_t length = 1;
+    
+    if (number < 0) {
+        length++;
+        number = -number;
+    }
+    
+    while (number > 9) {
+        number /= 10;
+        length++;
+    }
+    
+    return length;
+}
+
+/**
+ * @brief Звіт про причину запуску та перевищення дедлайнів
+ * 
+ * Дані з таблиці монітора планувальника, що пережила скидання:
+ * прапорці RST_SR, кількість скидань IWDG, задача-винуватець
+ * та для кожної задачі з перевищеннями - кількість і найбільше.
+ * 
+ * @param[in] None
+ * @retval None
+ * 
+ * @note Викликається з дозволеними перериваннями
+ */
+static void report_boot_record(void) {
+    SchedulerResetInfo reset;
+    SchedulerOverrunStats overrun;
+    uint8_t task;
+    
+    scheduler_get_reset_info(&reset);
+    write_message_in_logger("boot: reset flags, wdg resets, task, hung");
+    write_number_in_logger(reset.reset_flags);
+    write_number_in_logger(reset.watchdog_resets);
+    write_number_in_logger(reset.task);
+    write_number_in_logger(reset.hung);
+    
+    for (task = 0; task < SCHEDULER_MAX_TASKS; ++task) {
+        scheduler_get_overrun(task, &overrun);
+        if (overrun.count == 0) {
+            continue;
+        }
+        
+        write_message_in_logger("overrun: task, count, max ms");
+        write_number_in_logger(task);
+        write_number_in_logger(overrun.count);
+        write_number_in_logger(overrun.max_over_ms);
+    }
+}
+#endif
@@ -19,12 +19,22 @@
 #define UART_CR3_STOP_1BIT  0x00    /**< 1 stop bit */
 #define UART_CR3_STOP_2BIT  0x20    /**< 2 stop bits */
 
+//============= STATIC INTERNAL VARIABLES ==============
+
+/*
+ * Черга байтів на передачу: пише основний цикл, читає переривання TXE.
+ * Пам'ять черги - у нульовій сторінці (TINY): основна RAM майже вичерпана
+ */
+static TINY uint8_t tx_storage[UART1_TX_QUEUE_SIZE];
+static SpscQueue tx_queue;
+
 //============= STATIC INTERNAL FUNCTIONS PROTOTYPES ==============
 static void uart1_tx_byte(uint8_t data);
 //============== PUBLIC FUNCTION IMPLEMENTATIONS ==============
 
 void uart1_tx_init(uint32_t baud_rate, uint32_t f_master) {
     uint32_t brr;
+    spsc_queue_init(&tx_queue, tx_storage, 1, UART1_TX_QUEUE_SIZE);
     /* PD5: TX as output push-pull */
     GPIOD->DDR |= (1 << 5);     /* Output mode */
     GPIOD->CR1 |= (1 << 5);     /* Push-pull */
@@ -42,7 +52,7 @@ void uart1_tx_init(uint32_t baud_rate, uint32_t f_master) {
     UART1->BRR1 = (uint8_t)((brr >> 4) & 0xFF);
     /* CR1: 8-bit mode, no parity */
     UART1->CR1 = 0x00;  /* M=0 (8-bit), PCEN=0 (no parity) */
-    /* CR2: Enable transmitter only, disable all interrupts */
+    /* CR2: Enable transmitter only, TXE interrupt enabled on demand */
     UART1->CR2 = UART_CR2_TEN;  /* TEN=1, REN=0, interrupts=0 */
     /* CR3: 1 stop bit */
     UART1->CR3 = UART_CR3_STOP_1BIT;
@@ -50,6 +60,11 @@ void uart1_tx_init(uint32_t baud_rate, uint32_t f_master) {
 
 
 
+uint8_t uart1_tx_free(void) {
+    return (uint8_t)(UART1_TX_QUEUE_SIZE - spsc_queue_count(&tx_queue));
+}
+
+
 void uart1_tx_buffer(const uint8_t* data, uint16_t length) {
     uint16_t i;
     /* Validate parameters */
@@ -104,25 +119,39 @@ void uart1_tx_number(int32_t number) {
     }
 }
 
+INTERRUPT_HANDLER(uart1_tx_irq_handler, UART1_TX_IRQ_NUMBER) {
+    uint8_t data;
+    
+    if (spsc_queue_pop(&tx_queue, &data)) {
+        /* Writing DR clears TXE */
+        UART1->DR = data;
+    } else {
+        /* Queue drained - stop TXE requests until the next byte */
+        UART1->CR2 &= (uint8_t)~UART_CR2_TIEN;
+    }
+}
+
 //============= STATIC INTERNAL FUNCTION IMPLEMENTATIONS =======
 /**
- * @brief Відправка одного байта по UART
+ * @brief Постановка одного байта в чергу передачі
  * 
- * Блокуюча функція - чекає завершення передачі попереднього байта.
+ * Байт передається з переривання TXE. Функція не чекає:
+ * при повній черзі байт відкидається.
  * 
  * @param[in] data Байт для передачі
  * @retval    None
- * @note Функція чекає на готовність передавача (TXE flag)
+ * @note Дозвіл TIEN після запису в чергу: якщо переривання
+ *       саме вимкнуло TIEN на порожній черзі, воно буде
+ *       викликане знову і забере новий байт
  * 
+ * @see uart1_tx_free()
  * @see uart1_tx_string()
  * @see uart1_tx_buffer()
  */
 static void uart1_tx_byte(uint8_t data) {
-    /* Wait until Transmit Data Register is Empty */
-    while (!(UART1->SR & UART_SR_TXE)) {
-        /* Busy wait */
+    if (!spsc_queue_push(&tx_queue, &data)) {
+        return;
     }
     
-    /* Write data to Data Register */
-    UART1->DR = data;
+    UART1->CR2 |= UART_CR2_TIEN;
 }
\ No newline at end of file
@@ -0,0 +1,375 @@
+/**
+ * @file    scheduler.c
+ * @brief   Реалізація кооперативного планувальника задач
+ * @author  Olexandr Makedonskyi
+ *
+ * Особливості реалізації:
+ * - Таблиця задач у flash, у RAM лише стан черги та статистика
+ * - Час запуску 16-бітний, порівняння через знакову різницю
+ * - Час виконання вимірюється системним таймером (4 мкс)
+ * - Простій - час у режимі WAIT між задачами
+ * - Таблиця монітора дедлайнів - у секції .noinit (не очищується
+ *   стартовим кодом). build.bat ставить секцію на 0xD8-0xFF з
+ *   обмеженням 0x28 байт: 8 + 4 * SCHEDULER_MAX_TASKS <= 40
+ */
+
+//==================== INCLUDES ========================
+
+#include "scheduler.h"
+#include "systick.h"
+#include "watchdog.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Поріг вікна обліку навантаження, після якого лічильники діляться навпіл
+ */
+#define SCHEDULER_LOAD_LIMIT_US 0x80000000UL
+
+/**
+ * @brief Ознака валідної таблиці монітора в RAM без ініціалізації
+ */
+#define SCHEDULER_MONITOR_MAGIC 0x5AC3U
+
+//================ PRIVATE VARIABLES ===================
+
+/**
+ * @brief Стан задачі
+ */
+typedef struct {
+    uint16_t due_ms;            /**< Час наступного запуску (молодші 16 біт) */
+    uint16_t wcet_us;           /**< Найдовший час виконання */
+    uint32_t runs;              /**< Кількість запусків */
+} SchedulerTaskState;
+
+static const SchedulerTask *scheduler_tasks;
+static uint8_t             scheduler_task_count;
+
+/**
+ * @brief Маска задач у черзі (біт = номер задачі)
+ */
+static uint8_t             scheduler_armed;
+
+static SchedulerTaskState  scheduler_states[SCHEDULER_MAX_TASKS];
+
+/**
+ * @brief Початок вікна обліку навантаження та накопичений простій
+ */
+static uint32_t            load_start_us;
+static uint32_t            load_idle_us;
+
+/**
+ * @brief Сумарний простій з запуску (по колу)
+ */
+static uint32_t            idle_total_us;
+
+/**
+ * @brief Таблиця монітора дедлайнів (переживає скидання)
+ */
+typedef struct {
+    uint16_t magic;             /**< SCHEDULER_MONITOR_MAGIC - таблиця валідна */
+    uint8_t  running_task;      /**< Задача, що виконується зараз */
+    uint8_t  stalled_task;      /**< Задача, через яку IWDG не оновлено */
+    SchedulerResetInfo    reset;
+    SchedulerOverrunStats overruns[SCHEDULER_MAX_TASKS];
+} SchedulerMonitorRecord;
+
+#pragma section [noinit]
+static SchedulerMonitorRecord monitor_record;
+#pragma section []
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static uint8_t scheduler_check_deadline(uint8_t task_id, uint16_t due_ms);
+static void scheduler_service_watchdog(uint8_t deadlines_met);
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void scheduler_init(const SchedulerTask *tasks, uint8_t count) {
+    uint16_t now = (uint16_t)systick_ms();
+    uint8_t i;
+
+    if (count > SCHEDULER_MAX_TASKS) {
+        count = SCHEDULER_MAX_TASKS;
+    }
+
+    scheduler_tasks = tasks;
+    scheduler_task_count = count;
+    scheduler_armed = 0;
+
+    for (i = 0; i < count; ++i) {
+        scheduler_states[i].due_ms = now;
+        scheduler_states[i].wcet_us = 0;
+        scheduler_states[i].runs = 0;
+
+        if (tasks[i].period_ms != 0) {
+            scheduler_armed |= (uint8_t)(1 << i);
+        }
+    }
+
+    scheduler_reset_load();
+    watchdog_init();
+}
+
+
+void scheduler_run_after(uint8_t task_id, uint16_t delay_ms) {
+    if (task_id >= scheduler_task_count) {
+        return;
+    }
+
+    if (delay_ms > SCHEDULER_MAX_DELAY_MS) {
+        delay_ms = SCHEDULER_MAX_DELAY_MS;
+    }
+
+    scheduler_states[task_id].due_ms = (uint16_t)systick_ms() + delay_ms;
+    scheduler_armed |= (uint8_t)(1 << task_id);
+}
+
+
+void scheduler_cancel(uint8_t task_id) {
+    scheduler_armed &= (uint8_t)~(1 << task_id);
+}
+
+
+uint8_t scheduler_dispatch(void) {
+    SchedulerTaskState *state;
+    uint16_t period;
+    uint16_t now;
+    uint16_t due;
+    uint32_t start_us;
+    uint32_t elapsed_us;
+    uint8_t executed = 0;
+    uint8_t deadlines_met = 1;
+    uint8_t i;
+
+    for (i = 0; i < scheduler_task_count; ++i) {
+        if (!(scheduler_armed & (1 << i))) {
+            continue;
+        }
+
+        state = &scheduler_states[i];
+        now = (uint16_t)systick_ms();
+        if ((int16_t)(now - state->due_ms) < 0) {
+            continue;
+        }
+
+        // Наступний запуск плануємо до виклику задачі,
+        // щоб задача могла сама перепланувати себе
+        due = state->due_ms;
+        period = scheduler_tasks[i].period_ms;
+        if (period == 0) {
+            scheduler_armed &= (uint8_t)~(1 << i);
+        } else if ((int16_t)(now - state->due_ms) >= (int16_t)period) {
+            // Пропущено більше періоду - без серії наздоганяючих запусків
+            state->due_ms = now + period;
+        } else {
+            state->due_ms += period;
+        }
+
+        // Номер задачі в .noinit: при зависанні переживе скидання IWDG
+        monitor_record.running_task = i;
+        start_us = systick_us();
+        scheduler_tasks[i].run();
+        elapsed_us = systick_us() - start_us;
+        monitor_record.running_task = SCHEDULER_NO_TASK;
+        
+        deadlines_met &= scheduler_check_deadline(i, due);
+
+        if (elapsed_us > 0xFFFF) {
+            elapsed_us = 0xFFFF;
+        }
+        if ((uint16_t)elapsed_us > state->wcet_us) {
+            state->wcet_us = (uint16_t)elapsed_us;
+        }
+        state->runs++;
+        executed++;
+    }
+
+    scheduler_service_watchdog(deadlines_met);
+    return executed;
+}
+
+
+void scheduler_idle(void) {
+    uint32_t start_us = systick_us();
+    uint32_t elapsed_us;
+    uint32_t slept_us;
+
+    systick_idle_wait();
+    slept_us = systick_us() - start_us;
+    load_idle_us += slept_us;
+    idle_total_us += slept_us;
+
+    // Довге вікно без скидання - співвідношення зберігається
+    elapsed_us = systick_us() - load_start_us;
+    if (elapsed_us >= SCHEDULER_LOAD_LIMIT_US) {
+        load_start_us += elapsed_us >> 1;
+        load_idle_us >>= 1;
+    }
+}
+
+
+void scheduler_get_load(SchedulerLoadStats *stats) {
+    uint32_t elapsed_us = systick_us() - load_start_us;
+    uint32_t busy_us;
+
+    stats->elapsed_ms = elapsed_us / 1000;
+    stats->idle_ms = load_idle_us / 1000;
+
+    if (elapsed_us < 100 || load_idle_us >= elapsed_us) {
+        stats->load_percent = 0;
+    } else {
+        busy_us = elapsed_us - load_idle_us;
+        stats->load_percent = (uint8_t)(busy_us / (elapsed_us / 100));
+        if (stats->load_percent > 100) {
+            stats->load_percent = 100;
+        }
+    }
+}
+
+
+void scheduler_reset_load(void) {
+    load_start_us = systick_us();
+    load_idle_us = 0;
+}
+
+
+uint32_t scheduler_idle_us(void) {
+    return idle_total_us;
+}
+
+
+void scheduler_get_stats(uint8_t task_id, SchedulerTaskStats *stats) {
+    if (task_id >= scheduler_task_count) {
+        stats->runs = 0;
+        stats->wcet_us = 0;
+        return;
+    }
+
+    stats->runs = scheduler_states[task_id].runs;
+    stats->wcet_us = scheduler_states[task_id].wcet_us;
+}
+
+
+uint32_t scheduler_time_ms(void) {
+    return systick_ms();
+}
+
+
+void scheduler_monitor_boot(void) {
+    uint8_t flags = watchdog_take_reset_flags();
+    uint8_t i;
+
+    // Вмикання живлення (випадковий вміст) або нова прошивка
+    if (monitor_record.magic != SCHEDULER_MONITOR_MAGIC || (flags & WATCHDOG_RESET_SWIM)) {
+        monitor_record.magic = SCHEDULER_MONITOR_MAGIC;
+        monitor_record.running_task = SCHEDULER_NO_TASK;
+        monitor_record.stalled_task = SCHEDULER_NO_TASK;
+        monitor_record.reset.watchdog_resets = 0;
+        monitor_record.reset.task = SCHEDULER_NO_TASK;
+        monitor_record.reset.hung = 0;
+
+        for (i = 0; i < SCHEDULER_MAX_TASKS; ++i) {
+            monitor_record.overruns[i].count = 0;
+            monitor_record.overruns[i].max_over_ms = 0;
+        }
+    }
+
+    monitor_record.reset.reset_flags = flags;
+
+    if (flags & WATCHDOG_RESET_IWDG) {
+        if (monitor_record.reset.watchdog_resets != 0xFF) {
+            monitor_record.reset.watchdog_resets++;
+        }
+
+        // Зависання всередині задачі або постійні перевищення
+        monitor_record.reset.hung = (monitor_record.running_task != SCHEDULER_NO_TASK);
+        monitor_record.reset.task = monitor_record.reset.hung ? monitor_record.running_task
+                                                              : monitor_record.stalled_task;
+    }
+
+    monitor_record.running_task = SCHEDULER_NO_TASK;
+    monitor_record.stalled_task = SCHEDULER_NO_TASK;
+}
+
+
+void scheduler_get_overrun(uint8_t task_id, SchedulerOverrunStats *stats) {
+    if (task_id >= SCHEDULER_MAX_TASKS) {
+        stats->count = 0;
+        stats->max_over_ms = 0;
+        return;
+    }
+
+    *stats = monitor_record.overruns[task_id];
+}
+
+
+void scheduler_get_reset_info(SchedulerResetInfo *info) {
+    *info = monitor_record.reset;
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Перевірка дедлайну завершеної задачі
+ *
+ * @param[in] task_id Номер задачі
+ * @param[in] due_ms  Запланований час запуску
+ *
+ * @return 1 - задача встигла (або без контролю), 0 - перевищення
+ */
+static uint8_t scheduler_check_deadline(uint8_t task_id, uint16_t due_ms) {
+    SchedulerOverrunStats *overrun;
+    uint16_t deadline = scheduler_tasks[task_id].deadline_ms;
+    uint16_t late_ms = (uint16_t)systick_ms() - due_ms;
+
+    if (deadline == 0 || late_ms <= deadline) {
+        return 1;
+    }
+
+    overrun = &monitor_record.overruns[task_id];
+    if (overrun->count != 0xFFFF) {
+        overrun->count++;
+    }
+    if ((uint16_t)(late_ms - deadline) > overrun->max_over_ms) {
+        overrun->max_over_ms = late_ms - deadline;
+    }
+
+    monitor_record.stalled_task = task_id;
+    return 0;
+}
+
+/**
+ * @brief Оновлення IWDG, якщо всі задачі відмітились вчасно
+ *
+ * Крім задач, виконаних у цьому виклику, перевіряються задачі
+ * в черзі: прострочена задача, яка не отримує CPU, теж
+ * блокує оновлення.
+ *
+ * @param[in] deadlines_met 1 - виконані задачі встигли
+ */
+static void scheduler_service_watchdog(uint8_t deadlines_met) {
+    uint16_t now = (uint16_t)systick_ms();
+    uint16_t deadline;
+    uint8_t i;
+
+    if (!deadlines_met) {
+        return;
+    }
+
+    for (i = 0; i < scheduler_task_count; ++i) {
+        deadline = scheduler_tasks[i].deadline_ms;
+        if (deadline == 0 || !(scheduler_armed & (1 << i))) {
+            continue;
+        }
+
+        if ((int16_t)(now - scheduler_states[i].due_ms) > (int16_t)deadline) {
+            monitor_record.stalled_task = i;
+            return;
+        }
+    }
+
+    monitor_record.stalled_task = SCHEDULER_NO_TASK;
+    watchdog_refresh();
+}
@@ -0,0 +1,171 @@
+/**
+ * @file    soft_timer.c
+ * @brief   Реалізація програмних таймерів (timer wheel)
+ * @author  Olexandr Makedonskyi
+ *
+ * Кожна комірка колеса - однозв'язний список таймерів
+ * (індекси пулу). Вільні таймери зв'язані в окремий список.
+ *
+ * Обробка тіку: список комірки від'єднується цілком, таймери
+ * з rounds = 0 спрацьовують, решта повертаються в комірку
+ * з rounds - 1. Таймери, запущені з callback, потрапляють
+ * у нові списки та не обробляються повторно в тому ж тіку.
+ */
+
+//==================== INCLUDES ========================
+
+#include "soft_timer.h"
+#include "systick.h"
+
+//==================== DEFINES =========================
+
+#define SOFT_TIMER_WHEEL_MASK   (SOFT_TIMER_WHEEL_SIZE - 1)
+
+//================ PRIVATE VARIABLES ===================
+
+/**
+ * @brief Таймер пулу
+ */
+typedef struct {
+    SoftTimerCallback callback; /**< NULL - таймер скасований */
+    uint8_t rounds;             /**< Повних обертів колеса до спрацювання */
+    uint8_t next;               /**< Наступний таймер у списку (SOFT_TIMER_NONE - кінець) */
+} SoftTimerSlot;
+
+static SoftTimerSlot timer_slots[SOFT_TIMER_SLOTS];
+
+/**
+ * @brief Голови списків комірок колеса
+ */
+static uint8_t timer_wheel[SOFT_TIMER_WHEEL_SIZE];
+
+/**
+ * @brief Голова списку вільних таймерів
+ */
+static uint8_t timer_free;
+
+/**
+ * @brief Останній оброблений тік (молодші 16 біт systick_ms)
+ */
+static uint16_t timer_tick;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static void soft_timer_release(uint8_t timer_id);
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void soft_timer_init(void) {
+    uint8_t i;
+
+    for (i = 0; i < SOFT_TIMER_WHEEL_SIZE; ++i) {
+        timer_wheel[i] = SOFT_TIMER_NONE;
+    }
+
+    timer_free = SOFT_TIMER_NONE;
+    for (i = 0; i < SOFT_TIMER_SLOTS; ++i) {
+        soft_timer_release(i);
+    }
+
+    timer_tick = (uint16_t)systick_ms();
+}
+
+
+uint8_t soft_timer_start(SoftTimerCallback callback, uint16_t delay_ms) {
+    SoftTimerSlot *slot;
+    uint16_t target;
+    uint16_t offset;
+    uint8_t timer_id = timer_free;
+    uint8_t bucket;
+
+    if (timer_id == SOFT_TIMER_NONE) {
+        return SOFT_TIMER_NONE;
+    }
+
+    if (delay_ms == 0) {
+        delay_ms = 1;
+    } else if (delay_ms > SOFT_TIMER_MAX_DELAY_MS) {
+        delay_ms = SOFT_TIMER_MAX_DELAY_MS;
+    }
+
+    // Відлік від поточного часу; колесо може відставати від
+    // нього на час виконання задач
+    target = (uint16_t)systick_ms() + delay_ms;
+    offset = target - timer_tick;
+    bucket = (uint8_t)(target & SOFT_TIMER_WHEEL_MASK);
+
+    slot = &timer_slots[timer_id];
+    timer_free = slot->next;
+
+    slot->callback = callback;
+    slot->rounds = (uint8_t)((offset - 1) / SOFT_TIMER_WHEEL_SIZE);
+    slot->next = timer_wheel[bucket];
+    timer_wheel[bucket] = timer_id;
+
+    return timer_id;
+}
+
+
+void soft_timer_cancel(uint8_t timer_id) {
+    if (timer_id < SOFT_TIMER_SLOTS) {
+        timer_slots[timer_id].callback = 0;
+    }
+}
+
+
+uint8_t soft_timer_process(void) {
+    uint16_t now = (uint16_t)systick_ms();
+    SoftTimerCallback callback;
+    SoftTimerSlot *slot;
+    uint8_t timer_id;
+    uint8_t next;
+    uint8_t bucket;
+    uint8_t fired = 0;
+
+    while (timer_tick != now) {
+        timer_tick++;
+        bucket = (uint8_t)(timer_tick & SOFT_TIMER_WHEEL_MASK);
+
+        // Список комірки від'єднується: callback можуть додавати таймери
+        timer_id = timer_wheel[bucket];
+        timer_wheel[bucket] = SOFT_TIMER_NONE;
+
+        while (timer_id != SOFT_TIMER_NONE) {
+            slot = &timer_slots[timer_id];
+            next = slot->next;
+
+            if (slot->callback != 0 && slot->rounds != 0) {
+                // Ще не час - наступний оберт колеса
+                slot->rounds--;
+                slot->next = timer_wheel[bucket];
+                timer_wheel[bucket] = timer_id;
+            } else {
+                callback = slot->callback;
+                soft_timer_release(timer_id);
+
+                if (callback != 0) {
+                    callback();
+                    fired++;
+                }
+            }
+
+            timer_id = next;
+        }
+    }
+
+    return fired;
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Повернення таймера в список вільних
+ *
+ * @param[in] timer_id Ідентифікатор таймера
+ */
+static void soft_timer_release(uint8_t timer_id) {
+    timer_slots[timer_id].callback = 0;
+    timer_slots[timer_id].next = timer_free;
+    timer_free = timer_id;
+}
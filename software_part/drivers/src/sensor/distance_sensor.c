@@ -12,25 +12,156 @@
 //==================== INCLUDES ========================
 
 #include "sensor_internal.h"
+#include "sensor_filter.h"
+#include "sensor_tracker.h"
+#include "sensor_rate.h"
+#include "scheduler.h"
+#include "profiler.h"
+
+//================ PRIVATE VARIABLES ===================
+
+/**
+ * @brief Період планувальника вимірювань, мкс
+ */
+static uint16_t ranging_period_us;
+
+/**
+ * @brief Таблиця останніх вимірювань кожного датчика
+ */
+static DistanceResult sensor_samples[DISTANCE_SENSOR_COUNT];
+
+/**
+ * @brief Маска датчиків, для яких таблиця вже містить вимірювання
+ */
+static uint8_t sensor_samples_valid;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static void distance_sensor_restart(uint16_t period_us, const DistanceRatePolicy *policy);
+static void distance_sensor_apply_rate(void);
 
 //============ PUBLIC FUNCTION IMPLEMENTATIONS =========
 
 
 void initialize_distance_sensor(void){
     sensor_initialize();
+    sensor_filter_reset();
+    sensor_tracker_reset();
+    sensor_samples_valid = 0;
 }
 
 
-uint16_t distance_sensor_measure_raw(void){
-    return sensor_measure_pulse(DISTANCE_SENSOR_TIMEOUT_US);
+void distance_sensor_start_ranging(uint16_t period_us){
+    distance_sensor_restart(period_us, 0);
 }
 
 
-uint16_t distance_sensor_convert_to_cm(uint16_t raw_time){
-    return sensor_convert_to_cm(raw_time);
+void distance_sensor_set_rate_policy(const DistanceRatePolicy *policy){
+    distance_sensor_restart(policy->period_us, policy);
 }
 
 
-uint16_t distance_sensor_convert_to_inch(uint16_t raw_time){
-    return sensor_convert_to_inch(raw_time);
-}
\ No newline at end of file
+DistanceRateMode distance_sensor_get_rate_mode(void){
+    return sensor_rate_mode();
+}
+
+
+void distance_sensor_get_rate_stats(DistanceRateMode mode, DistanceRateStats *stats){
+    sensor_rate_get_stats(mode, stats);
+}
+
+
+uint8_t distance_sensor_read(DistanceResult *result){
+    uint8_t ready = sensor_read_sample(result);
+    
+    // Облік часу та простою CPU для статистики частоти
+    sensor_rate_account(sensor_time_us(), scheduler_idle_us());
+    if (!ready) {
+        return 0;
+    }
+    
+    // Лише валідні вимірювання проходять через фільтр викидів
+    if (result->status == DISTANCE_STATUS_OK) {
+        PROFILER_ENTER(PROFILER_ZONE_FILTER);
+        result->ticks = sensor_filter_update(result->sensor, result->ticks);
+        PROFILER_EXIT(PROFILER_ZONE_FILTER);
+    }
+    
+    // Адаптація частоти за активністю сцени (невалідне = 0)
+    if (sensor_rate_update(result->sensor,
+                           (result->status == DISTANCE_STATUS_OK) ? result->ticks : 0)) {
+        distance_sensor_apply_rate();
+    }
+    
+    sensor_samples[result->sensor] = *result;
+    sensor_samples_valid |= (uint8_t)(1 << result->sensor);
+    return 1;
+}
+
+
+uint8_t distance_sensor_get_sample(uint8_t sensor, DistanceResult *result){
+    if (sensor >= DISTANCE_SENSOR_COUNT ||
+        !(sensor_samples_valid & (1 << sensor))) {
+        return 0;
+    }
+    
+    *result = sensor_samples[sensor];
+    return 1;
+}
+
+
+uint16_t distance_sensor_convert_to_mm(uint16_t ticks){
+    return sensor_convert_to_mm(ticks);
+}
+
+
+uint16_t distance_sensor_mm_to_cm(uint16_t distance_mm){
+    return sensor_mm_to_cm(distance_mm);
+}
+
+
+uint16_t distance_sensor_mm_to_inch(uint16_t distance_mm){
+    return sensor_mm_to_inch(distance_mm);
+}
+
+
+uint8_t distance_sensor_track(uint8_t sensor, uint16_t distance_mm, DistanceTrack *track){
+    return sensor_tracker_update(sensor, distance_mm, track);
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Перезапуск планувальника вимірювань
+ * 
+ * @param[in] period_us Період в мікросекундах
+ *                      (менші за мінімум значення обмежуються)
+ * @param[in] policy    Політика частоти (NULL - фіксована частота)
+ */
+static void distance_sensor_restart(uint16_t period_us, const DistanceRatePolicy *policy){
+    // Період не може бути коротшим за дедлайн ECHO + час відновлення датчика
+    if (period_us < DISTANCE_SENSOR_MIN_PERIOD_US) {
+        period_us = DISTANCE_SENSOR_MIN_PERIOD_US;
+    }
+    ranging_period_us = period_us;
+    
+    sensor_start_ranging(period_us, DISTANCE_SENSOR_TIMEOUT_US);
+    sensor_rate_configure(policy, sensor_time_us(), scheduler_idle_us());
+    distance_sensor_apply_rate();
+}
+
+/**
+ * @brief Застосування дільника тригерів поточного режиму частоти
+ * 
+ * Дільник передається планувальнику та трекеру, щоб
+ * швидкість рахувалась для фактичного періоду вимірювань.
+ * Датчики вимірюють по черзі, тому кожен датчик вимірює
+ * раз на divider * DISTANCE_SENSOR_COUNT періодів.
+ */
+static void distance_sensor_apply_rate(void){
+    uint8_t divider = sensor_rate_divider();
+    
+    sensor_set_trigger_divider(divider);
+    sensor_tracker_set_period(ranging_period_us,
+                              (uint16_t)divider * DISTANCE_SENSOR_COUNT);
+}
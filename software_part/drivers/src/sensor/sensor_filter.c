@@ -0,0 +1,140 @@
+/**
+ * @file    sensor_filter.c
+ * @brief   Реалізація фільтра вимірювань датчика відстані
+ * @author  Olexandr Makedonskyi
+ *
+ * Модуль реалізує ковзне вікно останніх SENSOR_FILTER_WINDOW
+ * вимірювань з медіанним фільтром або усіченим середнім.
+ * Кожен датчик має власне вікно.
+ *
+ * Особливості реалізації:
+ * - Статичні буфери (без heap)
+ * - Відсортована копія вікна оновлюється інкрементально:
+ *   одне видалення + одна вставка, кожна не більше N зсувів
+ * - Немає повного сортування на кожне вимірювання
+ */
+
+//==================== INCLUDES ========================
+
+#include "sensor_filter.h"
+
+//================ PRIVATE VARIABLES ===================
+
+/**
+ * @brief Кільцевий буфер вимірювань у хронологічному порядку
+ */
+static uint16_t window_samples[DISTANCE_SENSOR_COUNT][SENSOR_FILTER_WINDOW];
+
+/**
+ * @brief Ті самі вимірювання, відсортовані за зростанням
+ */
+static uint16_t sorted_samples[DISTANCE_SENSOR_COUNT][SENSOR_FILTER_WINDOW];
+
+/**
+ * @brief Позиція наступного запису (найстаріше значення при заповненому вікні)
+ */
+static uint8_t window_index[DISTANCE_SENSOR_COUNT];
+
+/**
+ * @brief Кількість значень у вікні (0..SENSOR_FILTER_WINDOW)
+ */
+static uint8_t window_count[DISTANCE_SENSOR_COUNT];
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static uint16_t sensor_filter_output(const uint16_t *sorted, uint8_t count);
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void sensor_filter_reset(void){
+    uint8_t sensor;
+    
+    for (sensor = 0; sensor < DISTANCE_SENSOR_COUNT; ++sensor) {
+        window_index[sensor] = 0;
+        window_count[sensor] = 0;
+    }
+}
+
+
+uint16_t sensor_filter_update(uint8_t sensor, uint16_t time_us){
+    uint8_t i;
+    uint8_t count = window_count[sensor];
+    uint8_t index = window_index[sensor];
+    uint16_t *window = window_samples[sensor];
+    uint16_t *sorted = sorted_samples[sensor];
+    uint16_t oldest;
+
+    // 1. Вікно заповнене - видалення найстарішого значення з відсортованої копії
+    if (count == SENSOR_FILTER_WINDOW) {
+        oldest = window[index];
+
+        // Значення гарантовано присутнє у відсортованій копії
+        i = 0;
+        while (sorted[i] != oldest) {
+            ++i;
+        }
+
+        // Зсув хвоста вліво на місце видаленого
+        for (; i < (uint8_t)(count - 1); ++i) {
+            sorted[i] = sorted[i + 1];
+        }
+        --count;
+    }
+
+    // 2. Вставка нового значення (insertion step): більші зсуваються вправо
+    i = count;
+    while (i > 0 && sorted[i - 1] > time_us) {
+        sorted[i] = sorted[i - 1];
+        --i;
+    }
+    sorted[i] = time_us;
+    ++count;
+
+    // 3. Запис у кільцевий буфер на місце найстарішого
+    window[index] = time_us;
+    if (++index >= SENSOR_FILTER_WINDOW) {
+        index = 0;
+    }
+    window_index[sensor] = index;
+    window_count[sensor] = count;
+
+    return sensor_filter_output(sorted, count);
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Обчислення результату фільтра з відсортованої копії
+ *
+ * Медіана: центральний елемент (для парної кількості - верхній).
+ * Усічене середнє: середнє без SENSOR_FILTER_TRIM крайніх
+ * значень з кожного боку, округлене до найближчого цілого.
+ *
+ * @param[in] sorted Відсортована копія вікна датчика
+ * @param[in] count  Кількість значень у вікні (1..SENSOR_FILTER_WINDOW)
+ *
+ * @return Відфільтрований час відбиття в мікросекундах
+ */
+static uint16_t sensor_filter_output(const uint16_t *sorted, uint8_t count){
+#if (SENSOR_FILTER_MODE == SENSOR_FILTER_MODE_TRIMMED_MEAN)
+    uint8_t i;
+    uint8_t trim = SENSOR_FILTER_TRIM;
+    uint8_t used;
+    uint32_t sum = 0;
+
+    // Поки вікно не заповнене - зменшуємо усічення
+    if ((uint8_t)(2 * trim) >= count) {
+        trim = (uint8_t)((count - 1) / 2);
+    }
+
+    used = (uint8_t)(count - 2 * trim);
+    for (i = trim; i < (uint8_t)(count - trim); ++i) {
+        sum += sorted[i];
+    }
+
+    return (uint16_t)((sum + used / 2) / used);
+#else
+    return sorted[count / 2];
+#endif
+}
@@ -16,17 +16,43 @@
 
 //==================== DEFINES =========================
 
+#if DISTANCE_SENSOR_COUNT != HCSR04_SENSOR_COUNT
+#error "DISTANCE_SENSOR_COUNT must match HCSR04_SENSOR_COUNT"
+#endif
+
+/**
+ * @brief Множник конвертації мікросекунд у міліметри (Q16)
+ * 
+ * 1 мм = 5.8 мкс туди-назад, тобто mm = time_us * 10 / 58.
+ * Ділення замінено множенням на обернене значення:
+ * 10 / 58 * 2^16 = 11299.3 ≈ 11299.
+ * З округленням результату похибка не перевищує 0.59 мм до
+ * ~23200 мкс (DISTANCE_SENSOR_MAX_MM, далі результат
+ * обмежується) та 0.8 мм на всьому діапазоні 0-65535 мкс.
+ */
+#define TIME_TO_MM_MULTIPLIER   11299UL
+#define TIME_TO_MM_SHIFT        16
+
 /**
- * @brief Коефіцієнт конвертації мікросекунд у сантиметри
+ * @brief Множник конвертації міліметрів у сантиметри (Q16)
  * 
+ * 2^16 / 10 = 6553.6 ≈ 6554. Разом з попереднім додаванням
+ * 5 мм дає точне округлення до найближчого сантиметра
+ * для всіх значень 0-DISTANCE_SENSOR_MAX_MM.
  */
-#define TIME_TO_CM_DIVIDER      58
+#define MM_TO_CM_MULTIPLIER     6554UL
+#define MM_TO_CM_SHIFT          16
 
 /**
- * @brief Коефіцієнт конвертації мікросекунд у дюйми
+ * @brief Множник конвертації міліметрів у дюйми (Q21)
  * 
+ * 2^21 / 25.4 = 82565.0. Дає точне округлення до найближчого
+ * дюйма для всіх значень 0-DISTANCE_SENSOR_MAX_MM. Добуток
+ * mm * 82565 переповнює uint32_t з 52007 мм - вхідні значення
+ * обмежені sensor_convert_to_mm().
  */
-#define TIME_TO_INCH_DIVIDER    148
+#define MM_TO_INCH_MULTIPLIER   82565UL
+#define MM_TO_INCH_SHIFT        21
 
 //============ PUBLIC FUNCTION IMPLEMENTATIONS =========
 
@@ -35,39 +61,80 @@ void sensor_initialize(void){
     hcsr04_gpio_init();
 }
 
-uint16_t sensor_measure_pulse(uint32_t timeout_us){
-    return hcsr04_measure_pulse(timeout_us);
+void sensor_start_ranging(uint16_t period_us, uint16_t timeout_us){
+    hcsr04_ranging_start(period_us, timeout_us);
 }
 
-uint16_t sensor_convert_to_cm(uint16_t time_us){
-    uint32_t distance;
+void sensor_set_trigger_divider(uint8_t divider){
+    hcsr04_set_trigger_divider(divider);
+}
+
+uint32_t sensor_time_us(void){
+    return hcsr04_time_us();
+}
+
+uint8_t sensor_read_sample(DistanceResult *result){
+    HcSr04Sample sample;
     
-    // Перевірка на відсутність об'єкта
-    if (time_us == 0) {
+    if (!hcsr04_read_sample(&sample)) {
         return 0;
     }
     
-    // Конвертація: distance = time / 58
-    distance = (uint32_t)time_us / TIME_TO_CM_DIVIDER;
+    result->timestamp_us = sample.timestamp_us;
+    result->ticks = sample.pulse_us;
+    result->sensor = sample.sensor;
     
-    // Обмеження максимального значення для надійності
-    return (distance > DISTANCE_SENSOR_MAX_CM) ? 
-           DISTANCE_SENSOR_MAX_CM : (uint16_t)distance;
+    switch (sample.status) {
+        case HCSR04_ECHO_OK:
+            // Обидва фронти захоплені - перевірка робочого діапазону
+            if (sample.pulse_us < DISTANCE_SENSOR_MIN_ECHO_US) {
+                result->status = DISTANCE_STATUS_TOO_CLOSE;
+            } else if (sample.pulse_us > DISTANCE_SENSOR_MAX_ECHO_US) {
+                result->status = DISTANCE_STATUS_BEYOND_RANGE;
+            } else {
+                result->status = DISTANCE_STATUS_OK;
+            }
+            break;
+            
+        case HCSR04_ECHO_STUCK_HIGH:
+            result->status = DISTANCE_STATUS_ECHO_STUCK_HIGH;
+            break;
+            
+        case HCSR04_ECHO_NO_FALL:
+            // Відбиття не повернулось до дедлайну
+            result->status = DISTANCE_STATUS_BEYOND_RANGE;
+            break;
+            
+        case HCSR04_ECHO_NO_RISE:
+        default:
+            result->status = DISTANCE_STATUS_NO_ECHO;
+            break;
+    }
+    return 1;
 }
 
-
-uint16_t sensor_convert_to_inch(uint16_t time_us){
+uint16_t sensor_convert_to_mm(uint16_t time_us){
     uint32_t distance;
     
-    // Перевірка на відсутність об'єкта
-    if (time_us == 0) {
-        return 0;
-    }
-    
-    // Конвертація: distance = time / 148
-    distance = (uint32_t)time_us / TIME_TO_INCH_DIVIDER;
+    // Конвертація: distance = time * 10 / 58 з округленням
+    distance = ((uint32_t)time_us * TIME_TO_MM_MULTIPLIER
+                + (1UL << (TIME_TO_MM_SHIFT - 1))) >> TIME_TO_MM_SHIFT;
     
     // Обмеження максимального значення для надійності
-    return (distance > DISTANCE_SENSOR_MAX_INCH) ? 
-           DISTANCE_SENSOR_MAX_INCH : (uint16_t)distance;
-}
\ No newline at end of file
+    return (distance > DISTANCE_SENSOR_MAX_MM) ? 
+           DISTANCE_SENSOR_MAX_MM : (uint16_t)distance;
+}
+
+
+uint16_t sensor_mm_to_cm(uint16_t distance_mm){
+    // Конвертація: distance = (mm + 5) / 10
+    return (uint16_t)((((uint32_t)distance_mm + 5) * MM_TO_CM_MULTIPLIER)
+                      >> MM_TO_CM_SHIFT);
+}
+
+
+uint16_t sensor_mm_to_inch(uint16_t distance_mm){
+    // Конвертація: distance = mm / 25.4 з округленням
+    return (uint16_t)(((uint32_t)distance_mm * MM_TO_INCH_MULTIPLIER
+                       + (1UL << (MM_TO_INCH_SHIFT - 1))) >> MM_TO_INCH_SHIFT);
+}
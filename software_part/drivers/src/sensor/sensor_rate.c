@@ -0,0 +1,178 @@
+/**
+ * @file    sensor_rate.c
+ * @brief   Реалізація адаптивного керування частотою вимірювань
+ * @author  Olexandr Makedonskyi
+ *
+ * Модуль вирішує, в якому режимі (FAST/SLOW) працює
+ * планувальник вимірювань, та веде статистику режимів.
+ * Сам планувальник не перезапускається: режим SLOW
+ * реалізується дільником тригерів, тому перемикання не
+ * обриває поточне вимірювання.
+ *
+ * Особливості реалізації:
+ * - Статичний стан (без heap)
+ * - Ділення лише при запиті статистики
+ * - При наближенні лічильника часу до переповнення всі
+ *   лічильники режиму діляться навпіл (середні не змінюються)
+ */
+
+//==================== INCLUDES ========================
+
+#include "sensor_rate.h"
+#include "sensor_internal.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Поріг лічильника часу, після якого лічильники діляться навпіл
+ */
+#define RATE_COUNTER_LIMIT_US   0x80000000UL
+
+//================ PRIVATE VARIABLES ===================
+
+/**
+ * @brief Лічильники одного режиму
+ */
+typedef struct {
+    uint32_t samples;       /**< Кількість вимірювань */
+    uint32_t elapsed_us;    /**< Час у режимі */
+    uint32_t idle_us;       /**< Простій CPU у режимі */
+} RateCounters;
+
+static DistanceRatePolicy rate_policy;
+static uint8_t            rate_adaptive;
+static DistanceRateMode   rate_mode;
+
+/**
+ * @brief Кількість стабільних вимірювань поспіль
+ */
+static uint8_t  rate_stable_count;
+
+/**
+ * @brief Попереднє вимірювання кожного датчика, мм (для визначення активності)
+ */
+static uint16_t rate_last_mm[DISTANCE_SENSOR_COUNT];
+
+static RateCounters rate_counters[DISTANCE_RATE_MODE_COUNT];
+static uint32_t     rate_last_time;
+static uint32_t     rate_last_idle;
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void sensor_rate_configure(const DistanceRatePolicy *policy, uint32_t now_us,
+                           uint32_t idle_us){
+    uint8_t i;
+
+    rate_adaptive = (policy != 0);
+    if (rate_adaptive) {
+        rate_policy = *policy;
+        if (rate_policy.slow_divider == 0) {
+            rate_policy.slow_divider = 1;
+        }
+    }
+
+    rate_mode = DISTANCE_RATE_FAST;
+    rate_stable_count = 0;
+
+    for (i = 0; i < DISTANCE_SENSOR_COUNT; ++i) {
+        rate_last_mm[i] = 0;
+    }
+    for (i = 0; i < DISTANCE_RATE_MODE_COUNT; ++i) {
+        rate_counters[i].samples = 0;
+        rate_counters[i].elapsed_us = 0;
+        rate_counters[i].idle_us = 0;
+    }
+    rate_last_time = now_us;
+    rate_last_idle = idle_us;
+}
+
+
+void sensor_rate_account(uint32_t now_us, uint32_t idle_us){
+    RateCounters *counters = &rate_counters[rate_mode];
+
+    counters->elapsed_us += now_us - rate_last_time;
+    counters->idle_us += idle_us - rate_last_idle;
+    rate_last_time = now_us;
+    rate_last_idle = idle_us;
+
+    if (counters->elapsed_us >= RATE_COUNTER_LIMIT_US) {
+        counters->samples >>= 1;
+        counters->elapsed_us >>= 1;
+        counters->idle_us >>= 1;
+    }
+}
+
+
+uint8_t sensor_rate_update(uint8_t sensor, uint16_t time_us){
+    uint16_t distance_mm = sensor_convert_to_mm(time_us);
+    uint16_t last_mm;
+    uint16_t change;
+    uint8_t changed = 0;
+
+    rate_counters[rate_mode].samples++;
+
+    if (!rate_adaptive) {
+        return 0;
+    }
+
+    // Активність будь-якого датчика повертає FAST для всіх
+    last_mm = rate_last_mm[sensor];
+    change = (distance_mm > last_mm) ? (uint16_t)(distance_mm - last_mm)
+                                     : (uint16_t)(last_mm - distance_mm);
+    rate_last_mm[sensor] = distance_mm;
+
+    if (change > rate_policy.activity_mm) {
+        // Сцена змінюється - одразу максимальна частота
+        rate_stable_count = 0;
+        if (rate_mode != DISTANCE_RATE_FAST) {
+            rate_mode = DISTANCE_RATE_FAST;
+            changed = 1;
+        }
+    } else if (rate_stable_count < rate_policy.settle_samples) {
+        // Сцена стабільна - перехід у SLOW після settle_samples
+        if (++rate_stable_count >= rate_policy.settle_samples &&
+            rate_mode != DISTANCE_RATE_SLOW) {
+            rate_mode = DISTANCE_RATE_SLOW;
+            changed = 1;
+        }
+    }
+
+    return changed;
+}
+
+
+DistanceRateMode sensor_rate_mode(void){
+    return rate_mode;
+}
+
+
+uint8_t sensor_rate_divider(void){
+    return (rate_mode == DISTANCE_RATE_SLOW) ? rate_policy.slow_divider : 1;
+}
+
+
+void sensor_rate_get_stats(DistanceRateMode mode, DistanceRateStats *stats){
+    const RateCounters *counters = &rate_counters[mode];
+    uint32_t elapsed_ms = counters->elapsed_us / 1000;
+    uint32_t idle_scale = counters->elapsed_us / 100;
+    uint32_t idle_percent;
+
+    stats->samples = counters->samples;
+    stats->elapsed_ms = elapsed_ms;
+    stats->idle_ms = counters->idle_us / 1000;
+
+    // Кількість вимірювань обмежена лімітом часу (2^31 мкс),
+    // тому samples * 10000 не переповнюється
+    stats->samples_per_s_x10 = (elapsed_ms != 0) ?
+        (uint16_t)(counters->samples * 10000UL / elapsed_ms) : 0;
+
+    // Простій та час у режимі - від різних таймерів (TIM4 та
+    // sensor_time_us()), тому частка обмежується 100 %
+    if (idle_scale == 0) {
+        stats->idle_percent = 100;
+    } else {
+        idle_percent = counters->idle_us / idle_scale;
+        stats->idle_percent = (idle_percent >= 100) ? 100 : (uint8_t)idle_percent;
+    }
+}
@@ -0,0 +1,256 @@
+/**
+ * @file    sensor_tracker.c
+ * @brief   Реалізація альфа-бета трекера відстані
+ * @author  Olexandr Makedonskyi
+ *
+ * Модуль оцінює відстань та швидкість наближення об'єкта
+ * альфа-бета фільтром з фіксованою комою та відкидає
+ * вимірювання поза вікном очікуваного відбиття.
+ *
+ * Особливості реалізації:
+ * - Тільки цілочисельна арифметика (множення + зсув)
+ * - Ділення лише при зміні періоду вимірювань
+ * - Статичний стан (без heap)
+ */
+
+//==================== INCLUDES ========================
+
+#include "sensor_tracker.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Кількість дробових бітів позиції та швидкості (Q4)
+ */
+#define TRACKER_FRACTION_BITS   4
+
+/**
+ * @brief Напівширина вікна в форматі Q4
+ */
+#define TRACKER_GATE_Q4         ((int32_t)SENSOR_TRACKER_GATE_MM << TRACKER_FRACTION_BITS)
+
+/**
+ * @brief Максимальна позиція в форматі Q4
+ */
+#define TRACKER_MAX_POS_Q4      ((int32_t)DISTANCE_SENSOR_MAX_MM << TRACKER_FRACTION_BITS)
+
+//================ PRIVATE VARIABLES ===================
+
+/**
+ * @brief Стан трекера одного датчика
+ */
+typedef struct {
+    int32_t position;   /**< Оцінка відстані (Q4, мм) */
+    int32_t velocity;   /**< Оцінка швидкості (Q4, мм за період вимірювань) */
+    uint8_t locked;     /**< Об'єкт захоплено (1) чи трекер порожній (0) */
+    uint8_t misses;     /**< Кількість відкинутих вимірювань поспіль */
+} TrackerState;
+
+static TrackerState tracker_states[DISTANCE_SENSOR_COUNT];
+
+/**
+ * @brief Частота вимірювань (Q12, вимірювань за секунду)
+ */
+static uint32_t track_rate;
+
+/**
+ * @brief Період планувальника та кількість періодів між вимірюваннями
+ *        датчика, для яких задана швидкість
+ */
+static uint16_t track_period;
+static uint16_t track_divider;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static int32_t tracker_scale(int32_t value, uint32_t factor, uint8_t shift);
+static void tracker_reset_state(TrackerState *state);
+static void tracker_clamp_velocity(TrackerState *state);
+static void tracker_acquire(TrackerState *state, uint16_t distance_mm);
+static void tracker_output(const TrackerState *state, DistanceTrack *track);
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void sensor_tracker_reset(void){
+    uint8_t sensor;
+
+    for (sensor = 0; sensor < DISTANCE_SENSOR_COUNT; ++sensor) {
+        tracker_reset_state(&tracker_states[sensor]);
+    }
+}
+
+
+void sensor_tracker_set_period(uint16_t period_us, uint16_t divider){
+    uint8_t sensor;
+    TrackerState *state;
+
+    // Швидкість зберігається в мм за період вимірювань:
+    // при зміні дільника перераховується, при зміні періоду - скидається
+    for (sensor = 0; sensor < DISTANCE_SENSOR_COUNT; ++sensor) {
+        state = &tracker_states[sensor];
+        if (period_us != track_period) {
+            state->velocity = 0;
+        } else if (divider != track_divider) {
+            state->velocity = state->velocity * divider / track_divider;
+            tracker_clamp_velocity(state);
+        }
+    }
+    track_period = period_us;
+    track_divider = divider;
+
+    // rate = 10^6 / (period * divider), Q12
+    track_rate = (1000000UL << 12) / ((uint32_t)period_us * divider);
+}
+
+
+uint8_t sensor_tracker_update(uint8_t sensor, uint16_t distance_mm, DistanceTrack *track){
+    TrackerState *state = &tracker_states[sensor];
+    int32_t predicted;
+    int32_t residual;
+    uint8_t accepted = 0;
+
+    if (!state->locked) {
+        // Перше валідне вимірювання - захоплення об'єкта
+        if (distance_mm != 0) {
+            tracker_acquire(state, distance_mm);
+            accepted = 1;
+        }
+    } else {
+        predicted = state->position + state->velocity;
+        residual = ((int32_t)distance_mm << TRACKER_FRACTION_BITS) - predicted;
+
+        if (distance_mm != 0 &&
+            residual <= TRACKER_GATE_Q4 && residual >= -TRACKER_GATE_Q4) {
+            // Вимірювання у вікні - корекція прогнозу
+            state->position = predicted + tracker_scale(residual, SENSOR_TRACKER_ALPHA, 8);
+            state->velocity += tracker_scale(residual, SENSOR_TRACKER_BETA, 8);
+            tracker_clamp_velocity(state);
+            state->misses = 0;
+            accepted = 1;
+        } else if (++state->misses >= SENSOR_TRACKER_MAX_MISSES) {
+            // Стабільно нове значення - перезахоплення, немає відбиття - втрата
+            if (distance_mm != 0) {
+                tracker_acquire(state, distance_mm);
+                accepted = 1;
+            } else {
+                tracker_reset_state(state);
+            }
+        } else {
+            // Поодинокий викид - рух за прогнозом
+            state->position = predicted;
+        }
+
+        if (state->position < 0) {
+            state->position = 0;
+        } else if (state->position > TRACKER_MAX_POS_Q4) {
+            state->position = TRACKER_MAX_POS_Q4;
+        }
+    }
+
+    tracker_output(state, track);
+    return accepted;
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Множення на коефіцієнт з фіксованою комою та округленням
+ *
+ * Знак обробляється окремо, щоб не залежати від поведінки
+ * зсуву від'ємних чисел у компіляторі.
+ *
+ * @param[in] value  Значення зі знаком
+ * @param[in] factor Коефіцієнт (Q<shift>)
+ * @param[in] shift  Кількість дробових бітів коефіцієнта
+ *
+ * @return value * factor / 2^shift, округлене до найближчого
+ */
+static int32_t tracker_scale(int32_t value, uint32_t factor, uint8_t shift){
+    uint32_t magnitude = (uint32_t)((value < 0) ? -value : value);
+
+    magnitude = (magnitude * factor + (1UL << (shift - 1))) >> shift;
+    return (value < 0) ? -(int32_t)magnitude : (int32_t)magnitude;
+}
+
+/**
+ * @brief Скидання стану трекера датчика (об'єкт не захоплено)
+ *
+ * @param[in,out] state Стан трекера
+ */
+static void tracker_reset_state(TrackerState *state){
+    state->position = 0;
+    state->velocity = 0;
+    state->locked = 0;
+    state->misses = 0;
+}
+
+/**
+ * @brief Обмеження швидкості
+ *
+ * Швидкість не може перевищувати вікно за один період,
+ * це також обмежує розрядність проміжних добутків.
+ *
+ * @param[in,out] state Стан трекера
+ */
+static void tracker_clamp_velocity(TrackerState *state){
+    if (state->velocity > TRACKER_GATE_Q4) {
+        state->velocity = TRACKER_GATE_Q4;
+    } else if (state->velocity < -TRACKER_GATE_Q4) {
+        state->velocity = -TRACKER_GATE_Q4;
+    }
+}
+
+/**
+ * @brief Захоплення об'єкта з нульовою швидкістю
+ *
+ * @param[in,out] state       Стан трекера
+ * @param[in]     distance_mm Відстань в міліметрах (ненульова)
+ */
+static void tracker_acquire(TrackerState *state, uint16_t distance_mm){
+    state->position = (int32_t)distance_mm << TRACKER_FRACTION_BITS;
+    state->velocity = 0;
+    state->locked = 1;
+    state->misses = 0;
+}
+
+/**
+ * @brief Формування публічної оцінки стану
+ *
+ * Вікно очікуваного відбиття будується навколо прогнозу
+ * на наступне вимірювання. Якщо об'єкт не захоплено,
+ * вікно охоплює весь діапазон датчика.
+ *
+ * @param[in]  state Стан трекера
+ * @param[out] track Оцінка стану
+ */
+static void tracker_output(const TrackerState *state, DistanceTrack *track){
+    int32_t predicted;
+    int32_t window;
+
+    if (!state->locked) {
+        track->distance_mm = 0;
+        track->velocity_mm_s = 0;
+        track->window_min_mm = 0;
+        track->window_max_mm = DISTANCE_SENSOR_MAX_MM;
+        return;
+    }
+
+    track->distance_mm = (uint16_t)((state->position + 8) >> TRACKER_FRACTION_BITS);
+
+    // мм/с = (Q4 мм за період) * (Q12 вимірювань за секунду) / 2^16
+    track->velocity_mm_s = (int16_t)tracker_scale(state->velocity, track_rate,
+                                                  TRACKER_FRACTION_BITS + 12);
+
+    predicted = state->position + state->velocity;
+    if (predicted < 0) {
+        predicted = 0;
+    }
+    predicted >>= TRACKER_FRACTION_BITS;
+
+    window = predicted - SENSOR_TRACKER_GATE_MM;
+    track->window_min_mm = (window < 0) ? 0 : (uint16_t)window;
+
+    window = predicted + SENSOR_TRACKER_GATE_MM;
+    track->window_max_mm = (window > DISTANCE_SENSOR_MAX_MM) ?
+                           DISTANCE_SENSOR_MAX_MM : (uint16_t)window;
+}
@@ -13,6 +13,19 @@
  * - Контролер: ADC1
  * - Роздільна здатність: 10 біт (0-1023)
  * - Вирівнювання: право (LSB у молодшому регістрі)
+ * - Запуск: з переривання системного тіку кожні ADC_SAMPLE_PERIOD_MS
+ *   пачка з 10 конверсій (буфер DB0R-DB9R, ~70 мкс без участі CPU)
+ * - Результат: переривання EOC (IRQ22) → середнє ADC_BURST_SIZE
+ *   останніх конверсій пачки (вибірка) → кільцевий буфер
+ *   ADC_FILTER_SIZE вибірок → ковзне середнє
+ * 
+ * Основний цикл лише читає готове середнє, без очікування
+ * конверсії.
+ * 
+ * Режим очікування (adc_watch_above()): ADC конвертує безперервно
+ * без участі CPU, аналоговий watchdog (AWD) перериває лише при
+ * виході напруги за поріг. Переривання AWD повертає модуль до
+ * вибірок за тіком, перша пачка заповнює фільтр.
  * 
  * @note Модуль призначений для внутрішнього використання
  *       іншими драйверами (buttons, sensors, тощо)
@@ -63,6 +76,83 @@
 #define ADC1_CSR_EOC     ((uint8_t)0x80)
 
 
+/**
+ * @brief Нижня межа вікна аналогового watchdog (10 біт)
+ * 
+ * Рівні нижче не є подією: у режимі очікування спрацьовує
+ * лише верхня межа.
+ */
+#define ADC_WATCH_LOW_THRESHOLD  0
+
+/**
+ * @brief Номер вектора переривання ADC1 (EOC/AWD)
+ * 
+ * Використовується в таблиці векторів (stm8_interrupt_vector.c).
+ */
+#define ADC1_IRQ_NUMBER  22
+
+/**
+ * @brief Дільник тактової частоти ADC (поле SPSEL, 0-7)
+ * 
+ * 0: /2, 1: /3, 2: /4, 3: /6, 4: /8, 5: /10, 6: /12, 7: /18.
+ * За замовчуванням /8: 16 МГц → 2 МГц, конверсія ~7 мкс.
+ * 
+ * @warning Частота ADC не більше 4 МГц (дільник не менше /4)
+ */
+#ifndef ADC_PRESCALER
+#define ADC_PRESCALER    4
+#endif
+
+/**
+ * @brief Період запуску конверсій, мс (1-255)
+ * 
+ * Конверсії запускаються з переривання системного тіку.
+ */
+#ifndef ADC_SAMPLE_PERIOD_MS
+#define ADC_SAMPLE_PERIOD_MS    1
+#endif
+
+/**
+ * @brief Кількість конверсій пачки, що усереднюються в одну вибірку
+ * 
+ * Степінь двійки: ділення - зсув. Решта з 10 конверсій буфера
+ * відкидається як час встановлення.
+ */
+#define ADC_BURST_SIZE   8
+
+/**
+ * @brief Кількість останніх вибірок в усередненні (степінь двійки, 1-64)
+ * 
+ * Час реакції фільтра: ADC_FILTER_SIZE * ADC_SAMPLE_PERIOD_MS.
+ * Шум вже усереднює пачка, тому за замовчуванням 2.
+ */
+#ifndef ADC_FILTER_SIZE
+#define ADC_FILTER_SIZE  2
+#endif
+
+#if (ADC_PRESCALER < 2) || (ADC_PRESCALER > 7)
+#error "ADC_PRESCALER must be in range 2..7 (ADC clock <= 4 MHz)"
+#endif
+
+#if (ADC_SAMPLE_PERIOD_MS < 1) || (ADC_SAMPLE_PERIOD_MS > 255)
+#error "ADC_SAMPLE_PERIOD_MS must be in range 1..255"
+#endif
+
+#if (ADC_FILTER_SIZE < 1) || (ADC_FILTER_SIZE > 64) || \
+    ((ADC_FILTER_SIZE & (ADC_FILTER_SIZE - 1)) != 0)
+#error "ADC_FILTER_SIZE must be a power of two in range 1..64"
+#endif
+
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Обробник нової вибірки (викликається з переривання EOC)
+ * 
+ * @param[in] filtered Усереднене значення після цієї вибірки (0-1023)
+ */
+typedef void (*AdcSampleHandler)(uint16_t filtered);
+
 //================== FUNCTIONS PROTOTYPES ==================
 
 /**
@@ -70,65 +160,92 @@
  * 
  * Виконує налаштування ADC1 для роботи з аналоговими входами:
  * - Вибір каналу ADC1_CHANNEL_3
+ * - Дільник тактування ADC_PRESCALER
  * - Налаштування правого вирівнювання результату
+ * - Переривання завершення конверсії (EOC)
  * - Увімкнення живлення ADC
  * 
- * @note Функція має викликатись один раз при старті системи
- *       перед першим зчитуванням ADC
+ * Перша конверсія запускається системним тіком після
+ * глобального дозволу переривань.
  * 
- * @warning Після ініціалізації необхідно зачекати мінімум
- *          7 мкс перед першою конверсією (час стабілізації)
+ * @note Функція має викликатись один раз при старті системи
  * 
- * @see adc_start_single_conversion()
- * @see adc_read()
+ * @see adc_trigger_tick()
+ * @see adc_get_filtered()
  */
 void     initialize_adc(void);
 
 /**
- * @brief Запуск одиничної конверсії ADC
+ * @brief Відлік періоду запуску конверсій
  * 
- * Ініціює процес аналого-цифрового перетворення на обраному
- * каналі. Після запуску необхідно дочекатись встановлення
- * прапорця EOC перед зчитуванням результату.
+ * Кожен ADC_SAMPLE_PERIOD_MS-й виклик запускає конверсію,
+ * результат забирає переривання EOC.
  * 
- * Час конверсії залежить від налаштувань тактування та
- * становить приблизно 14 тактів ADC (типово ~14 мкс при 1 МГц).
+ * @note Викликається з переривання системного тіку (1 мс)
+ */
+void     adc_trigger_tick(void);
+
+/**
+ * @brief Останнє усереднене значення ADC
  * 
- * @note ADC має бути попередньо ініціалізований
- *       викликом initialize_adc()
+ * Середнє ADC_FILTER_SIZE останніх вибірок. Не чекає
+ * на конверсію та не забороняє переривання: якщо переривання
+ * оновило значення під час зчитування, зчитування повторюється.
  * 
- * @warning Не запускайте нову конверсію до завершення попередньої
+ * @return 10-бітне значення АЦП (0-1023)
  * 
- * @see adc_read()
- * @see ADC1_CSR_EOC
+ * @note Викликається з основного циклу
  */
-void     adc_start_single_conversion(void);
+uint16_t adc_get_filtered(void);
 
 /**
- * @brief Зчитування результату конверсії ADC
+ * @brief Підключення обробника кожної вибірки
  * 
- * Виконує блокуюче очікування завершення конверсії та
- * зчитування 10-бітного результату з регістрів DRL/DRH.
+ * @param[in] handler Функція, що викликається з переривання EOC
+ *                    після оновлення середнього (0 - вимкнути)
  * 
- * Послідовність операцій:
- * 1. Очікування встановлення прапорця EOC
- * 2. Скидання прапорця EOC
- * 3. Зчитування молодшого байту (DRL)
- * 4. Зчитування старшого байту (DRH)
- * 5. Об'єднання результату
- * 
- * @return 10-бітне значення АЦП (0-1023)
+ * @warning Обробник виконується в перериванні: лише короткі
+ *          неблокуючі дії, час - через systick_ms_isr()
+ */
+void     adc_set_sample_handler(AdcSampleHandler handler);
+
+/**
+ * @brief Перехід у режим очікування на аналоговому watchdog
  * 
- * @note Функція блокуюча - виконання зупиняється до
- *       завершення конверсії (~14 мкс при 1 МГц ADC)
+ * Зупиняє вибірки за тіком, вмикає безперервні конверсії
+ * каналу з перериванням лише AWD. Коли результат перевищить
+ * threshold, переривання повертає вибірки за тіком; перша
+ * пачка (не пізніше ніж через тік) заповнює фільтр.
  * 
- * @warning Молодший байт (DRL) ОБОВ'ЯЗКОВО має читатись першим
- *          для коректної роботи апаратного захисту від race condition
+ * @param[in] threshold Верхня межа вікна (0-1023)
  * 
- * @see adc_start_single_conversion()
+ * @note Викликається з обробника вибірки (переривання ADC):
+ *       тоді конверсія за тіком вже завершена
+ * @note Поки модуль очікує, adc_get_filtered() повертає
+ *       останнє середнє до переходу
  */
-uint16_t adc_read(void);
+void     adc_watch_above(uint16_t threshold);
 
+/**
+ * @brief Примусовий вихід з режиму очікування
+ * 
+ * Якщо ADC чекає на AWD, повертає вибірки за тіком (перша
+ * пачка заповнить фільтр). Інакше нічого не робить.
+ * 
+ * @note Викликається з основного циклу
+ */
+void     adc_watch_cancel(void);
 
+/**
+ * @brief Обробник переривання ADC1 (завершення конверсії, AWD)
+ * 
+ * Зупиняє пачку, усереднює буфер, додає вибірку в кільцевий
+ * буфер, оновлює усереднене значення та викликає обробник
+ * вибірки. Спрацювання AWD лише повертає режим вибірок за
+ * тіком: першу вибірку дасть пачка на наступному тіку.
+ * 
+ * @note Вказується у таблиці векторів як irq22
+ */
+INTERRUPT_HANDLER(adc1_eoc_irq_handler, ADC1_IRQ_NUMBER);
 
-#endif
\ No newline at end of file
+#endif
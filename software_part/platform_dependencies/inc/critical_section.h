@@ -0,0 +1,58 @@
+/**
+ * @file    critical_section.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Критичні секції зі збереженням стану переривань
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * disableInterrupts()/enableInterrupts() безумовно вмикають
+ * переривання на виході: виклик з ініціалізації (до
+ * глобального дозволу в initialize_hardware()) або з секції,
+ * де переривання вже заборонені, дозволив би їх завчасно.
+ *
+ * CRITICAL_SECTION_ENTER() зберігає регістр CC (біти I1/I0)
+ * у змінну та забороняє переривання, CRITICAL_SECTION_EXIT()
+ * відновлює CC - стан переривань стає таким, як до входу.
+ * Стан зберігається у змінній, а не в стеку: код між
+ * макросами звертається до локальних змінних відносно SP.
+ *
+ * @code
+ * uint8_t cc;
+ *
+ * CRITICAL_SECTION_ENTER(cc);
+ * now = systick_counter;
+ * CRITICAL_SECTION_EXIT(cc);
+ * @endcode
+ */
+
+#ifndef __CRITICAL_SECTION_H
+#define __CRITICAL_SECTION_H
+
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
+//==================== MACROS ==========================
+
+#ifdef _COSMIC_
+
+/**
+ * @brief Збереження CC у state та заборона переривань
+ *
+ * @param[out] state Змінна uint8_t (значення CC до входу)
+ */
+#define CRITICAL_SECTION_ENTER(state) \
+    ((state) = (uint8_t)_asm("push cc\n pop a\n sim\n"))
+
+/**
+ * @brief Відновлення CC (та стану переривань) зі state
+ *
+ * @param[in] state Значення, збережене CRITICAL_SECTION_ENTER()
+ */
+#define CRITICAL_SECTION_EXIT(state) \
+    _asm("push a\n pop cc\n", (uint8_t)(state))
+
+#else
+#error "CRITICAL_SECTION_* are implemented for the Cosmic compiler only"
+#endif /* _COSMIC_ */
+
+#endif /* __CRITICAL_SECTION_H */
@@ -6,9 +6,37 @@
   * @date    13.01.2026
   * @version 1.0
   * 
-  * Модуль надає функції для створення блокуючих затримок
-  * мікросекундного та мілісекундного діапазону, використовуючи
-  * апаратний таймер TIM4.
+  * Модуль надає короткі блокуючі затримки (до 64 мкс) для
+  * bit-banging протоколів: кількість тактів CPU рахується на
+  * етапі компіляції. Довші очікування - програмні таймери
+  * (soft_timer.h) та задачі планувальника, без блокування CPU.
+  *
+  * DELAY_SHORT_US(): кількість ітерацій рахується з HSI_VALUE
+  * з урахуванням часу виклику, у виконуваному коді залишається
+  * лише ld a,#n + call. Тіло _delay_loops() написане на асемблері
+  * (delays.c), тому послідовність інструкцій та кількість тактів
+  * не залежать від опцій компілятора:
+  * - ld a,#n (1) + call (4)
+  * - n ітерацій: nop (1) + dec a (1) + jrne (2), останній jrne
+  *   не переходить (1)
+  * - ret (4)
+  * Разом 4 * n + 8 тактів.
+  *
+  * Бюджет тактів DELAY_SHORT_US() при 16 МГц:
+  * | us | ітерацій | тактів | фактично, мкс |
+  * |----|----------|--------|---------------|
+  * |  1 |    2     |   16   |     1.00      |
+  * |  2 |    6     |   32   |     2.00      |
+  * |  3 |   10     |   48   |     3.00      |
+  * |  5 |   18     |   80   |     5.00      |
+  * | 10 |   38     |  160   |    10.00      |
+  *
+  * Перевірка на цілі: з PROFILER_ENABLE initialize_hardware()
+  * вимірює DELAY_SHORT_US(1/2/3/5/10) у зонах
+  * PROFILER_ZONE_DELAY_1US..PROFILER_ZONE_DELAY_10US та порожню
+  * зону PROFILER_ZONE_EMPTY (накладні витрати профайлера).
+  * У першому звіті профайлера різниця max cyc кожної зони
+  * та порожньої має дорівнювати колонці "тактів".
   *
   */
 
@@ -17,21 +45,77 @@
 
 //==================== INCLUDES ========================
 #include "stm8s.h"
-//================== FUNCTIONS PROTOTYPES ==================
+//==================== DEFINES =========================
 
 /**
- * @brief Затримка у мікросекундах
- * Функція виконує блокуючу затримку на задану кількість мікросекунд.
- * Використовує прапор оновлення таймера TIM4.
- * @param[in] microseconds Час затримки у мкс (us).
+ * @brief Частота CPU в МГц (тактів на мікросекунду)
+ */
+#define DELAY_CPU_MHZ           ((HSI_VALUE) / 1000000UL)
+
+/**
+ * @brief Тривалість однієї ітерації _delay_loops() в тактах CPU
  * 
+ * nop (1) + dec a (1) + jrne (2).
  */
-void _delay_us(uint16_t microseconds);
+#define DELAY_LOOP_CYCLES       4
 
 /**
- * @brief Затримка у мілісекундах
- * Обгортка над delay_us для формування довших інтервалів.
- * @param[in] milliseconds Час затримки у мс (ms).
+ * @brief Накладні витрати виклику _delay_loops() в тактах CPU
+ * 
+ * ld a,#n (1) + call (4) + ret (4) мінус такт останнього
+ * jrne, що не переходить.
  */
-void _delay_ms(uint16_t milliseconds);
+#define DELAY_CALL_CYCLES       8
+
+/**
+ * @brief Найдовша затримка DELAY_SHORT_US() в мкс
+ * 
+ * Кількість ітерацій - uint8_t: (64 * 16 - 8 + 3) / 4 = 254
+ * при 16 МГц, 65 мкс дали б 258 і після приведення - 2 ітерації.
+ */
+#define DELAY_SHORT_MAX_US      ((255UL * DELAY_LOOP_CYCLES + DELAY_CALL_CYCLES) / DELAY_CPU_MHZ)
+
+/**
+ * @brief Кількість ітерацій _delay_loops() для затримки us мкс
+ */
+#define DELAY_SHORT_LOOPS(us) \
+    (((us) * DELAY_CPU_MHZ - DELAY_CALL_CYCLES + DELAY_LOOP_CYCLES - 1) / DELAY_LOOP_CYCLES)
+
+/**
+ * @brief Перевірка діапазону 1..DELAY_SHORT_MAX_US на етапі компіляції
+ * 
+ * Поза діапазоном розмір масиву від'ємний - помилка компіляції
+ * замість мовчазного переповнення кількості ітерацій. sizeof
+ * не обчислюється під час виконання, коду не додає.
+ */
+#define DELAY_SHORT_CHECK(us) \
+    ((void)sizeof(char[((us) >= 1 && (us) <= DELAY_SHORT_MAX_US) ? 1 : -1]))
+
+/**
+ * @brief Коротка затримка з точністю до такту (1-64 мкс)
+ * 
+ * Кількість ітерацій округлюється вгору: затримка ніколи
+ * не коротша за задану (часові вимоги протоколів - мінімальні).
+ * 
+ * @param[in] us Затримка в мкс - константа часу компіляції
+ *               (1..DELAY_SHORT_MAX_US, інакше помилка компіляції)
+ */
+#define DELAY_SHORT_US(us) \
+    (DELAY_SHORT_CHECK(us), _delay_loops((uint8_t)DELAY_SHORT_LOOPS(us)))
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Цикл фіксованої кількості ітерацій
+ * 
+ * Основа DELAY_SHORT_US(), напряму не викликається.
+ * 
+ * @param[in] loops Кількість ітерацій по DELAY_LOOP_CYCLES тактів (1-255,
+ *                  0 - 256 ітерацій)
+ * 
+ * @note Не залежить від переривань - можна викликати з обробників
+ *       (переривання, що прийшло під час циклу, подовжує затримку)
+ */
+void _delay_loops(uint8_t loops);
+
 #endif /* DELAYS_H */
\ No newline at end of file
@@ -0,0 +1,65 @@
+/**
+ * @file    eeprom.h
+ * @author  Olexandr Makedonskyi
+ * @brief   HAL вбудованої data EEPROM
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Апаратна конфігурація:
+ * - Data EEPROM: 640 байт з адреси 0x4000 (сегмент .eeprom)
+ * - Запис словами по 4 байти (WPRG): стирання + запис ~6 мс
+ *   на слово, незмінні слова не перезаписуються (ресурс
+ *   300 тис. циклів)
+ * - Після запису EEPROM знову захищається (DUL скинутий)
+ *
+ * Розподіл адрес (зміщення від EEPROM_START_ADDRESS):
+ * - 0x000-0x00F: таблиця калібрування кнопок (buttons)
+ */
+
+#ifndef __EEPROM_H
+#define __EEPROM_H
+
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Початок та розмір data EEPROM
+ */
+#define EEPROM_START_ADDRESS    ((uint16_t)0x4000)
+#define EEPROM_SIZE             640
+
+/**
+ * @brief Розмір слова запису (байт)
+ */
+#define EEPROM_WORD_SIZE        4
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Зчитування блоку з EEPROM
+ *
+ * @param[in]  offset Зміщення від EEPROM_START_ADDRESS
+ * @param[out] data   Буфер
+ * @param[in]  size   Кількість байт
+ */
+void eeprom_read(uint16_t offset, void *data, uint8_t size);
+
+/**
+ * @brief Запис блоку в EEPROM
+ *
+ * @param[in] offset Зміщення, кратне EEPROM_WORD_SIZE
+ * @param[in] data   Дані
+ * @param[in] size   Кількість байт, кратна EEPROM_WORD_SIZE
+ *
+ * @return Результат запису
+ * @retval 1 Дані записані та збігаються з прочитаними
+ * @retval 0 Невірні параметри, захист від запису або таймаут
+ *
+ * @warning Блокує до ~6 мс на кожне змінене слово: лише для
+ *          рідкісних операцій (калібрування), не в перериваннях
+ */
+uint8_t eeprom_write(uint16_t offset, const void *data, uint8_t size);
+
+#endif /* __EEPROM_H */
@@ -27,6 +27,28 @@
  * - ECHO затримка: 100-25000 мкс (2-430 см)
  * - Цикл вимірювання: мінімум 60 мс між вимірюваннями
  * 
+ * Планувальник вимірювань (hcsr04_ranging_start()):
+ * - Період TIM2 (ARR) = період вимірювань, 1 тік = 1 мкс
+ * - Переривання TIM2 Update (IRQ13) генерує TRIG на початку періоду
+ * - Фронти ECHO захоплюються в перериванні TIM2 CC (IRQ14)
+ * - Дедлайн відсутності ECHO - канал порівняння TIM2_CH1 (той самий IRQ14)
+ * - Результати складаються в кільцевий буфер hcsr04_read_sample()
+ * 
+ * Кілька датчиків (HCSR04_SENSOR_COUNT > 1):
+ * - Датчики тригеряться по черзі, по одному на період
+ *   (період >= дедлайн + час відновлення), тому відбиття
+ *   одного датчика ніколи не захоплюється іншим
+ * - Частота вимірювань одного датчика = 1 / (N * період),
+ *   сумарна - 1 / період (межа, яку допускає фізика HC-SR04)
+ * - Датчик 1: ECHO на TIM2_CH3 (PA3), датчик 2: TIM2_CH2 (PD3).
+ *   Канали TIM1 зайняті дисплеєм та зсувовим регістром
+ * 
+ * Часова діаграма одного періоду:
+ * @code
+ * CNT: 0        ~500        echo_end   timeout          period
+ *      |TRIG|....|==ECHO==|.........|....guard.........|TRIG ...
+ * @endcode
+ * 
  * @note Модуль призначений для використання драйверами
  *       вищого рівня (sensor.h)
  */
@@ -39,6 +61,7 @@
 
 #include "stm8s.h"
 #include "delays.h"
+#include "spsc_queue.h"
 
 //==================== DEFINES =========================
 
@@ -66,6 +89,42 @@
  */
 #define HCSR04_ECHO_PIN         (1 << 3)
 
+/**
+ * @brief Кількість підключених датчиків (1-2)
+ * 
+ * Вільні канали захоплення TIM2: CH3 та CH2
+ * (CH1 використовується як дедлайн).
+ */
+#ifndef HCSR04_SENSOR_COUNT
+#define HCSR04_SENSOR_COUNT     1
+#endif
+
+#if (HCSR04_SENSOR_COUNT < 1) || (HCSR04_SENSOR_COUNT > 2)
+#error "HCSR04_SENSOR_COUNT must be 1 or 2"
+#endif
+
+/**
+ * @brief Порт GPIO для піну TRIG другого датчика
+ */
+#define HCSR04_TRIG2_PORT       GPIOA
+
+/**
+ * @brief Номер піна TRIG другого датчика (PA2)
+ */
+#define HCSR04_TRIG2_PIN        (1 << 2)
+
+/**
+ * @brief Порт GPIO для піну ECHO другого датчика
+ */
+#define HCSR04_ECHO2_PORT       GPIOD
+
+/**
+ * @brief Номер піна ECHO другого датчика (PD3)
+ * 
+ * Підключений до TIM2_CH2 для вимірювання тривалості імпульсу.
+ */
+#define HCSR04_ECHO2_PIN        (1 << 3)
+
 /**
  * @brief Тривалість тригерного імпульсу в мікросекундах
  * 
@@ -73,6 +132,57 @@
  */
 #define HCSR04_TRIGGER_PULSE_US 10
 
+/**
+ * @brief Номер вектора переривання TIM2 Update/Overflow
+ * 
+ * Подія оновлення TIM2 задає період планувальника вимірювань.
+ * Використовується в таблиці векторів (stm8_interrupt_vector.c).
+ */
+#define HCSR04_TIM2_UPDATE_IRQ_NUMBER   13
+
+/**
+ * @brief Номер вектора переривання TIM2 Capture/Compare
+ * 
+ * Використовується в таблиці векторів (stm8_interrupt_vector.c).
+ */
+#define HCSR04_TIM2_CC_IRQ_NUMBER   14
+
+/**
+ * @brief Ємність буфера готових вимірювань
+ * 
+ * Має бути степенем двійки (не більше SPSC_QUEUE_MAX_CAPACITY).
+ * Буфер заповнюється в перериванні та читається основним циклом,
+ * корисні всі комірки.
+ */
+#define HCSR04_SAMPLE_BUFFER_SIZE   4
+
+#if (HCSR04_SAMPLE_BUFFER_SIZE & (HCSR04_SAMPLE_BUFFER_SIZE - 1)) != 0 || \
+    (HCSR04_SAMPLE_BUFFER_SIZE > SPSC_QUEUE_MAX_CAPACITY)
+#error "HCSR04_SAMPLE_BUFFER_SIZE must be a power of two up to SPSC_QUEUE_MAX_CAPACITY"
+#endif
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Результат захоплення імпульсу ECHO
+ */
+typedef enum {
+    HCSR04_ECHO_OK = 0,         /**< Обидва фронти захоплені */
+    HCSR04_ECHO_NO_RISE,        /**< До дедлайну не було rising edge, ECHO в LOW */
+    HCSR04_ECHO_STUCK_HIGH,     /**< До дедлайну не було rising edge, ECHO в HIGH */
+    HCSR04_ECHO_NO_FALL         /**< Rising edge був, falling edge - ні */
+} HcSr04EchoStatus;
+
+/**
+ * @brief Вимірювання в буфері
+ */
+typedef struct {
+    uint32_t timestamp_us;      /**< Час тригера від старту планувальника, мкс */
+    uint16_t pulse_us;          /**< Тривалість ECHO (для NO_FALL - до дедлайну), мкс */
+    uint8_t  status;            /**< HcSr04EchoStatus */
+    uint8_t  sensor;            /**< Номер датчика (0 - HCSR04_SENSOR_COUNT-1) */
+} HcSr04Sample;
+
 
 //================== FUNCTIONS PROTOTYPES ==================
 
@@ -82,61 +192,122 @@
  * Виконує повну ініціалізацію апаратних ресурсів:
  * 
  * GPIO налаштування:
- * - TRIG (PB4): вихід, Push-Pull, High Speed, початковий стан LOW
- * - ECHO (PA3): вхід, Floating (без підтяжки)
+ * - TRIG (PB4, PA2): вихід, Push-Pull, High Speed, початковий стан LOW
+ * - ECHO (PA3, PD3): вхід, Floating (без підтяжки)
  * 
  * Таймер TIM2 налаштування:
  * - Prescaler: /16 (1 МГц → 1 тік = 1 мкс)
  * - Auto-reload: 0xFFFF (65535 мкс циклу)
- * - CH3 режим: Input Capture (захоплення фронтів)
+ * - CH3 (та CH2 для другого датчика): Input Capture
  * - Початковий стан: захоплення rising edge
  * 
- * @note Функція має викликатись один раз перед першим
- *       використанням hcsr04_measure_pulse()
+ * @note Функція має викликатись один раз перед
+ *       hcsr04_ranging_start()
  * 
  * @warning Після ініціалізації необхідно зачекати мінімум
  *          1 мс перед першим вимірюванням (ініціалізація датчика)
  * 
- * @see hcsr04_measure_pulse()
+ * @see hcsr04_ranging_start()
  */
 void hcsr04_gpio_init(void);
 
 
 /**
- * @brief Вимірювання тривалості імпульсу ECHO
+ * @brief Запуск планувальника вимірювань з фіксованим періодом
+ * 
+ * Перезапускає TIM2 з auto-reload = period_us - 1 та вмикає
+ * переривання оновлення. На кожному переповненні (початок
+ * періоду) генерується тригерний імпульс та програмується
+ * дедлайн CCR1 = timeout_us. Таким чином частота вимірювань
+ * визначається лише апаратним таймером і не залежить від
+ * тривалості відбиття чи завантаження основного циклу.
+ * 
+ * Оскільки TRIG генерується при CNT≈0, а дедлайн менший
+ * за період, захоплені значення ніколи не переходять
+ * через переповнення таймера.
+ * 
+ * @param[in] period_us  Період вимірювань в мікросекундах (до 65535)
+ *                       Має бути >= timeout_us + час відновлення датчика
+ * @param[in] timeout_us Дедлайн очікування ECHO від тригера (< period_us)
+ * 
+ * @warning Перевірку періоду виконує драйвер вищого рівня
+ * 
+ * @see hcsr04_read_sample()
+ */
+void hcsr04_ranging_start(uint16_t period_us, uint16_t timeout_us);
+
+/**
+ * @brief Встановлення дільника тригерів
+ * 
+ * Тригерний імпульс генерується лише в кожному divider-му
+ * періоді планувальника. Дозволяє знижувати частоту
+ * вимірювань нижче 1000000 / 65535 Гц без зміни налаштувань
+ * таймера та без втрати поточного вимірювання.
+ * 
+ * @param[in] divider Дільник (1 - кожен період, 0 трактується як 1)
+ * 
+ * @see hcsr04_ranging_start()
+ */
+void hcsr04_set_trigger_divider(uint8_t divider);
+
+/**
+ * @brief Час від запуску планувальника в мікросекундах
+ * 
+ * Сума періодів, відрахованих перериванням оновлення, та
+ * поточного значення лічильника TIM2. Переповнення, яке ще
+ * не оброблене перериванням, враховується через прапорець UIF.
+ * 
+ * @return Час в мікросекундах (переповнюється через ~71 хв,
+ *         різниця двох значень залишається коректною)
+ * 
+ * @note Ненадовго забороняє переривання та відновлює їх
+ *       попередній стан
+ */
+uint32_t hcsr04_time_us(void);
+
+/**
+ * @brief Зчитування наступного готового вимірювання з буфера
+ * 
+ * Неблокуюча функція. Буфер заповнюється обробником
+ * переривання (єдиний producer) та читається основним
+ * циклом (єдиний consumer), тому блокування не потрібне.
  * 
- * Виконує повний цикл вимірювання відстані:
- * 1. Генерує тригерний імпульс (10 мкс)
- * 2. Очікує rising edge на ECHO (початок імпульсу)
- * 3. Захоплює значення таймера (rise_time)
- * 4. Перемикається на детекцію falling edge
- * 5. Очікує falling edge на ECHO (кінець імпульсу)
- * 6. Захоплює значення таймера (fall_time)
- * 7. Обчислює тривалість: pulse_width = fall_time - rise_time
+ * @param[out] sample Тривалість імпульсу ECHO, статус захоплення
+ *                    та час тригера
  * 
- * Input Capture використовує TIM2_CH3:
- * - Rising edge: CC3P=0, CC3E=1 (CCER2 = 0x01)
- * - Falling edge: CC3P=1, CC3E=1 (CCER2 = 0x03)
- * - Захоплені значення зберігаються в CCR3H:CCR3L
+ * @return Наявність даних
+ * @retval 1 Вимірювання зчитане в pulse_us
+ * @retval 0 Буфер порожній
  * 
- * @param[in] timeout_us Максимальний час очікування в мікросекундах
- *                       Типово: 30000 мкс (для відстані до 5 м)
+ * @note Якщо буфер переповнений, нові вимірювання відкидаються
+ */
+uint8_t hcsr04_read_sample(HcSr04Sample *sample);
+
+/**
+ * @brief Обробник переривання TIM2 Update (початок періоду)
  * 
- * @return Тривалість імпульсу ECHO в мікросекундах
- * @retval 0 Таймаут або помилка вимірювання (об'єкт не виявлено)
- * @retval >0 Виміряна тривалість імпульсу (58-23200 мкс для 1-400 см)
+ * Запускає чергове вимірювання наступного по черзі датчика:
+ * налаштовує захоплення rising edge, дедлайн CC1 та генерує
+ * тригерний імпульс (~10 мкс).
+ * При дільнику тригерів > 1 пропускає проміжні періоди.
  * 
- * @note Функція блокуюча - виконання зупиняється до завершення
- *       вимірювання або таймауту
+ * @note Вказується у таблиці векторів як irq13
+ */
+INTERRUPT_HANDLER(hcsr04_tim2_update_irq_handler, HCSR04_TIM2_UPDATE_IRQ_NUMBER);
+
+/**
+ * @brief Обробник переривання TIM2 Capture/Compare
  * 
- * @note Між послідовними викликами необхідна пауза мінімум 60 мс
- *       для стабілізації датчика
+ * Захоплює значення каналу активного датчика на кожному фронті ECHO:
+ * - rising edge: зберігає час початку та перемикає полярність
+ * - falling edge: обчислює тривалість та кладе її в буфер
  * 
- * @warning При таймауті функція відновлює початковий стан таймера
- *          (CCER2 = 0x01 для наступного вимірювання)
+ * Подія порівняння CC1 (дедлайн) завершує незакінчене
+ * вимірювання зі статусом, що залежить від того, на якому
+ * фронті воно зупинилось, та від рівня лінії ECHO.
  * 
- * @see hcsr04_send_trigger()
+ * @note Вказується у таблиці векторів як irq14
  */
-uint16_t hcsr04_measure_pulse(uint32_t timeout_us);
+INTERRUPT_HANDLER(hcsr04_tim2_cc_irq_handler, HCSR04_TIM2_CC_IRQ_NUMBER);
 
 #endif /* __HCSR04_H */
\ No newline at end of file
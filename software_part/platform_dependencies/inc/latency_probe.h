@@ -0,0 +1,95 @@
+/**
+ * @file    latency_probe.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Вимірювання затримки "кнопка → дисплей"
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Затримка реакції на кнопку - від першого зчитування нового
+ * стану кнопки (перша вибірка ADC кандидата в дебаунсі) до завершення
+ * перемальовування дисплея, яке показало результат натискання
+ * (у тому числі без передачі, якщо кадр на дисплеї не змінився).
+ *
+ * Послідовність:
+ * 1. Бізнес-логіка, обробивши жест, що запитав перемальовування
+ *    дисплея, викликає latency_probe_start() з часом фронту
+ * 2. Задача дисплея, виконавши цей запит, викликає
+ *    latency_probe_stop(). Оновлення дисплея від нових
+ *    вимірювань вимірювання не завершують
+ * 3. Затримка потрапляє в гістограму з кошиками по
+ *    LATENCY_PROBE_BIN_MS, останній кошик - "не менше"
+ *
+ * Роздільна здатність - 1 мс (системний тік). Гістограма
+ * накопичується з моменту запуску.
+ *
+ * Використання RAM: 2 байти на кошик + 5 байт
+ */
+
+#ifndef __LATENCY_PROBE_H
+#define __LATENCY_PROBE_H
+
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Ширина кошика гістограми, мс
+ */
+#ifndef LATENCY_PROBE_BIN_MS
+#define LATENCY_PROBE_BIN_MS    10
+#endif
+
+/**
+ * @brief Кількість кошиків (останній - затримки від
+ *        (LATENCY_PROBE_BINS - 1) * LATENCY_PROBE_BIN_MS і більше)
+ */
+#ifndef LATENCY_PROBE_BINS
+#define LATENCY_PROBE_BINS      8
+#endif
+
+#if (LATENCY_PROBE_BIN_MS < 1) || (LATENCY_PROBE_BINS < 2)
+#error "LATENCY_PROBE_BIN_MS must be >= 1 and LATENCY_PROBE_BINS >= 2"
+#endif
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Гістограма затримок
+ */
+typedef struct {
+    uint16_t bins[LATENCY_PROBE_BINS];  /**< Кількість вимірів у кошику (насичення 0xFFFF) */
+    uint16_t max_ms;                    /**< Найбільша затримка, мс */
+} LatencyHistogram;
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Початок вимірювання
+ *
+ * @param[in] edge_ms Час фронту кнопки (молодші 16 біт системного часу)
+ *
+ * @note Якщо попереднє вимірювання ще не завершене, час
+ *       початку залишається попереднім (швидкі натискання
+ *       показуються одним записом у дисплей)
+ */
+void latency_probe_start(uint16_t edge_ms);
+
+/**
+ * @brief Кінець вимірювання (запис у дисплей завершено)
+ *
+ * Без активного вимірювання нічого не робить.
+ *
+ * @note Викликається задачею дисплея після перемальовування,
+ *       запитаного жестом
+ */
+void latency_probe_stop(void);
+
+/**
+ * @brief Копія гістограми
+ *
+ * @param[out] histogram Кошики та найбільша затримка
+ */
+void latency_probe_get(LatencyHistogram *histogram);
+
+#endif /* __LATENCY_PROBE_H */
@@ -0,0 +1,125 @@
+/**
+ * @file    profiler.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Профілювання зон коду в тактах CPU (TIM1)
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Зона коду обмежується макросами PROFILER_ENTER()/PROFILER_EXIT().
+ * Для кожної зони накопичується кількість проходів, сумарний
+ * та найбільший час у тактах CPU (16 МГц).
+ *
+ * Апаратна конфігурація:
+ * - Таймер: TIM1, без дільника (1 такт = 62.5 нс), вільний
+ *   рахунок 0-0xFFFF без переривань, виводи не задіяні
+ *
+ * Без PROFILER_ENABLE всі макроси порожні, а profiler.c
+ * не містить коду та змінних.
+ *
+ * Використання RAM (з PROFILER_ENABLE): 12 байт на зону
+ */
+
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+//Розкоментувати дану строку для профілювання (таблиця виводиться в лог)
+//#define PROFILER_ENABLE
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Зони профілювання
+ */
+typedef enum {
+    PROFILER_ZONE_MEASUREMENT = 0,  /**< perform_distance_measurement() */
+    PROFILER_ZONE_DISPLAY_WRITE,    /**< display_driver_write_text() */
+    PROFILER_ZONE_SHIFT_REG_SEND,   /**< shift_reg_send() */
+    PROFILER_ZONE_DEBOUNCE,         /**< debounce_button() */
+    PROFILER_ZONE_EMPTY,            /**< Порожня зона: накладні витрати профайлера */
+    PROFILER_ZONE_DELAY_1US,        /**< DELAY_SHORT_US(1) при запуску (delays.h) */
+    PROFILER_ZONE_DELAY_2US,        /**< DELAY_SHORT_US(2) при запуску */
+    PROFILER_ZONE_DELAY_3US,        /**< DELAY_SHORT_US(3) при запуску */
+    PROFILER_ZONE_DELAY_5US,        /**< DELAY_SHORT_US(5) при запуску */
+    PROFILER_ZONE_DELAY_10US,       /**< DELAY_SHORT_US(10) при запуску */
+    PROFILER_ZONE_FILTER,           /**< sensor_filter_update(): вартість одного вимірювання */
+    PROFILER_ZONE_COUNT
+} ProfilerZone;
+
+/**
+ * @brief Статистика зони
+ */
+typedef struct {
+    uint32_t count;             /**< Кількість проходів */
+    uint32_t total_cycles;      /**< Сумарний час, такти */
+    uint16_t max_cycles;        /**< Найдовший прохід, такти */
+} ProfilerZoneStats;
+
+//==================== MACROS ==========================
+
+#ifdef PROFILER_ENABLE
+
+#define PROFILER_INIT()         profiler_init()
+#define PROFILER_ENTER(zone)    profiler_enter(zone)
+#define PROFILER_EXIT(zone)     profiler_exit(zone)
+
+#else
+
+#define PROFILER_INIT()         ((void)0)
+#define PROFILER_ENTER(zone)    ((void)0)
+#define PROFILER_EXIT(zone)     ((void)0)
+
+#endif /* PROFILER_ENABLE */
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+#ifdef PROFILER_ENABLE
+
+/**
+ * @brief Запуск TIM1 як лічильника тактів, очищення таблиці
+ *
+ * @note Викликається через PROFILER_INIT() з initialize_hardware()
+ */
+void profiler_init(void);
+
+/**
+ * @brief Початок проходу зони (час входу)
+ *
+ * @param[in] zone Зона (ProfilerZone)
+ *
+ * @note Зони можуть бути вкладеними, але не рекурсивними
+ */
+void profiler_enter(uint8_t zone);
+
+/**
+ * @brief Кінець проходу зони (накопичення статистики)
+ *
+ * @param[in] zone Зона (ProfilerZone)
+ *
+ * @warning Прохід довший за 65535 тактів (~4 мс) рахується
+ *          за модулем 2^16
+ * @note Час включає виклики profiler_enter()/profiler_exit()
+ *       (кілька десятків тактів)
+ */
+void profiler_exit(uint8_t zone);
+
+/**
+ * @brief Статистика зони
+ *
+ * @param[in]  zone  Зона (ProfilerZone)
+ * @param[out] stats Кількість, сумарний та найбільший час
+ */
+void profiler_get_stats(uint8_t zone, ProfilerZoneStats *stats);
+
+/**
+ * @brief Очищення статистики всіх зон
+ */
+void profiler_reset(void);
+
+#endif /* PROFILER_ENABLE */
+
+#endif /* __PROFILER_H */
@@ -0,0 +1,106 @@
+/**
+ * @file    spsc_queue.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Кільцевий буфер "один виробник - один споживач" (SPSC)
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Передача даних між обробником переривання та основним
+ * циклом без заборони переривань:
+ * - head змінює лише виробник, tail - лише споживач
+ * - Індекси однобайтні: читання та запис атомарні на STM8
+ * - Індекси вільно переповнюються (mod 256), позиція в буфері -
+ *   індекс & (capacity - 1), тому всі capacity комірок корисні
+ * - Виробник спершу пише елемент, потім head; споживач спершу
+ *   читає елемент, потім tail (буфер volatile - компілятор
+ *   не переставляє ці доступи)
+ *
+ * Модуль не знає типу елемента: драйвери обгортають його
+ * типізованими функціями (hcsr04_read_sample(), get_button_event(),
+ * uart1_tx_string()).
+ *
+ * Використання RAM: 6 байт на чергу + capacity * element_size
+ */
+
+#ifndef __SPSC_QUEUE_H
+#define __SPSC_QUEUE_H
+
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Максимальна ємність черги
+ *
+ * Різниця однобайтних індексів має розрізняти порожню
+ * (0) та повну (capacity) чергу.
+ */
+#define SPSC_QUEUE_MAX_CAPACITY     128
+
+//==================== TYPES ===========================
+
+/**
+ * @brief Стан черги
+ *
+ * @note Поля не змінювати напряму, лише через spsc_queue_*()
+ */
+typedef struct {
+    volatile uint8_t *buffer;   /**< Пам'ять елементів (capacity * element_size) */
+    uint8_t element_size;       /**< Розмір елемента, байт */
+    uint8_t mask;               /**< capacity - 1 */
+    volatile uint8_t head;      /**< Лічильник записаних елементів (виробник) */
+    volatile uint8_t tail;      /**< Лічильник прочитаних елементів (споживач) */
+} SpscQueue;
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Ініціалізація порожньої черги
+ *
+ * @param[out] queue        Черга
+ * @param[in]  storage      Пам'ять під елементи (capacity * element_size байт)
+ * @param[in]  element_size Розмір елемента, байт
+ * @param[in]  capacity     Ємність: степінь двійки, не більше SPSC_QUEUE_MAX_CAPACITY
+ *
+ * @warning Викликати до того, як виробник або споживач
+ *          почнуть працювати з чергою
+ */
+void spsc_queue_init(SpscQueue *queue, void *storage, uint8_t element_size, uint8_t capacity);
+
+/**
+ * @brief Запис елемента (лише виробник)
+ *
+ * @param[in,out] queue   Черга
+ * @param[in]     element Елемент (element_size байт)
+ *
+ * @return Результат запису
+ * @retval 1 Елемент записано
+ * @retval 0 Черга повна, елемент відкинуто
+ */
+uint8_t spsc_queue_push(SpscQueue *queue, const void *element);
+
+/**
+ * @brief Зчитування найстарішого елемента (лише споживач)
+ *
+ * @param[in,out] queue   Черга
+ * @param[out]    element Буфер для елемента (element_size байт)
+ *
+ * @return Результат зчитування
+ * @retval 1 Елемент зчитано
+ * @retval 0 Черга порожня
+ */
+uint8_t spsc_queue_pop(SpscQueue *queue, void *element);
+
+/**
+ * @brief Кількість елементів у черзі
+ *
+ * @param[in] queue Черга
+ * @return Кількість елементів (0 - capacity)
+ *
+ * @note Знімок: інша сторона може змінити значення одразу
+ *       після зчитування
+ */
+uint8_t spsc_queue_count(const SpscQueue *queue);
+
+#endif /* __SPSC_QUEUE_H */
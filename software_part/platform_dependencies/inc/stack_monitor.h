@@ -0,0 +1,63 @@
+/**
+ * @file    stack_monitor.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Найбільша глибина стеку (high-water mark)
+ * @date    17.10.2026
+ * @version 1.0
+ *
+ * Стек - STACK_MONITOR_BOTTOM..STACK_MONITOR_TOP (build.bat:
+ * __endmem + 1 .. __stack), росте вниз. При запуску вільна частина
+ * заповнюється STACK_MONITOR_PATTERN, найнижчий змінений байт
+ * показує найбільшу глибину з моменту запуску.
+ *
+ * Глибина - основний цикл (задача планувальника з найглибшим
+ * ланцюгом викликів) плюс одне переривання: пріоритети ITC не
+ * змінюються, всі обробники на рівні 3 і не вкладаються. Значення
+ * нижнє: переривання мало прийти саме в найглибшій точці.
+ *
+ * Використання RAM: 0 байт (лише сам стек)
+ */
+
+#ifndef __STACK_MONITOR_H
+#define __STACK_MONITOR_H
+
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Межі стеку - мають збігатися з build.bat (__endmem, __stack)
+ */
+#define STACK_MONITOR_BOTTOM    0x0280
+#define STACK_MONITOR_TOP       0x03FF
+#define STACK_MONITOR_SIZE      (STACK_MONITOR_TOP - STACK_MONITOR_BOTTOM + 1)
+
+/**
+ * @brief Байт заповнення вільного стеку
+ */
+#define STACK_MONITOR_PATTERN   ((uint8_t)0xA5)
+
+/**
+ * @brief Байти над кадром stack_monitor_init(), які не заповнюються
+ */
+#define STACK_MONITOR_GUARD     16
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Заповнення вільного стеку STACK_MONITOR_PATTERN
+ *
+ * @note Викликається першою в main-циклі, до дозволу переривань
+ */
+void stack_monitor_init(void);
+
+/**
+ * @brief Найбільша глибина стеку з моменту запуску
+ *
+ * @return Байт стеку, що використовувались (STACK_MONITOR_SIZE -
+ *         стек вичерпано, можливий вихід за межу)
+ */
+uint16_t stack_monitor_peak(void);
+
+#endif /* __STACK_MONITOR_H */
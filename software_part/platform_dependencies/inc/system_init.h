@@ -16,6 +16,9 @@
 #include "display.h"
 #include "distance_sensor.h"
 #include "logger.h"
+#include "systick.h"
+#include "profiler.h"
+#include "scheduler.h"
 //================== FUNCTION PROTOTYPES ==================
 
 /**
@@ -27,8 +30,11 @@
  * 
  * Виконувані операції:
  * 1. Налаштування системного годинника (HSI 16 МГц)
- * 2. Ініціалізація таймерів для затримок (TIM4)
- * 3. Базова конфігурація периферії
+ * 2. Запуск системного тіку 1 мс (TIM4)
+ * 3. Облік причини скидання (таблиця монітора дедлайнів)
+ * 4. Базова конфігурація периферії
+ * 5. Глобальний дозвіл переривань
+ * 6. Логер (звіт про причину скидання та перевищення)
  * 
  * @note Має викликатись ПЕРШОЮ при старті програми
  * 
@@ -37,7 +43,7 @@
  * 
  * 
  * @see enable_system_clock()
- * @see enable_delay_timer()
+ * @see systick_init()
  */
 void initialize_hardware(void);
 
@@ -0,0 +1,113 @@
+/**
+ * @file    systick.h
+ * @author  Olexandr Makedonskyi
+ * @brief   HAL системного таймера (1 мс) на базі TIM4
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Модуль формує монотонний мілісекундний годинник для
+ * планувальника задач та затримок.
+ *
+ * Апаратна конфігурація:
+ * - Таймер: TIM4, prescaler /64 → 250 кГц (4 мкс per tick)
+ * - ARR = 249 → переривання оновлення кожну 1 мс
+ * - Переривання TIM4 Update (IRQ23) інкрементує лічильник мс
+ *   та запускає конверсії ADC (adc_trigger_tick())
+ *
+ * Дрібна роздільна здатність (4 мкс) доступна через
+ * systick_us(): лічильник мс + поточне значення TIM4_CNTR.
+ *
+ * @note TIM4 не використовується для polling-затримок:
+ *       DELAY_SHORT_US() рахує такти CPU (delays.c)
+ */
+
+#ifndef __SYSTICK_H
+#define __SYSTICK_H
+
+//==================== INCLUDES ========================
+
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Номер вектора переривання TIM4 Update/Overflow
+ *
+ * Використовується в таблиці векторів (stm8_interrupt_vector.c).
+ */
+#define SYSTICK_TIM4_UPDATE_IRQ_NUMBER  23
+
+/**
+ * @brief Тривалість одного тіку TIM4 в мікросекундах
+ */
+#define SYSTICK_US_PER_COUNT            4
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Ініціалізація та запуск системного таймера
+ *
+ * Налаштовує TIM4 на переривання кожну 1 мс та скидає
+ * лічильник часу. Лічильник починає рахувати після
+ * глобального дозволу переривань.
+ *
+ * @note Викликається з initialize_hardware()
+ */
+void systick_init(void);
+
+/**
+ * @brief Час від запуску в мілісекундах
+ *
+ * @return Монотонний лічильник мс (переповнюється через
+ *         ~49 діб, різниця двох значень залишається коректною)
+ *
+ * @note Ненадовго забороняє переривання та відновлює їх
+ *       попередній стан: безпечно до глобального дозволу
+ *       переривань. З обробників дешевше systick_ms_isr()
+ */
+uint32_t systick_ms(void);
+
+/**
+ * @brief Час від запуску в мілісекундах (з обробника переривання)
+ *
+ * @return Монотонний лічильник мс
+ *
+ * @warning Лише з обробників переривань того ж рівня, що й
+ *          TIM4 (за замовчуванням - всі): вони не витісняють
+ *          одне одного, тому читання без заборони атомарне
+ */
+uint32_t systick_ms_isr(void);
+
+/**
+ * @brief Час від запуску в мікросекундах (роздільна здатність 4 мкс)
+ *
+ * Переповнення TIM4, яке ще не оброблене перериванням,
+ * враховується через прапорець UIF.
+ *
+ * @return Час в мікросекундах (переповнюється через ~71 хв,
+ *         різниця двох значень залишається коректною)
+ *
+ * @note Ненадовго забороняє переривання та відновлює їх
+ *       попередній стан
+ */
+uint32_t systick_us(void);
+
+/**
+ * @brief Очікування наступного переривання в режимі WAIT (wfi)
+ *
+ * CPU зупиняється, периферія (TIM2, TIM4, UART) працює.
+ * Системний тік гарантує пробудження не пізніше ніж через 1 мс.
+ *
+ * @warning Переривання мають бути дозволені, інакше CPU
+ *          не прокинеться
+ */
+void systick_idle_wait(void);
+
+/**
+ * @brief Обробник переривання TIM4 Update (системний тік)
+ *
+ * @note Вказується у таблиці векторів як irq23
+ */
+INTERRUPT_HANDLER(systick_tim4_update_irq_handler, SYSTICK_TIM4_UPDATE_IRQ_NUMBER);
+
+#endif /* __SYSTICK_H */
@@ -105,7 +105,8 @@
  * @brief Команда встановлення адреси
  * 
  * 0xC0: Початкова адреса дисплея (розряд 0).
- * Можна використовувати 0xC0-0xC3 для окремих розрядів.
+ * Можна використовувати 0xC0-0xC3 для окремих розрядів
+ * (TM1637_CMD_ADDR_START + номер розряду).
  */
 #define TM1637_CMD_ADDR_START   0xC0
 
@@ -176,39 +177,45 @@ void tm1637_gpio_init(void);
  * @param[in] brightness Рівень яскравості (0-7)
  *                       Якщо > 7, буде обмежено до 7
  * 
+ * @return Статус ACK від TM1637
+ * @retval 0 Команду прийнято
+ * @retval 1 NACK (TM1637 не відповідає)
+ * 
  * @note Зміна яскравості відбувається миттєво
  * @note Команда також увімкає дисплей (Display ON)
  * 
  * @see tm1637_write_segments()
  */
-void tm1637_set_brightness(uint8_t brightness);
+uint8_t tm1637_set_brightness(uint8_t brightness);
 
 /**
- * @brief Запис послідовності сегментів на дисплей
+ * @brief Запис сегментів у суцільний діапазон розрядів
  * 
- * Відправляє масив 7-сегментних кодів для відображення
- * на всіх 4 розрядах дисплея.
+ * Відправляє 7-сегментні коди для розрядів first..first+count-1,
+ * решта розрядів не змінюється. Один змінений розряд коштує
+ * 3 байти на шині замість 6 для всього дисплея.
  * 
  * Послідовність команд:
  * 1. START
  * 2. Data command (0x40) - режим автоінкременту адреси
  * 3. STOP
  * 4. START
- * 5. Address command (0xC0) - початкова адреса (розряд 0)
- * 6. 4 байти сегментів (digit 0-3)
+ * 5. Address command (0xC0 + first) - адреса першого розряду
+ * 6. count байт сегментів
  * 7. STOP
  * 
  * Формат сегментного коду:
  * - Біти 0-6: Сегменти A-G
  * - Біт 7: Десяткова крапка (DP)
  * 
- * @param[in] segments Вказівник на масив з 4 байт сегментів
- *                     segments[0] = розряд 0 (лівий)
- *                     segments[1] = розряд 1
- *                     segments[2] = розряд 2
- *                     segments[3] = розряд 3 (правий)
+ * @param[in] first    Перший розряд (0 - лівий, 3 - правий)
+ * @param[in] segments Сегменти розрядів first, first+1, ...
+ * @param[in] count    Кількість розрядів (first + count <= 4)
+ * 
+ * @return Статус ACK від TM1637
+ * @retval 0 Всі байти прийнято
+ * @retval 1 NACK хоча б на одному байті (вміст дисплея невідомий)
  * 
- * @warning Масив segments має містити рівно 4 байти
  * @warning Вказівник segments не може бути NULL
  * 
  * @note Функція не змінює яскравість дисплея
@@ -216,11 +223,14 @@ void tm1637_set_brightness(uint8_t brightness);
  * @code
  * // Приклад: Відображення "1234"
  * uint8_t segments[4] = {0x06, 0x5B, 0x4F, 0x66};
- * tm1637_write_segments(segments);
+ * tm1637_write_segments(0, segments, 4);
+ * // Лише правий розряд: "1235"
+ * segments[3] = 0x6D;
+ * tm1637_write_segments(3, &segments[3], 1);
  * @endcode
  * 
  * @see tm1637_set_brightness()
  */
-void tm1637_write_segments(const uint8_t *segments);
+uint8_t tm1637_write_segments(uint8_t first, const uint8_t *segments, uint8_t count);
 
 #endif /* __TM1637_HAL_H */
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+ * @file    watchdog.h
+ * @author  Olexandr Makedonskyi
+ * @brief   HAL незалежного сторожового таймера (IWDG)
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Апаратна конфігурація:
+ * - Тактування: LSI 128 кГц (±12%), /2 в IWDG та prescaler /256
+ * - RLR = WATCHDOG_RELOAD → таймаут ~(RLR + 1) * 4 мс
+ * - Після запуску IWDG неможливо зупинити до скидання
+ *
+ * Рішення про оновлення приймає монітор дедлайнів
+ * планувальника (scheduler.c).
+ */
+
+#ifndef __WATCHDOG_H
+#define __WATCHDOG_H
+
+//==================== INCLUDES ========================
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Значення перезавантаження IWDG (1-255)
+ *
+ * 255 → ~1.02 с (LSI -12% - не менше ~0.9 с): дедлайни задач
+ * (TASK_DEADLINE_MS, 100 мс) значно коротші, найдовша легальна
+ * блокуюча операція - запис калібрування в EEPROM (~25 мс).
+ * Вивід у лог не блокує.
+ */
+#ifndef WATCHDOG_RELOAD
+#define WATCHDOG_RELOAD         255
+#endif
+
+#if (WATCHDOG_RELOAD < 1) || (WATCHDOG_RELOAD > 255)
+#error "WATCHDOG_RELOAD must be in range 1..255"
+#endif
+
+/**
+ * @brief Номінальний таймаут IWDG, мс
+ */
+#define WATCHDOG_TIMEOUT_MS     ((WATCHDOG_RELOAD + 1) * 4)
+
+/**
+ * @brief Прапорці причини скидання (RST_SR)
+ */
+#define WATCHDOG_RESET_IWDG     RST_SR_IWDGF    /**< Сторожовий таймер IWDG */
+#define WATCHDOG_RESET_ILLOP    RST_SR_ILLOPF   /**< Недопустимий код операції */
+#define WATCHDOG_RESET_SWIM     RST_SR_SWIMF    /**< Програматор (SWIM) */
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Запуск IWDG з таймаутом WATCHDOG_TIMEOUT_MS
+ *
+ * @warning Після виклику watchdog_refresh() має викликатись
+ *          частіше за таймаут, інакше MCU скидається
+ */
+void watchdog_init(void);
+
+/**
+ * @brief Перезавантаження лічильника IWDG
+ */
+void watchdog_refresh(void);
+
+/**
+ * @brief Причина останнього скидання
+ *
+ * Зчитує та очищує RST_SR, тому повертає прапорці лише
+ * при першому виклику після скидання.
+ *
+ * @return Маска WATCHDOG_RESET_* (0 - живлення або NRST)
+ */
+uint8_t watchdog_take_reset_flags(void);
+
+#endif /* __WATCHDOG_H */
@@ -10,45 +10,234 @@
  * конверсії та зчитування результатів.
  * 
  * Особливості реалізації:
- * - Синхронний (блокуючий) режим роботи
+ * - Пачки конверсій з фіксованою частотою (системний тік), без polling
+ * - Пачка: буферизований безперервний режим, одне переривання EOC
+ *   на ADC_BUFFER_SIZE конверсій, середнє останніх ADC_BURST_SIZE
  * - Одноканальне зчитування
- * - Ручне керування конверсією
  * - Праве вирівнювання 10-бітного результату
- * 
- * @note Для розширення функціоналу (DMA, переривання, сканування)
- *       необхідно модифікувати initialize_adc()
+ * - Ковзне середнє через суму буфера (O(1) на вибірку)
+ * - Лічильник вибірок як ознака оновлення: основний цикл
+ *   читає 16-бітне середнє без заборони переривань
+ * - Режим очікування: безперервні конверсії + AWD, CPU
+ *   не прокидається до виходу напруги за поріг
  */
 
 
 //==================== INCLUDES ========================
 
 #include "adc.h"
+#include "critical_section.h"
+
+//==================== DEFINES =========================
+
+#define ADC_FILTER_MASK     (ADC_FILTER_SIZE - 1)
+
+/**
+ * @brief Кількість регістрів буфера даних (DB0R-DB9R)
+ */
+#define ADC_BUFFER_SIZE     10
+
+/**
+ * @brief Перші конверсії пачки, що відкидаються
+ * 
+ * Після простою конденсатор вибірки ще встановлюється,
+ * крім того DB0R може бути перезаписаний конверсією, що
+ * завершилась вже після зупинки.
+ */
+#define ADC_BURST_SKIP      (ADC_BUFFER_SIZE - ADC_BURST_SIZE)
+
+/**
+ * @brief CR1 без запуску: дільник та живлення ADC
+ * 
+ * CR1 пишеться цілим байтом: кожен запис з ADON = 1
+ * запускає конверсію, тому CONT та ADON ставляться одним записом.
+ */
+#define ADC1_CR1_CONFIG     ((uint8_t)((ADC_PRESCALER << 4) | ADC1_CR1_ADON))
+
+//============= STATIC INTERNAL VARIABLES ==============
+
+/* Останні вибірки (кільцевий буфер, пише лише ISR) */
+static uint16_t             adc_samples[ADC_FILTER_SIZE];
+static uint8_t              adc_index;
+static uint16_t             adc_sum;
+
+/* Середнє та лічильник вибірок (пише ISR, читає основний цикл) */
+static volatile uint16_t    adc_filtered;
+static volatile uint8_t     adc_sample_count;
+
+/* Відлік періоду запуску конверсій (переривання тіку) */
+static uint8_t              adc_tick_count;
+
+/* Споживач кожної вибірки (дебаунс кнопок) */
+static AdcSampleHandler     adc_sample_handler;
+
+/* Режим очікування на AWD (тік не запускає конверсії) */
+static volatile uint8_t     adc_watching;
+
+/* Перша пачка після очікування заповнює весь фільтр */
+static uint8_t              adc_refill;
+
+//============= STATIC FUNCTION PROTOTYPES =============
+
+static uint16_t adc_read_burst(void);
+static void adc_filter_fill(uint16_t value);
+static void adc_stop(void);
 
 //============ PUBLIC FUNCTIONS =========================
 
 
 void initialize_adc(void){
 	// Налаштовуємо АЦП
-	ADC1->CSR |= 	ADC1_CHANNEL_3; 		 // Вибір каналу для зчитування (Channel 3)
+	ADC1->CSR = 	ADC1_CHANNEL_3;			 // Канал 3, переривання вмикає запуск пачки
 	ADC1->CR2 = 	ADC1_CR2_ALIGN; 		 // Налаштування правого вирівнювання (LSB у молодшому регістрі)
-	ADC1->CR1 = 	ADC1_CR1_ADON; 			 // Увімкнення живлення ADC
+	ADC1->CR1 = 	ADC1_CR1_CONFIG;		 // Дільник SPSEL та увімкнення живлення ADC
+	adc_refill = 1;
+}
+
+
+void adc_trigger_tick(void){
+	if (adc_watching) {
+		return;
+	}
+	if (++adc_tick_count < ADC_SAMPLE_PERIOD_MS) {
+		return;
+	}
+	adc_tick_count = 0;
+	
+	// Пачка: безперервні конверсії в буфер, EOC - коли буфер заповнений
+	ADC1->CR3 = ADC1_CR3_DBUF;				 // Також скидає OVR
+	ADC1->CSR = ADC1_CHANNEL_3 | ADC1_CSR_EOCIE;
+	ADC1->CR1 = ADC1_CR1_CONFIG | ADC1_CR1_CONT;
+}
+
+
+uint16_t adc_get_filtered(void){
+	uint16_t value;
+	uint8_t count;
+	
+	// Повтор, якщо між зчитуванням байтів середнього прийшла нова вибірка
+	do {
+		count = adc_sample_count;
+		value = adc_filtered;
+	} while (count != adc_sample_count);
+	
+	return value;
 }
 
 
-void adc_start_single_conversion(void){
-	ADC1->CR1 |= ADC1_CR1_ADON;				 // Запуск конверсії (повторне встановлення біту ADON)
+void adc_set_sample_handler(AdcSampleHandler handler){
+	adc_sample_handler = handler;
 }
 
 
-uint16_t adc_read(void){
+void adc_watch_above(uint16_t threshold){
+	adc_watching = 1;
+	
+	ADC1->HTRH = (uint8_t)(threshold >> 2);	 // Поріг: старші 8 біт в HTRH, молодші 2 - в HTRL
+	ADC1->HTRL = (uint8_t)(threshold & 0x03);
+	ADC1->LTRH = (uint8_t)(ADC_WATCH_LOW_THRESHOLD >> 2);
+	ADC1->LTRL = (uint8_t)(ADC_WATCH_LOW_THRESHOLD & 0x03);
+	ADC1->AWCRL = (uint8_t)(1 << ADC1_CHANNEL_3);
+	
+	ADC1->CR3 = 0;							 // Без буфера: AWD перевіряє кожну конверсію
+	ADC1->CSR = ADC1_CHANNEL_3 | ADC1_CSR_AWDIE; // Переривання лише від AWD, прапорці скинуті
+	ADC1->CR1 = ADC1_CR1_CONFIG | ADC1_CR1_CONT; // Запуск безперервних конверсій
+}
+
+
+void adc_watch_cancel(void){
+	uint8_t cc;
+	
+	CRITICAL_SECTION_ENTER(cc);
+	if (adc_watching) {
+		adc_stop();
+	}
+	CRITICAL_SECTION_EXIT(cc);
+}
+
+
+INTERRUPT_HANDLER(adc1_eoc_irq_handler, ADC1_IRQ_NUMBER) {
 	uint16_t result;
-	while ((ADC1->CSR & ADC1_CSR_EOC) == 0); // Очікування завершення конверсії (polling EOC)
-	ADC1->CSR &= ~ADC1_CSR_EOC;				 // Скидання прапорця завершення
+	uint8_t index = adc_index;
+	
+	if (ADC1->CSR & ADC1_CSR_AWD) {
+		// Активність на вході: наступний тік запустить пачку
+		adc_stop();
+		return;
+	}
+	
+	ADC1->CR1 = ADC1_CR1_CONFIG;			 // Зупинка безперервних конверсій
+	ADC1->CSR = ADC1_CHANNEL_3;				 // Скидання EOC, переривання до наступної пачки вимкнене
+	result = adc_read_burst();
+	
+	if (adc_refill) {
+		// Вибірки до простою не затримують реакцію фільтра
+		adc_refill = 0;
+		adc_filter_fill(result);
+	} else {
+		// Ковзна сума: найстаріша вибірка замінюється новою
+		adc_sum = adc_sum - adc_samples[index] + result;
+		adc_samples[index] = result;
+		adc_index = (uint8_t)((index + 1) & ADC_FILTER_MASK);
+	}
 	
-	result = ADC1->DRL;						 // Зчитування результату (молодший байт ПЕРШИМ!)
-	result |= (ADC1->DRH << 8);
+	adc_filtered = adc_sum / ADC_FILTER_SIZE;
+	adc_sample_count++;
+	
+	if (adc_sample_handler != 0) {
+		adc_sample_handler(adc_sum / ADC_FILTER_SIZE);
+	}
+}
 
-	return result;
+//============ STATIC FUNCTIONS =========================
+
+/**
+ * @brief Заповнення буфера фільтра одним значенням
+ * 
+ * @param[in] value Вибірка (0-1023)
+ */
+static void adc_filter_fill(uint16_t value){
+	uint8_t i;
+	
+	for (i = 0; i < ADC_FILTER_SIZE; ++i) {
+		adc_samples[i] = value;
+	}
+	adc_sum = (uint16_t)(value * ADC_FILTER_SIZE);
 }
 
 
+/**
+ * @brief Середнє останніх ADC_BURST_SIZE конверсій пачки
+ * 
+ * @return 10-бітне значення (0-1023)
+ */
+static uint16_t adc_read_burst(void){
+	volatile uint8_t *buffer = &ADC1->DB0RH + 2 * ADC_BURST_SKIP;
+	uint16_t sum = 0;
+	uint16_t value;
+	uint8_t i;
+	
+	for (i = 0; i < ADC_BURST_SIZE; ++i) {
+		value = buffer[1];					 // DBxRL (молодший байт ПЕРШИМ!)
+		value |= (uint16_t)buffer[0] << 8;	 // DBxRH
+		sum += value;
+		buffer += 2;
+	}
+	
+	return sum / ADC_BURST_SIZE;
+}
+
+
+/**
+ * @brief Вихід з очікування на AWD
+ * 
+ * Зупиняє безперервні конверсії та вимикає переривання ADC.
+ * Наступний тік одразу запускає пачку, яка заповнить фільтр.
+ */
+static void adc_stop(void){
+	ADC1->CR1 = ADC1_CR1_CONFIG;
+	ADC1->CSR = ADC1_CHANNEL_3;
+	adc_watching = 0;
+	adc_refill = 1;
+	adc_tick_count = (uint8_t)(ADC_SAMPLE_PERIOD_MS - 1);
+}
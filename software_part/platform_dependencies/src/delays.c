@@ -5,38 +5,37 @@
  * @date    13.01.2026
  * @version 1.0
  * 
- * * Файл містить низькорівневу реалізацію затримок на базі
- * периферійного таймера TIM4 мікроконтролера STM8.
+ * Цикл _delay_loops() - асемблерна функція з фіксованою
+ * послідовністю інструкцій: компілятор (+debug -no) не
+ * додає до неї пролог, збереження аргументу в стек чи
+ * інший код, тому кількість тактів відповідає delays.h.
+ * 
+ * Виклик за угодою Cosmic (+mods0): аргумент uint8_t - в A,
+ * виклик - call, повернення - ret. Ім'я C-функції в
+ * асемблері - з префіксом '_'.
  */
 
 //==================== INCLUDES ========================
 #include "delays.h"
 
-
-//==================== DEFINES =================
-
-#define TIM4_PRESCALER_1    ((uint8_t)0x00)
-#define TIM4_CR1_CEN        ((uint8_t)0x01)
-#define TIM4_SR1_UIF        ((uint8_t)0x01)
-
 //============ PUBLIC FUNCTIONS IMPLEMENTATION =========
 
-void _delay_us(uint16_t microseconds) {
-    /* Цикл зменшення лічильника. 
-       Логіка базується на очікуванні прапора Update Interrupt Flag (UIF) */
-    for (; microseconds > 1; --microseconds) {
-        /* Очікування встановлення прапора переповнення */
-        while ((TIM4->SR1 & TIM4_SR1_UIF) == 0);
-        /* Очищення прапора перед очікуванням*/
-        TIM4->SR1 &= ~TIM4_SR1_UIF;
-    }
-}
+#ifdef _COSMIC_
+
+/*
+ * void _delay_loops(uint8_t loops), loops - в A.
+ * Ітерація: nop (1) + dec a (1) + jrne (2) = DELAY_LOOP_CYCLES
+ */
+#asm
+	xdef	__delay_loops
+	switch	.text
+__delay_loops:
+	nop
+	dec	a
+	jrne	__delay_loops
+	ret
+#endasm
 
-void _delay_ms(uint16_t milliseconds)
-{
-    while (milliseconds)
-    {
-        _delay_us(1000);
-        milliseconds--;
-    }
-}
+#else
+#error "_delay_loops() is implemented for the Cosmic compiler only"
+#endif /* _COSMIC_ */
@@ -0,0 +1,107 @@
+/**
+ * @file    eeprom.c
+ * @brief   Реалізація HAL вбудованої data EEPROM
+ * @author  Olexandr Makedonskyi
+ *
+ * EEPROM читається як звичайна пам'ять. Запис: розблокування
+ * ключами DUKR, режим запису слова (CR2/NCR2), чотири
+ * послідовні байти, очікування EOP.
+ */
+
+//==================== INCLUDES ========================
+
+#include "eeprom.h"
+
+//==================== DEFINES =========================
+
+#define EEPROM_KEY_1            ((uint8_t)0xAE)     /**< Перший ключ DUKR */
+#define EEPROM_KEY_2            ((uint8_t)0x56)     /**< Другий ключ DUKR */
+
+/**
+ * @brief Межа очікування EOP, ітерацій (~20 мс при 16 МГц)
+ */
+#define EEPROM_TIMEOUT          ((uint16_t)0xFFFF)
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static uint8_t eeprom_write_word(volatile uint8_t *target, const uint8_t *source);
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void eeprom_read(uint16_t offset, void *data, uint8_t size) {
+    const volatile uint8_t *source = (const volatile uint8_t *)(EEPROM_START_ADDRESS + offset);
+    uint8_t *target = (uint8_t *)data;
+
+    while (size != 0) {
+        *target++ = *source++;
+        size--;
+    }
+}
+
+
+uint8_t eeprom_write(uint16_t offset, const void *data, uint8_t size) {
+    volatile uint8_t *target = (volatile uint8_t *)(EEPROM_START_ADDRESS + offset);
+    const uint8_t *source = (const uint8_t *)data;
+    uint8_t result = 1;
+
+    if ((offset % EEPROM_WORD_SIZE) != 0 || (size % EEPROM_WORD_SIZE) != 0 ||
+        (uint16_t)(offset + size) > EEPROM_SIZE) {
+        return 0;
+    }
+
+    FLASH->DUKR = EEPROM_KEY_1;
+    FLASH->DUKR = EEPROM_KEY_2;
+    if ((FLASH->IAPSR & FLASH_IAPSR_DUL) == 0) {
+        return 0;
+    }
+
+    while (size != 0 && result) {
+        result = eeprom_write_word(target, source);
+        target += EEPROM_WORD_SIZE;
+        source += EEPROM_WORD_SIZE;
+        size -= EEPROM_WORD_SIZE;
+    }
+
+    FLASH->IAPSR &= (uint8_t)~FLASH_IAPSR_DUL;
+    return result;
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Запис одного слова (пропускається, якщо не змінилось)
+ *
+ * @param[in] target Адреса слова в EEPROM
+ * @param[in] source 4 байти даних
+ *
+ * @return 1 - слово збігається з даними, 0 - помилка запису
+ */
+static uint8_t eeprom_write_word(volatile uint8_t *target, const uint8_t *source) {
+    uint16_t timeout = EEPROM_TIMEOUT;
+    uint8_t status;
+
+    if (target[0] == source[0] && target[1] == source[1] &&
+        target[2] == source[2] && target[3] == source[3]) {
+        return 1;
+    }
+
+    FLASH->CR2 = FLASH_CR2_WPRG;
+    FLASH->NCR2 = (uint8_t)~FLASH_NCR2_NWPRG;
+    target[0] = source[0];
+    target[1] = source[1];
+    target[2] = source[2];
+    target[3] = source[3];
+
+    // Читання IAPSR скидає EOP та WR_PG_DIS
+    do {
+        status = FLASH->IAPSR;
+    } while ((status & (FLASH_IAPSR_EOP | FLASH_IAPSR_WR_PG_DIS)) == 0 && --timeout != 0);
+
+    if ((status & FLASH_IAPSR_EOP) == 0) {
+        return 0;
+    }
+
+    return (uint8_t)(target[0] == source[0] && target[1] == source[1] &&
+                     target[2] == source[2] && target[3] == source[3]);
+}
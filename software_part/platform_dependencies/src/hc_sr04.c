@@ -11,102 +11,241 @@
  * Особливості реалізації:
  * - Input Capture режим таймера для точного вимірювання
  * - Програмна затримка для тригерного імпульсу
- * - Polling режим очікування фронтів
- * - Відновлення стану після таймауту
+ * - Планувальник: TRIG з переривання оновлення TIM2 (фіксований період)
+ * - Захоплення фронтів у перериванні TIM2 CC (без polling)
+ * - Апаратний дедлайн на каналі порівняння TIM2_CH1
+ * - Lock-free черга результатів spsc_queue (ISR → основний цикл)
+ * - Дільник тригерів: TRIG лише в кожному N-му періоді
+ * - Мікросекундний час від старту планувальника (база + CNT TIM2)
+ * - До HCSR04_SENSOR_COUNT датчиків по черзі (round-robin):
+ *   в кожному періоді активний лише один датчик
  * 
  * Тайминг операцій:
- * - Тригерний імпульс: 10 мкс
- * - Очікування rising edge: до timeout_us
- * - Очікування falling edge: до timeout_us
- * - Загальний час: 20 мкс + час відбиття (до 30 мс)
+ * - Тригерний імпульс: 10 мкс (в перериванні оновлення)
+ * - Rising/falling edge: обробляються в перериванні
+ * - Таймаут: рівно timeout_us від початку періоду (±1 мкс)
+ * - Період вимірювань: period_us (ARR таймера TIM2)
  */
 
 //==================== INCLUDES ========================
 
 #include "hc_sr04.h"
+#include "critical_section.h"
 
 //============= STATIC INTERNAL FUNCTIONS PROTOTYPES ==============
 
 static void hcsr04_send_trigger(void);
-static void tim2_ch3_enable(void);
+static void hcsr04_start_measurement(void);
+static void hcsr04_finish_measurement(uint8_t status, uint16_t pulse_us);
+static void hcsr04_abort_measurement(void);
+static void hcsr04_capture_select(uint8_t cc_mask, uint8_t falling);
+static uint16_t hcsr04_capture_read(uint8_t cc_mask);
+static void tim2_capture_enable(void);
+
+//============= STATIC INTERNAL VARIABLES ==============
+
+/**
+ * @brief Стани вимірювання в межах одного періоду
+ */
+typedef enum {
+    HCSR04_STATE_IDLE = 0,      /**< Очікування наступного періоду */
+    HCSR04_STATE_WAIT_RISING,   /**< Очікування початку імпульсу ECHO */
+    HCSR04_STATE_WAIT_FALLING   /**< Очікування кінця імпульсу ECHO */
+} HcSr04State;
+
+/**
+ * @brief Апаратні ресурси одного датчика
+ */
+typedef struct {
+    GPIO_TypeDef *trig_port;    /**< Порт TRIG */
+    uint8_t       trig_pin;     /**< Маска піна TRIG */
+    GPIO_TypeDef *echo_port;    /**< Порт ECHO */
+    uint8_t       echo_pin;     /**< Маска піна ECHO */
+    uint8_t       cc_mask;      /**< Канал захоплення: біт CCxIF/CCxIE в TIM2 SR1/IER */
+} HcSr04Sensor;
+
+/* Таблиця датчиків (у flash) */
+static const HcSr04Sensor hcsr04_sensors[HCSR04_SENSOR_COUNT] = {
+    { HCSR04_TRIG_PORT,  HCSR04_TRIG_PIN,  HCSR04_ECHO_PORT,  HCSR04_ECHO_PIN,  TIM2_SR1_CC3IF },
+#if (HCSR04_SENSOR_COUNT > 1)
+    { HCSR04_TRIG2_PORT, HCSR04_TRIG2_PIN, HCSR04_ECHO2_PORT, HCSR04_ECHO2_PIN, TIM2_SR1_CC2IF },
+#endif
+};
+
+static volatile HcSr04State echo_state = HCSR04_STATE_IDLE;
+static volatile uint16_t    echo_rise_time;
+static uint16_t             echo_deadline;
+static uint32_t             echo_trigger_time;
+
+/* Датчик поточного вимірювання та наступний по черзі */
+static uint8_t              echo_sensor;
+static uint8_t              next_sensor;
+
+/* Черга вимірювань: пише ISR, читає основний цикл */
+static HcSr04Sample         sample_storage[HCSR04_SAMPLE_BUFFER_SIZE];
+static SpscQueue            sample_queue;
+
+/* Час від старту планувальника: база оновлюється в перериванні оновлення */
+static volatile uint32_t    ranging_time_base;
+static uint16_t             ranging_period;
+
+/* Дільник тригерів: вимірювання в кожному trigger_divider-му періоді */
+static volatile uint8_t     trigger_divider = 1;
+static uint8_t              trigger_phase;
 
 //============ PUBLIC FUNCTIONS =========================
 
 
 
 void hcsr04_gpio_init(void) {
-    // Налаштування ECHO (PA3) як вхід для TIM2_CH3
-    // DDR=0: вхід
-    // CR1=0: floating (без підтяжки)
-    HCSR04_ECHO_PORT->DDR &= ~HCSR04_ECHO_PIN;
-    HCSR04_ECHO_PORT->CR1 &= ~HCSR04_ECHO_PIN;
-    
-    // Налаштування TRIG (PB4) як вихід Push-Pull High Speed
-    // DDR=1: вихід
-    // CR1=1: Push-Pull
-    // CR2=1: High Speed (10 МГц)
-    HCSR04_TRIG_PORT->DDR |= HCSR04_TRIG_PIN;
-    HCSR04_TRIG_PORT->CR1 |= HCSR04_TRIG_PIN;
-    HCSR04_TRIG_PORT->CR2 |= HCSR04_TRIG_PIN;
-    
-    // Встановлення початкового стану TRIG = LOW
-    HCSR04_TRIG_PORT->ODR &= ~HCSR04_TRIG_PIN;
+    uint8_t i;
+    const HcSr04Sensor *sensor;
+    
+    spsc_queue_init(&sample_queue, sample_storage, sizeof(HcSr04Sample), HCSR04_SAMPLE_BUFFER_SIZE);
+    
+    for (i = 0; i < HCSR04_SENSOR_COUNT; ++i) {
+        sensor = &hcsr04_sensors[i];
+        
+        // Налаштування ECHO як вхід каналу захоплення TIM2
+        // DDR=0: вхід
+        // CR1=0: floating (без підтяжки)
+        sensor->echo_port->DDR &= ~sensor->echo_pin;
+        sensor->echo_port->CR1 &= ~sensor->echo_pin;
+        
+        // Налаштування TRIG як вихід Push-Pull High Speed
+        // DDR=1: вихід
+        // CR1=1: Push-Pull
+        // CR2=1: High Speed (10 МГц)
+        sensor->trig_port->DDR |= sensor->trig_pin;
+        sensor->trig_port->CR1 |= sensor->trig_pin;
+        sensor->trig_port->CR2 |= sensor->trig_pin;
+        
+        // Встановлення початкового стану TRIG = LOW
+        sensor->trig_port->ODR &= ~sensor->trig_pin;
+    }
     
     // Ініціалізація таймера для Input Capture
-    tim2_ch3_enable();
+    tim2_capture_enable();
 }
 
 
-uint16_t hcsr04_measure_pulse(uint32_t timeout_us) {
-    uint16_t rise_time;
-    uint16_t fall_time;
-    uint16_t timeout_counter = 0;
+void hcsr04_ranging_start(uint16_t period_us, uint16_t timeout_us) {
+    // 1. Зупинка таймера та всіх переривань на час переналаштування
+    TIM2->CR1 &= ~TIM2_CR1_CEN;
+    TIM2->IER = 0;
+    echo_state = HCSR04_STATE_IDLE;
+    next_sensor = 0;
+    ranging_period = period_us;
+    ranging_time_base = 0;
+    trigger_phase = 0;
     
-    // 1. Скидання прапорця CC3IF перед початком вимірювання
-    TIM2->SR1 &= ~TIM2_SR1_CC3IF;
+    // 2. Період планувальника: ARR = period_us - 1 (1 тік = 1 мкс)
+    TIM2->ARRH = (uint8_t)((period_us - 1) >> 8);
+    TIM2->ARRL = (uint8_t)(period_us - 1);
     
-    // 2. Налаштування на захоплення rising edge
-    // CCER2 = 0x01: CC3E=1 (enable), CC3P=0 (rising edge)
-    TIM2->CCER2 = 0x01;
+    // 3. Дедлайн ECHO відносно початку періоду (TRIG генерується при CNT≈0)
+    // Запис CCR1: старший байт першим, порівняння вмикається після молодшого
+    TIM2->CCR1H = (uint8_t)(timeout_us >> 8);
+    TIM2->CCR1L = (uint8_t)(timeout_us);
+    echo_deadline = timeout_us;
     
-    // 3. Генерація тригерного імпульсу
-    hcsr04_send_trigger();
+    // 4. Примусове оновлення: завантаження PSCR/ARR та скидання CNT
+    TIM2->EGR = TIM2_EGR_UG;
+    TIM2->SR1 = 0;
     
-    // 4. Очікування rising edge ECHO (початок імпульсу)
-    while ((TIM2->SR1 & TIM2_SR1_CC3IF) == 0) {
-        if (++timeout_counter >= timeout_us) {
-            return 0;  // Таймаут - об'єкт не виявлено
-        }
+    // 5. Увімкнення переривання оновлення та запуск таймера
+    TIM2->IER = TIM2_IER_UIE;
+    TIM2->CR1 |= TIM2_CR1_CEN;
+}
+
+
+void hcsr04_set_trigger_divider(uint8_t divider) {
+    // Однобайтний запис - атомарний відносно переривання
+    trigger_divider = (divider != 0) ? divider : 1;
+}
+
+
+uint32_t hcsr04_time_us(void) {
+    uint32_t base;
+    uint16_t count;
+    uint8_t cc;
+    
+    CRITICAL_SECTION_ENTER(cc);
+    
+    // Старший байт першим: читання CNTRH фіксує CNTRL
+    base = ranging_time_base;
+    count = (uint16_t)TIM2->CNTRH << 8;
+    count |= TIM2->CNTRL;
+    
+    // Переповнення відбулось, але переривання ще не оброблене
+    if (TIM2->SR1 & TIM2_SR1_UIF) {
+        base += ranging_period;
+        count = (uint16_t)TIM2->CNTRH << 8;
+        count |= TIM2->CNTRL;
     }
     
-    // 5. Зчитування часу rising edge (молодший байт першим!)
-    rise_time = (TIM2->CCR3H << 8) | TIM2->CCR3L;
-    
-    // 6. Перемикання на захоплення falling edge
-    // Скидання прапорця перед зміною режиму
-    TIM2->SR1 &= ~TIM2_SR1_CC3IF;
-    // CCER2 = 0x03: CC3E=1 (enable), CC3P=1 (falling edge)
-    TIM2->CCER2 = 0x03;
-    
-    // 7. Очікування falling edge ECHO (кінець імпульсу)
-    timeout_counter = 0;
-    while ((TIM2->SR1 & TIM2_SR1_CC3IF) == 0) {
-        if (++timeout_counter >= timeout_us) {
-            // Таймаут - відновлення початкового стану
-            TIM2->CCER2 = 0x01;
-            return 0;
-        }
+    CRITICAL_SECTION_EXIT(cc);
+    return base + count;
+}
+
+
+uint8_t hcsr04_read_sample(HcSr04Sample *sample) {
+    return spsc_queue_pop(&sample_queue, sample);
+}
+
+
+INTERRUPT_HANDLER(hcsr04_tim2_update_irq_handler, HCSR04_TIM2_UPDATE_IRQ_NUMBER) {
+    TIM2->SR1 = (uint8_t)~TIM2_SR1_UIF;
+    ranging_time_base += ranging_period;
+    
+    // Попереднє вимірювання мало завершитись по дедлайну CC1.
+    // Якщо ні (період < дедлайну) - фіксуємо таймаут.
+    if (echo_state != HCSR04_STATE_IDLE) {
+        hcsr04_abort_measurement();
     }
     
-    // 8. Зчитування часу falling edge (молодший байт першим!)
-    fall_time = (TIM2->CCR3H << 8) | TIM2->CCR3L;
+    // Пропуск періодів при зниженій частоті вимірювань
+    if (++trigger_phase >= trigger_divider) {
+        trigger_phase = 0;
+        hcsr04_start_measurement();
+    }
+}
+
+
+INTERRUPT_HANDLER(hcsr04_tim2_cc_irq_handler, HCSR04_TIM2_CC_IRQ_NUMBER) {
+    uint16_t capture;
+    uint8_t cc_mask = hcsr04_sensors[echo_sensor].cc_mask;
     
-    // 9. Відновлення початкового стану (rising edge для наступного вимірювання)
-    TIM2->CCER2 = 0x01;
+    // Фронт ECHO активного датчика захоплено
+    if (TIM2->SR1 & cc_mask) {
+        // 1. Зчитування захопленого значення (старший байт першим,
+        //    читання молодшого байта апаратно скидає CCxIF; запис SR1
+        //    тут міг би скинути UIF, встановлений між читанням і записом)
+        capture = hcsr04_capture_read(cc_mask);
+        
+        if (echo_state == HCSR04_STATE_WAIT_RISING) {
+            // 2. Rising edge: початок імпульсу, перемикання на falling edge
+            echo_rise_time = capture;
+            hcsr04_capture_select(cc_mask, 1);
+            echo_state = HCSR04_STATE_WAIT_FALLING;
+        } else if (echo_state == HCSR04_STATE_WAIT_FALLING) {
+            // 3. Falling edge: кінець імпульсу
+            // Обидва фронти в межах одного періоду - переповнення неможливе
+            hcsr04_finish_measurement(HCSR04_ECHO_OK, (uint16_t)(capture - echo_rise_time));
+        } else {
+            // Фантомне захоплення поза вимірюванням - ігноруємо
+            TIM2->IER &= ~cc_mask;
+        }
+    }
     
-    // 10. Обчислення тривалості імпульсу
-    // Автоматично враховує переповнення таймера (16-bit arithmetic)
-    return (uint16_t)(fall_time - rise_time);
+    // Дедлайн вимірювання (CC1): ECHO не завершився вчасно
+    if (TIM2->SR1 & TIM2_SR1_CC1IF) {
+        TIM2->SR1 = (uint8_t)~TIM2_SR1_CC1IF;
+        
+        if (echo_state != HCSR04_STATE_IDLE) {
+            hcsr04_abort_measurement();
+        }
+    }
 }
 
 //============= STATIC INTERNAL FUNCTION IMPLEMENTATIONS =======
@@ -132,27 +271,165 @@ uint16_t hcsr04_measure_pulse(uint32_t timeout_us) {
  * @warning Не викликати повторно до завершення попереднього
  *          вимірювання (мінімум 60 мс інтервал)
  * 
- * @see hcsr04_measure_pulse()
+ * @see hcsr04_tim2_update_irq_handler()
  */
 static void hcsr04_send_trigger(void) {
+    const HcSr04Sensor *sensor = &hcsr04_sensors[echo_sensor];
+    
     // 1. Встановлення TRIG = HIGH
-    HCSR04_TRIG_PORT->ODR |= HCSR04_TRIG_PIN;
+    sensor->trig_port->ODR |= sensor->trig_pin;
     
     // 2. Затримка 10 мкс (мінімум за специфікацією HC-SR04)
-    _delay_us(HCSR04_TRIGGER_PULSE_US);
+    DELAY_SHORT_US(HCSR04_TRIGGER_PULSE_US);
     
     // 3. Скидання TRIG = LOW
-    HCSR04_TRIG_PORT->ODR &= ~HCSR04_TRIG_PIN;
+    sensor->trig_port->ODR &= ~sensor->trig_pin;
 }
 
 /**
- * @brief Ініціалізація TIM2 Channel 3 для Input Capture
+ * @brief Запуск вимірювання на початку періоду (з переривання)
+ * 
+ * Вибирає наступний датчик по черзі, налаштовує захоплення
+ * rising edge на його каналі, вмикає переривання захоплення
+ * та дедлайну CC1, після чого генерує тригерний імпульс.
+ * 
+ * В кожному періоді активний лише один датчик, а дедлайн
+ * разом з часом відновлення вкладаються в період, тому
+ * відбиття одного датчика не може бути захоплене іншим.
+ * 
+ * @param[in] None
+ * @retval None
  * 
- * Налаштовує TIM2_CH3 для вимірювання тривалості імпульсу ECHO:
+ * @note Викликається з hcsr04_tim2_update_irq_handler()
+ */
+static void hcsr04_start_measurement(void) {
+    uint8_t cc_mask;
+    
+    // 1. Вибір датчика (round-robin)
+    echo_sensor = next_sensor;
+    if (++next_sensor >= HCSR04_SENSOR_COUNT) {
+        next_sensor = 0;
+    }
+    cc_mask = hcsr04_sensors[echo_sensor].cc_mask;
+    
+    // 2. Захоплення rising edge на каналі датчика
+    hcsr04_capture_select(cc_mask, 0);
+    
+    // 3. Скидання прапорців, що могли залишитись з попереднього періоду
+    //    (rc_w0: одиниці не змінюють прапорці, UIF не втрачається)
+    TIM2->SR1 = (uint8_t)~(TIM2_SR1_CC3IF | TIM2_SR1_CC2IF | TIM2_SR1_CC1IF);
+    echo_state = HCSR04_STATE_WAIT_RISING;
+    echo_trigger_time = ranging_time_base;
+    
+    // 4. Увімкнення переривань захоплення та дедлайну
+    TIM2->IER |= (uint8_t)(cc_mask | TIM2_IER_CC1IE);
+    
+    // 5. Генерація тригерного імпульсу (10 мкс в контексті ISR)
+    hcsr04_send_trigger();
+}
+
+/**
+ * @brief Завершення вимірювання (викликається з переривання)
+ * 
+ * Вимикає переривання CC1 та каналу датчика, відновлює захоплення
+ * rising edge та кладе результат у кільцевий буфер.
+ * 
+ * @param[in] status   Статус захоплення (HcSr04EchoStatus)
+ * @param[in] pulse_us Тривалість імпульсу ECHO в мікросекундах
+ * @retval None
+ * 
+ * @note При переповненні буфера результат відкидається
+ */
+static void hcsr04_finish_measurement(uint8_t status, uint16_t pulse_us) {
+    HcSr04Sample sample;
+    uint8_t cc_mask = hcsr04_sensors[echo_sensor].cc_mask;
+    
+    TIM2->IER &= ~(uint8_t)(cc_mask | TIM2_IER_CC1IE);
+    hcsr04_capture_select(cc_mask, 0);
+    echo_state = HCSR04_STATE_IDLE;
+    
+    sample.timestamp_us = echo_trigger_time;
+    sample.pulse_us = pulse_us;
+    sample.status = status;
+    sample.sensor = echo_sensor;
+    (void)spsc_queue_push(&sample_queue, &sample);
+}
+
+/**
+ * @brief Завершення вимірювання по дедлайну (викликається з переривання)
+ * 
+ * Класифікує незавершене вимірювання:
+ * - очікування rising edge, ECHO в HIGH - лінія "залипла"
+ *   (попередній імпульс не закінчився або несправність)
+ * - очікування rising edge, ECHO в LOW - датчик не відповів
+ * - очікування falling edge - відбиття не повернулось до дедлайну
+ * 
+ * @param[in] None
+ * @retval None
+ */
+static void hcsr04_abort_measurement(void) {
+    const HcSr04Sensor *sensor = &hcsr04_sensors[echo_sensor];
+    
+    if (echo_state == HCSR04_STATE_WAIT_FALLING) {
+        hcsr04_finish_measurement(HCSR04_ECHO_NO_FALL,
+                                  (uint16_t)(echo_deadline - echo_rise_time));
+    } else if (sensor->echo_port->IDR & sensor->echo_pin) {
+        hcsr04_finish_measurement(HCSR04_ECHO_STUCK_HIGH, 0);
+    } else {
+        hcsr04_finish_measurement(HCSR04_ECHO_NO_RISE, 0);
+    }
+}
+
+/**
+ * @brief Вибір фронту захоплення каналу датчика
+ * 
+ * Вмикає захоплення на каналі (CCxE) з потрібною полярністю.
+ * Запис CCER1 для CH2 залишає CC1E=0 (дедлайн без виходу).
+ * 
+ * @param[in] cc_mask Канал захоплення (TIM2_SR1_CC2IF / TIM2_SR1_CC3IF)
+ * @param[in] falling 1 - falling edge, 0 - rising edge
+ * @retval None
+ */
+static void hcsr04_capture_select(uint8_t cc_mask, uint8_t falling) {
+    if (cc_mask == TIM2_SR1_CC2IF) {
+        TIM2->CCER1 = falling ? (uint8_t)(TIM2_CCER1_CC2E | TIM2_CCER1_CC2P)
+                              : TIM2_CCER1_CC2E;
+    } else {
+        TIM2->CCER2 = falling ? (uint8_t)(TIM2_CCER2_CC3E | TIM2_CCER2_CC3P)
+                              : TIM2_CCER2_CC3E;
+    }
+}
+
+/**
+ * @brief Зчитування захопленого значення каналу датчика
+ * 
+ * @param[in] cc_mask Канал захоплення (TIM2_SR1_CC2IF / TIM2_SR1_CC3IF)
+ * @return Значення лічильника в момент фронту
+ */
+static uint16_t hcsr04_capture_read(uint8_t cc_mask) {
+    uint16_t capture;
+    
+    // Старший байт першим
+    if (cc_mask == TIM2_SR1_CC2IF) {
+        capture = (uint16_t)TIM2->CCR2H << 8;
+        capture |= TIM2->CCR2L;
+    } else {
+        capture = (uint16_t)TIM2->CCR3H << 8;
+        capture |= TIM2->CCR3L;
+    }
+    return capture;
+}
+
+/**
+ * @brief Ініціалізація каналів TIM2 для Input Capture
+ * 
+ * Налаштовує канали захоплення датчиків для вимірювання
+ * тривалості імпульсу ECHO:
  * - Prescaler: /16 (16 МГц / 16 = 1 МГц)
  * - Роздільна здатність: 1 мкс
- * - Режим: Input Capture (захоплення фронтів)
+ * - CH3 (датчик 1), CH2 (датчик 2): Input Capture
  * - Auto-reload: максимум (65535 мкс)
+ * - CH1: Output Compare (frozen, вихід вимкнено) для дедлайну
  * @param[in] None
  * 
  * @retval None
@@ -161,7 +438,7 @@ static void hcsr04_send_trigger(void) {
  * 
  * @see hcsr04_gpio_init()
  */
-static void tim2_ch3_enable(void) {
+static void tim2_capture_enable(void) {
     // 1. Зупинка таймера для безпечної конфігурації
     TIM2->CR1 = 0;
     
@@ -183,7 +460,18 @@ static void tim2_ch3_enable(void) {
     // CCMR3 = 0x01: CC3S=01 (TI3 mapped on TI3FP3)
     TIM2->CCMR3 = 0x01;
     
-    // 6. Запуск таймера
+#if (HCSR04_SENSOR_COUNT > 1)
+    // CCMR2 = 0x01: CC2S=01 (TI2 mapped on TI2FP2) для другого датчика
+    TIM2->CCMR2 = 0x01;
+#endif
+    
+    // 6. Налаштування CH1 в режим Output Compare для дедлайну
+    // CCMR1 = 0x00: CC1S=00 (output), OC1M=000 (frozen)
+    // CC1E=0: пін PD4 не керується таймером, лише прапорець CC1IF
+    TIM2->CCMR1 = 0x00;
+    TIM2->CCER1 &= ~TIM2_CCER1_CC1E;
+    
+    // 7. Запуск таймера
     // CEN = 1 (Counter Enable)
     TIM2->CR1 |= 0x01;
 }
\ No newline at end of file
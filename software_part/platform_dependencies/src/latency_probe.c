@@ -0,0 +1,66 @@
+/**
+ * @file    latency_probe.c
+ * @brief   Реалізація вимірювання затримки "кнопка → дисплей"
+ * @author  Olexandr Makedonskyi
+ *
+ * Початок та кінець фіксуються в основному циклі,
+ * тому заборона переривань не потрібна.
+ */
+
+//==================== INCLUDES ========================
+
+#include "latency_probe.h"
+#include "systick.h"
+
+//================ PRIVATE VARIABLES ===================
+
+static LatencyHistogram latency_histogram;
+
+/**
+ * @brief Час фронту активного вимірювання
+ */
+static uint16_t latency_start_ms;
+
+/**
+ * @brief 1 - очікується запис у дисплей
+ */
+static uint8_t  latency_armed;
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void latency_probe_start(uint16_t edge_ms) {
+    if (!latency_armed) {
+        latency_start_ms = edge_ms;
+        latency_armed = 1;
+    }
+}
+
+
+void latency_probe_stop(void) {
+    uint16_t latency_ms;
+    uint16_t bin;
+
+    if (!latency_armed) {
+        return;
+    }
+    latency_armed = 0;
+
+    latency_ms = (uint16_t)systick_ms() - latency_start_ms;
+
+    bin = latency_ms / LATENCY_PROBE_BIN_MS;
+    if (bin >= LATENCY_PROBE_BINS) {
+        bin = LATENCY_PROBE_BINS - 1;
+    }
+    if (latency_histogram.bins[bin] != 0xFFFF) {
+        latency_histogram.bins[bin]++;
+    }
+    if (latency_ms > latency_histogram.max_ms) {
+        latency_histogram.max_ms = latency_ms;
+    }
+}
+
+
+void latency_probe_get(LatencyHistogram *histogram) {
+    *histogram = latency_histogram;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file    profiler.c
+ * @brief   Реалізація профілювання зон коду (TIM1)
+ * @author  Olexandr Makedonskyi
+ *
+ * TIM1 рахує такти CPU по колу (ARR = 0xFFFF), тривалість
+ * проходу - різниця 16-бітних значень лічильника.
+ * Читання CNTRH фіксує CNTRL, тому 16-бітне значення
+ * узгоджене без заборони переривань.
+ */
+
+//==================== INCLUDES ========================
+
+#include "profiler.h"
+
+#ifdef PROFILER_ENABLE
+
+//================ PRIVATE VARIABLES ===================
+
+/**
+ * @brief Стан зони
+ */
+typedef struct {
+    uint32_t count;             /**< Кількість проходів */
+    uint32_t total_cycles;      /**< Сумарний час, такти */
+    uint16_t max_cycles;        /**< Найдовший прохід, такти */
+    uint16_t start;             /**< TIM1 на вході в зону */
+} ProfilerZoneState;
+
+static ProfilerZoneState profiler_zones[PROFILER_ZONE_COUNT];
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static uint16_t profiler_now(void);
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void profiler_init(void) {
+    TIM1->CR1 = 0;
+    TIM1->IER = 0;
+
+    // Без дільника: 1 тік = 1 такт CPU
+    TIM1->PSCRH = 0;
+    TIM1->PSCRL = 0;
+    TIM1->ARRH = 0xFF;
+    TIM1->ARRL = 0xFF;
+
+    // Примусове оновлення: завантаження PSCR та скидання CNTR
+    TIM1->EGR = TIM1_EGR_UG;
+    TIM1->SR1 = 0;
+    TIM1->CR1 = TIM1_CR1_CEN;
+
+    profiler_reset();
+}
+
+
+void profiler_enter(uint8_t zone) {
+    profiler_zones[zone].start = profiler_now();
+}
+
+
+void profiler_exit(uint8_t zone) {
+    ProfilerZoneState *state = &profiler_zones[zone];
+    uint16_t cycles = profiler_now() - state->start;
+
+    state->count++;
+    state->total_cycles += cycles;
+    if (cycles > state->max_cycles) {
+        state->max_cycles = cycles;
+    }
+}
+
+
+void profiler_get_stats(uint8_t zone, ProfilerZoneStats *stats) {
+    stats->count = profiler_zones[zone].count;
+    stats->total_cycles = profiler_zones[zone].total_cycles;
+    stats->max_cycles = profiler_zones[zone].max_cycles;
+}
+
+
+void profiler_reset(void) {
+    uint8_t i;
+
+    for (i = 0; i < PROFILER_ZONE_COUNT; ++i) {
+        profiler_zones[i].count = 0;
+        profiler_zones[i].total_cycles = 0;
+        profiler_zones[i].max_cycles = 0;
+    }
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Поточне значення лічильника тактів
+ *
+ * @return TIM1_CNTR
+ */
+static uint16_t profiler_now(void) {
+    uint16_t now = (uint16_t)TIM1->CNTRH << 8;
+
+    return now | TIM1->CNTRL;
+}
+
+#endif /* PROFILER_ENABLE */
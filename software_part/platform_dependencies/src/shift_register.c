@@ -27,6 +27,7 @@
 //==================== INCLUDES ========================
 
 #include "shift_register.h"
+#include "profiler.h"
 
 //============ PUBLIC FUNCTIONS =========================
 
@@ -57,6 +58,8 @@ void shift_reg_send(uint8_t data) {
     uint8_t i;
     uint8_t mask;
 
+    PROFILER_ENTER(PROFILER_ZONE_SHIFT_REG_SEND);
+
     // Початок транзакції: Latch Low
     SR_PORT->ODR &= ~SR_LATCH_PIN;
 
@@ -80,4 +83,6 @@ void shift_reg_send(uint8_t data) {
     // Дані переносяться з регістру зсуву в регістр зберігання (на вихід)
     SR_PORT->ODR |= SR_LATCH_PIN; 
     SR_PORT->ODR &= ~SR_LATCH_PIN;
+
+    PROFILER_EXIT(PROFILER_ZONE_SHIFT_REG_SEND);
 }
\ No newline at end of file
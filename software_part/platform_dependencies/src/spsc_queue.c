@@ -0,0 +1,76 @@
+/**
+ * @file    spsc_queue.c
+ * @brief   Реалізація кільцевого буфера SPSC
+ * @author  Olexandr Makedonskyi
+ *
+ * Кожна сторона читає індекс іншої сторони один раз і пише
+ * лише свій індекс - одним байтовим записом після копіювання
+ * елемента. Переривання між будь-якими двома інструкціями
+ * бачить або старий, або новий індекс, але ніколи
+ * недописаний елемент.
+ */
+
+//==================== INCLUDES ========================
+
+#include "spsc_queue.h"
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void spsc_queue_init(SpscQueue *queue, void *storage, uint8_t element_size, uint8_t capacity) {
+    queue->buffer = (volatile uint8_t *)storage;
+    queue->element_size = element_size;
+    queue->mask = (uint8_t)(capacity - 1);
+    queue->head = 0;
+    queue->tail = 0;
+}
+
+
+uint8_t spsc_queue_push(SpscQueue *queue, const void *element) {
+    const uint8_t *source = (const uint8_t *)element;
+    volatile uint8_t *slot;
+    uint8_t head = queue->head;
+    uint8_t size = queue->element_size;
+
+    // Повна: споживач ще не звільнив жодної комірки
+    if ((uint8_t)(head - queue->tail) > queue->mask) {
+        return 0;
+    }
+
+    slot = queue->buffer + (uint16_t)(head & queue->mask) * size;
+    while (size != 0) {
+        *slot++ = *source++;
+        size--;
+    }
+
+    // Публікація елемента (однобайтний запис - атомарний)
+    queue->head = (uint8_t)(head + 1);
+    return 1;
+}
+
+
+uint8_t spsc_queue_pop(SpscQueue *queue, void *element) {
+    uint8_t *target = (uint8_t *)element;
+    volatile uint8_t *slot;
+    uint8_t tail = queue->tail;
+    uint8_t size = queue->element_size;
+
+    if (tail == queue->head) {
+        return 0;
+    }
+
+    slot = queue->buffer + (uint16_t)(tail & queue->mask) * size;
+    while (size != 0) {
+        *target++ = *slot++;
+        size--;
+    }
+
+    // Звільнення комірки лише після зчитування
+    queue->tail = (uint8_t)(tail + 1);
+    return 1;
+}
+
+
+uint8_t spsc_queue_count(const SpscQueue *queue) {
+    return (uint8_t)(queue->head - queue->tail);
+}
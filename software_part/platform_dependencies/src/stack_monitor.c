@@ -0,0 +1,43 @@
+/**
+ * @file    stack_monitor.c
+ * @brief   Реалізація вимірювання найбільшої глибини стеку
+ * @author  Olexandr Makedonskyi
+ */
+
+//==================== INCLUDES ========================
+
+#include "stack_monitor.h"
+
+//==================== DEFINES =========================
+
+#define STACK_MONITOR_BASE      ((volatile uint8_t *)STACK_MONITOR_BOTTOM)
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void stack_monitor_init(void) {
+    volatile uint8_t marker;
+    uint16_t free_bytes;
+    uint16_t i;
+
+    // Кадр цієї функції та все над ним вже зайняте
+    free_bytes = (uint16_t)(&marker - STACK_MONITOR_BASE);
+    free_bytes = (free_bytes > STACK_MONITOR_GUARD) ?
+                 (uint16_t)(free_bytes - STACK_MONITOR_GUARD) : 0;
+
+    for (i = 0; i < free_bytes; ++i) {
+        STACK_MONITOR_BASE[i] = STACK_MONITOR_PATTERN;
+    }
+}
+
+
+uint16_t stack_monitor_peak(void) {
+    uint16_t i;
+
+    for (i = 0; i < STACK_MONITOR_SIZE; ++i) {
+        if (STACK_MONITOR_BASE[i] != STACK_MONITOR_PATTERN) {
+            break;
+        }
+    }
+    return (uint16_t)(STACK_MONITOR_SIZE - i);
+}
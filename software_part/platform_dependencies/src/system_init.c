@@ -12,28 +12,36 @@
  */
 //==================== INCLUDES ========================
 #include "system_init.h"
-
-//=============== INTERNAL FUNCTION DEFINES =============
-
-#define TIM4_PRESCALER_1 ((uint8_t)0x00)
+#include "delays.h"
 
 //=============== STATIC INTERNAL FUNCTION PROTOTYPES ==========
 
 static void enable_system_clock(void);
-static void enable_timers_for_delay(void);
+#ifdef PROFILER_ENABLE
+static void benchmark_short_delay(void);
+#endif
 
 
 //============ PUBLIC FUNCTION IMPLEMENTATIONS =========
 
 void initialize_hardware(void){
     enable_system_clock();
-    enable_timers_for_delay();
+    systick_init();
+    PROFILER_INIT();
+#ifdef PROFILER_ENABLE
+    benchmark_short_delay();
+#endif
+    scheduler_monitor_boot();
     initialize_display();
     initialize_buttons();
     initialize_distance_sensor();
     led_indication_init();
-    initialize_logger();
     
+    // Глобальний дозвіл переривань (системний тік, захоплення ECHO у TIM2 CC)
+    enableInterrupts();
+    
+    // Після дозволу: передача в лог іде з переривання UART1 TX
+    initialize_logger();
 }
 
 //=========== INTERNAL FUNCTION IMPLEMENTATIONS ========
@@ -58,21 +66,41 @@ static void enable_system_clock(void){
 
 }
 
+#ifdef PROFILER_ENABLE
 /**
- * @brief Внутрішня ініціалізація таймера для затримок
- * 
- * Налаштовує TIM4 для створення мікросекундних затримок.
- * Таймер працює в режимі polling (без переривань).
+ * @brief Вимірювання DELAY_SHORT_US() лічильником тактів TIM1
  * 
- * @param[in] None
+ * Порожня зона дає накладні витрати профайлера, різниця
+ * найбільших значень зон - такти затримки разом з викликом
+ * (очікується 4 * n + 8: 16/32/48/80/160, див. delays.h).
  * 
+ * @param None
  * @retval None
  * 
- * @note Функція ПРИВАТНА - викликається тільки з initialize_hardware()
- * 
+ * @note До глобального дозволу переривань - вимір без втручання ISR
  */
-static void enable_timers_for_delay(void){
-    TIM4->PSCR = TIM4_PRESCALER_1; 
-    TIM4->ARR = ((HSI_VALUE)/1000000) - 1;
-    TIM4->CR1 = TIM4_CR1_CEN; 
+static void benchmark_short_delay(void){
+    PROFILER_ENTER(PROFILER_ZONE_EMPTY);
+    PROFILER_EXIT(PROFILER_ZONE_EMPTY);
+    
+    PROFILER_ENTER(PROFILER_ZONE_DELAY_1US);
+    DELAY_SHORT_US(1);
+    PROFILER_EXIT(PROFILER_ZONE_DELAY_1US);
+    
+    PROFILER_ENTER(PROFILER_ZONE_DELAY_2US);
+    DELAY_SHORT_US(2);
+    PROFILER_EXIT(PROFILER_ZONE_DELAY_2US);
+    
+    PROFILER_ENTER(PROFILER_ZONE_DELAY_3US);
+    DELAY_SHORT_US(3);
+    PROFILER_EXIT(PROFILER_ZONE_DELAY_3US);
+    
+    PROFILER_ENTER(PROFILER_ZONE_DELAY_5US);
+    DELAY_SHORT_US(5);
+    PROFILER_EXIT(PROFILER_ZONE_DELAY_5US);
+    
+    PROFILER_ENTER(PROFILER_ZONE_DELAY_10US);
+    DELAY_SHORT_US(10);
+    PROFILER_EXIT(PROFILER_ZONE_DELAY_10US);
 }
+#endif
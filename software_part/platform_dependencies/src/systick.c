@@ -0,0 +1,104 @@
+/**
+ * @file    systick.c
+ * @brief   Реалізація системного таймера (1 мс) на базі TIM4
+ * @author  Olexandr Makedonskyi
+ *
+ * TIM4 рахує з частотою 250 кГц, переривання оновлення
+ * кожну 1 мс інкрементує 32-бітний лічильник мілісекунд
+ * та відраховує період запуску конверсій ADC.
+ */
+
+//==================== INCLUDES ========================
+
+#include "systick.h"
+#include "adc.h"
+#include "critical_section.h"
+
+//==================== DEFINES =========================
+
+/**
+ * @brief Prescaler TIM4: 2^6 = 64 → 16 МГц / 64 = 250 кГц
+ */
+#define TIM4_PRESCALER_64       ((uint8_t)0x06)
+
+/**
+ * @brief Кількість тіків TIM4 за 1 мс
+ */
+#define SYSTICK_COUNTS_PER_MS   ((uint8_t)((HSI_VALUE) / 64 / 1000))
+
+//================ PRIVATE VARIABLES ===================
+
+/**
+ * @brief Лічильник мілісекунд (оновлюється в перериванні)
+ */
+static volatile uint32_t systick_counter;
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void systick_init(void) {
+    TIM4->CR1 = 0;
+    TIM4->PSCR = TIM4_PRESCALER_64;
+    TIM4->ARR = SYSTICK_COUNTS_PER_MS - 1;
+    systick_counter = 0;
+
+    // Примусове оновлення: завантаження PSCR та скидання CNTR
+    TIM4->EGR = TIM4_EGR_UG;
+    TIM4->SR1 = 0;
+
+    TIM4->IER = TIM4_IER_UIE;
+    TIM4->CR1 = TIM4_CR1_CEN;
+}
+
+
+uint32_t systick_ms(void) {
+    uint32_t now;
+    uint8_t cc;
+
+    // 32-бітне читання не атомарне на STM8
+    CRITICAL_SECTION_ENTER(cc);
+    now = systick_counter;
+    CRITICAL_SECTION_EXIT(cc);
+
+    return now;
+}
+
+
+uint32_t systick_ms_isr(void) {
+    return systick_counter;
+}
+
+
+uint32_t systick_us(void) {
+    uint32_t ms;
+    uint8_t count;
+    uint8_t cc;
+
+    CRITICAL_SECTION_ENTER(cc);
+
+    ms = systick_counter;
+    count = TIM4->CNTR;
+
+    // Переповнення відбулось, але переривання ще не оброблене
+    if (TIM4->SR1 & TIM4_SR1_UIF) {
+        ms++;
+        count = TIM4->CNTR;
+    }
+
+    CRITICAL_SECTION_EXIT(cc);
+    return ms * 1000 + (uint16_t)count * SYSTICK_US_PER_COUNT;
+}
+
+
+void systick_idle_wait(void) {
+    wfi();
+}
+
+
+INTERRUPT_HANDLER(systick_tim4_update_irq_handler, SYSTICK_TIM4_UPDATE_IRQ_NUMBER) {
+    TIM4->SR1 &= ~TIM4_SR1_UIF;
+    systick_counter++;
+    
+    // Фіксована частота вибірок ADC (кнопки)
+    adc_trigger_tick();
+}
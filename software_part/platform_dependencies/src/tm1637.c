@@ -11,14 +11,16 @@
  * Особливості реалізації:
  * - Програмна реалізація протоколу (bit-banging)
  * - Open-Drain режим для DIO (підтримка ACK)
- * - Мікросекундні затримки для синхронізації
+ * - Мікросекундні затримки DELAY_SHORT_US() (розраховані
+ *   на етапі компіляції, без накладних витрат таймера)
  * - Перевірка ACK від контролера
  * 
  * Тайминг операцій:
  * - START: 6 мкс
  * - STOP: 6 мкс
- * - Байт (8 біт + ACK): ~100 мкс
- * - Повна транзакція (4 байти): ~500 мкс
+ * - Байт (8 біт + ACK): ~80 мкс
+ * - Повна транзакція (4 розряди, 6 байт): ~510 мкс
+ * - Один розряд (3 байти): ~270 мкс
  */
 
 //==================== INCLUDES ========================
@@ -54,37 +56,48 @@ void tm1637_gpio_init(void) {
 }
 
 
-void tm1637_set_brightness(uint8_t brightness) {
+uint8_t tm1637_set_brightness(uint8_t brightness) {
+    uint8_t nack;
+    
     // Обмеження яскравості до діапазону 0-7
     brightness =  tm1637_check_brightness_boundary(brightness);
     
     // Відправка команди керування дисплеєм
     tm1637_start();
-    tm1637_write_byte(TM1637_CMD_DISPLAY_ON | (brightness & TM1637_BRIGHTNESS_MASK)); 
+    nack = tm1637_write_byte(TM1637_CMD_DISPLAY_ON | (brightness & TM1637_BRIGHTNESS_MASK)); 
     tm1637_stop();
+    
+    return nack;
 }
 
 
-void tm1637_write_segments(const uint8_t *segments) {
-    int i;
+uint8_t tm1637_write_segments(uint8_t first, const uint8_t *segments, uint8_t count) {
+    uint8_t i;
+    uint8_t nack;
+    
+    if (first >= TM1637_DIGITS_COUNT || count > TM1637_DIGITS_COUNT - first) {
+        return 1;
+    }
     
     // 1. Відправка команди автоматичного інкременту адреси
     tm1637_start();
-    tm1637_write_byte(TM1637_CMD_DATA_AUTO);
+    nack = tm1637_write_byte(TM1637_CMD_DATA_AUTO);
     tm1637_stop();
 
-    // 2. Відправка даних для всіх 4 розрядів
+    // 2. Відправка даних для розрядів first..first+count-1
     tm1637_start();
     
-    // Встановлення початкової адреси (розряд 0)
-    tm1637_write_byte(TM1637_CMD_ADDR_START);
+    // Встановлення адреси першого розряду
+    nack |= tm1637_write_byte((uint8_t)(TM1637_CMD_ADDR_START + first));
     
-    // Відправка 4 байт сегментів
-    for (i = 0; i < TM1637_DIGITS_COUNT; ++i) {
-        tm1637_write_byte(segments[i]);
+    // Відправка count байт сегментів
+    for (i = 0; i < count; ++i) {
+        nack |= tm1637_write_byte(segments[i]);
     }
     
     tm1637_stop();
+    
+    return nack;
 }
 
 //============= STATIC INTERNAL FUNCTION IMPLEMENTATIONS =======
@@ -119,15 +132,15 @@ static void tm1637_start(void) {
     // 2. Обидві лінії в HIGH (idle стан)
     TM1637_PORT->ODR |= TM1637_DIO_MASK;
     TM1637_PORT->ODR |= TM1637_CLK_MASK;
-    _delay_us(2);
+    DELAY_SHORT_US(2);
 
     // 3. START умова: DIO падає при HIGH CLK
     TM1637_PORT->ODR &= ~TM1637_DIO_MASK;
-    _delay_us(2);
+    DELAY_SHORT_US(2);
 
     // 4. CLK падає після DIO
     TM1637_PORT->ODR &= ~TM1637_CLK_MASK;
-    _delay_us(2);
+    DELAY_SHORT_US(2);
 }
 
 /**
@@ -159,17 +172,17 @@ static void tm1637_stop(void) {
 
     // 2. Обидві лінії в LOW (перед STOP)
     TM1637_PORT->ODR &= ~TM1637_CLK_MASK;
-    _delay_us(2);
+    DELAY_SHORT_US(2);
     TM1637_PORT->ODR &= ~TM1637_DIO_MASK;
-    _delay_us(2);
+    DELAY_SHORT_US(2);
 
     // 3. CLK зростає першим
     TM1637_PORT->ODR |= TM1637_CLK_MASK;
-    _delay_us(2);
+    DELAY_SHORT_US(2);
 
     // 4. STOP умова: DIO зростає при HIGH CLK
     TM1637_PORT->ODR |= TM1637_DIO_MASK;
-    _delay_us(2);
+    DELAY_SHORT_US(2);
 }
 
 
@@ -222,7 +235,7 @@ static uint8_t tm1637_write_byte(uint8_t data) {
     for (i = 0; i < 8; ++i) {
         // a. CLK = LOW (підготовка до зміни даних)
         TM1637_PORT->ODR &= ~TM1637_CLK_MASK;
-        _delay_us(1);
+        DELAY_SHORT_US(1);
 
         // b. Встановлення DIO як вихід Open-Drain
         TM1637_PORT->DDR |= TM1637_DIO_MASK;
@@ -234,11 +247,11 @@ static uint8_t tm1637_write_byte(uint8_t data) {
         } else {
             TM1637_PORT->ODR &= ~TM1637_DIO_MASK;
         }
-        _delay_us(3);  // Setup time
+        DELAY_SHORT_US(3);  // Setup time
 
         // d. CLK = HIGH (дані захоплюються на rising edge)
         TM1637_PORT->ODR |= TM1637_CLK_MASK;
-        _delay_us(5);  // Hold time
+        DELAY_SHORT_US(5);  // Hold time
 
         // e. Зсув даних для наступного біта
         data >>= 1;
@@ -251,18 +264,18 @@ static uint8_t tm1637_write_byte(uint8_t data) {
     // b. Перемикання DIO на вхід з pull-up
     TM1637_PORT->DDR &= ~TM1637_DIO_MASK;  // Вхід
     TM1637_PORT->CR1 |= TM1637_DIO_MASK;   // Pull-up
-    _delay_us(1);
+    DELAY_SHORT_US(1);
 
     // c. CLK = HIGH (TM1637 виставляє ACK на DIO)
     TM1637_PORT->ODR |= TM1637_CLK_MASK;
-    _delay_us(3);
+    DELAY_SHORT_US(3);
 
     // d. Зчитування ACK (0 = ACK, 1 = NACK)
     ack = (TM1637_PORT->IDR & TM1637_DIO_MASK) ? 1 : 0;
 
     // e. CLK = LOW (завершення ACK циклу)
     TM1637_PORT->ODR &= ~TM1637_CLK_MASK;
-    _delay_us(1);
+    DELAY_SHORT_US(1);
 
     // 3. Відновлення DIO як вихід Open-Drain
     TM1637_PORT->DDR |= TM1637_DIO_MASK;
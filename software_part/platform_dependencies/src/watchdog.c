@@ -0,0 +1,48 @@
+/**
+ * @file    watchdog.c
+ * @brief   Реалізація HAL незалежного сторожового таймера (IWDG)
+ * @author  Olexandr Makedonskyi
+ */
+
+//==================== INCLUDES ========================
+
+#include "watchdog.h"
+
+//==================== DEFINES =========================
+
+#define IWDG_KEY_ENABLE         ((uint8_t)0xCC)     /**< Запуск IWDG */
+#define IWDG_KEY_REFRESH        ((uint8_t)0xAA)     /**< Перезавантаження лічильника */
+#define IWDG_KEY_ACCESS         ((uint8_t)0x55)     /**< Доступ до PR та RLR */
+
+/**
+ * @brief Prescaler IWDG /256
+ */
+#define IWDG_PRESCALER_256      ((uint8_t)0x06)
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+
+void watchdog_init(void) {
+    IWDG->KR = IWDG_KEY_ENABLE;
+
+    IWDG->KR = IWDG_KEY_ACCESS;
+    IWDG->PR = IWDG_PRESCALER_256;
+    IWDG->RLR = WATCHDOG_RELOAD;
+
+    // Завантаження RLR (також закриває доступ до PR та RLR)
+    IWDG->KR = IWDG_KEY_REFRESH;
+}
+
+
+void watchdog_refresh(void) {
+    IWDG->KR = IWDG_KEY_REFRESH;
+}
+
+
+uint8_t watchdog_take_reset_flags(void) {
+    uint8_t flags = RST->SR;
+
+    // Прапорці очищуються записом 1
+    RST->SR = flags;
+    return flags;
+}
@@ -2,6 +2,11 @@
  *	Copyright (c) 2007 STMicroelectronics
  */
 
+#include "hc_sr04.h"
+#include "systick.h"
+#include "uart1_tx.h"
+#include "adc.h"
+
 typedef void @far (*interrupt_handler_t)(void);
 
 struct interrupt_vector {
@@ -36,17 +41,17 @@ struct interrupt_vector const _vectab[] = {
 	{0x82, NonHandledInterrupt}, /* irq10 */
 	{0x82, NonHandledInterrupt}, /* irq11 */
 	{0x82, NonHandledInterrupt}, /* irq12 */
-	{0x82, NonHandledInterrupt}, /* irq13 */
-	{0x82, NonHandledInterrupt}, /* irq14 */
+	{0x82, (interrupt_handler_t)hcsr04_tim2_update_irq_handler}, /* irq13 - TIM2 update/overflow */
+	{0x82, (interrupt_handler_t)hcsr04_tim2_cc_irq_handler}, /* irq14 - TIM2 capture/compare */
 	{0x82, NonHandledInterrupt}, /* irq15 */
 	{0x82, NonHandledInterrupt}, /* irq16 */
-	{0x82, NonHandledInterrupt}, /* irq17 */
+	{0x82, (interrupt_handler_t)uart1_tx_irq_handler}, /* irq17 - UART1 TX (log queue) */
 	{0x82, NonHandledInterrupt}, /* irq18 */
 	{0x82, NonHandledInterrupt}, /* irq19 */
 	{0x82, NonHandledInterrupt}, /* irq20 */
 	{0x82, NonHandledInterrupt}, /* irq21 */
-	{0x82, NonHandledInterrupt}, /* irq22 */
-	{0x82, NonHandledInterrupt}, /* irq23 */
+	{0x82, (interrupt_handler_t)adc1_eoc_irq_handler}, /* irq22 - ADC1 end of conversion (buttons) */
+	{0x82, (interrupt_handler_t)systick_tim4_update_irq_handler}, /* irq23 - TIM4 update/overflow (system tick) */
 	{0x82, NonHandledInterrupt}, /* irq24 */
 	{0x82, NonHandledInterrupt}, /* irq25 */
 	{0x82, NonHandledInterrupt}, /* irq26 */
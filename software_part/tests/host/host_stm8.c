@@ -0,0 +1,60 @@
+/**
+ * @file    host_stm8.c
+ * @author  Olexandr Makedonskyi
+ * @brief   Хост-емуляція ядра STM8 для тестів (див. host/stm8s.h)
+ * @date    16.10.2026
+ * @version 1.0
+ */
+
+//==================== INCLUDES ========================
+#include <stdarg.h>
+#include <string.h>
+
+#include "stm8s.h"
+
+//==================== DEFINES =========================
+
+/** @brief Біти I1/I0 регістра CC: 0x28 - переривання заборонені */
+#define HOST_CC_INTERRUPTS_MASKED   0x28
+
+//================ PRIVATE VARIABLES ===================
+
+/** @brief Регістр CC (після скидання переривання заборонені) */
+static uint8_t host_cc = HOST_CC_INTERRUPTS_MASKED;
+
+//================ PUBLIC VARIABLES ====================
+
+ADC1_TypeDef host_adc1;
+GPIO_TypeDef host_gpio[4];
+TIM2_TypeDef host_tim2;
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+uint8_t host_asm(const char *code, ...) {
+    va_list args;
+    uint8_t a = 0;
+
+    if (strstr(code, "pop cc") != 0) {
+        va_start(args, code);
+        host_cc = (uint8_t)va_arg(args, int);
+        va_end(args);
+        return host_cc;
+    }
+
+    if (strstr(code, "push cc") != 0) {
+        a = host_cc;
+    }
+    if (strstr(code, "sim") != 0) {
+        host_cc |= HOST_CC_INTERRUPTS_MASKED;
+    }
+    if (strstr(code, "rim") != 0) {
+        host_cc &= (uint8_t)~HOST_CC_INTERRUPTS_MASKED;
+    }
+
+    return a;
+}
+
+
+uint8_t host_interrupts_enabled(void) {
+    return (uint8_t)((host_cc & HOST_CC_INTERRUPTS_MASKED) == 0);
+}
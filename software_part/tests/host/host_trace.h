@@ -0,0 +1,50 @@
+/**
+ * @file    host_trace.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Покрокове виконання коду прошивки на хості (x86-64)
+ * @date    17.10.2026
+ * @version 1.0
+ *
+ * Між host_trace_on() та host_trace_off() процесор (прапорець TF)
+ * після кожної інструкції надсилає SIGTRAP. Обробник сигналу
+ * встановлює тест: він емулює переривання на межі інструкцій
+ * або поведінку регістрів, яку не передати змінною в RAM.
+ *
+ * На інших хостах HOST_TRACE_SUPPORTED = 0, тести з трасуванням
+ * пропускаються.
+ */
+
+#ifndef __HOST_TRACE_H
+#define __HOST_TRACE_H
+
+#if defined(__x86_64__)
+
+#define HOST_TRACE_SUPPORTED    1
+
+/*
+ * TF вмикається/вимикається через pushf/popf. Стек зсувається
+ * за червону зону x86-64: код навколо може тримати там змінні
+ */
+static inline void host_trace_on(void) {
+    __asm__ volatile("lea -128(%%rsp), %%rsp\n\t"
+                     "pushfq\n\t"
+                     "orq $0x100, (%%rsp)\n\t"
+                     "popfq\n\t"
+                     "lea 128(%%rsp), %%rsp" ::: "memory", "cc");
+}
+
+static inline void host_trace_off(void) {
+    __asm__ volatile("lea -128(%%rsp), %%rsp\n\t"
+                     "pushfq\n\t"
+                     "andq $~0x100, (%%rsp)\n\t"
+                     "popfq\n\t"
+                     "lea 128(%%rsp), %%rsp" ::: "memory", "cc");
+}
+
+#else
+
+#define HOST_TRACE_SUPPORTED    0
+
+#endif
+
+#endif /* __HOST_TRACE_H */
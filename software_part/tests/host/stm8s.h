@@ -0,0 +1,205 @@
+/**
+ * @file    stm8s.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Хост-заміна заголовка регістрів STM8S для тестів
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Модулі прошивки компілюються gcc без змін: тести кладуть
+ * каталог host/ у шлях include раніше за registers_include,
+ * тому "stm8s.h" береться звідси.
+ *
+ * - Типи - зі stdint.h, атрибути пам'яті (TINY, NEAR, FAR) порожні
+ * - _COSMIC_ визначено: critical_section.h та delays.c обирають
+ *   гілку Cosmic, а _asm() виконує host_asm() (host_stm8.c)
+ * - Обробник переривання - звичайна функція, тест викликає
+ *   її як "переривання"
+ * - Регістри периферії - змінні в RAM (host_stm8.c), які тест
+ *   заповнює та перевіряє (додаються за потреби тестів)
+ */
+
+#ifndef __STM8S_H
+#define __STM8S_H
+
+//==================== INCLUDES ========================
+#include <stdint.h>
+
+//==================== DEFINES =========================
+
+#define _COSMIC_
+
+#define TINY
+#define NEAR
+#define FAR
+#define EEPROM
+#define CONST   const
+
+#define __IO    volatile
+
+#define HSI_VALUE   ((uint32_t)16000000)
+#define LSI_VALUE   ((uint32_t)128000)
+
+/**
+ * @brief Вставки асемблера Cosmic: емуляція прапорця I регістра CC
+ *
+ * "sim"/"rim" забороняють/дозволяють переривання, "push cc"
+ * повертає CC, "pop cc" відновлює його з аргументу.
+ */
+#define _asm    host_asm
+
+#define enableInterrupts()      host_asm("rim\n")
+#define disableInterrupts()     host_asm("sim\n")
+#define rim()                   host_asm("rim\n")
+#define sim()                   host_asm("sim\n")
+#define nop()                   host_asm("nop\n")
+#define wfi()                   host_asm("wfi\n")
+
+#define INTERRUPT_HANDLER(a, b) void a(void)
+
+//==================== PERIPHERALS =====================
+
+/**
+ * @brief ADC1 (розкладка як у registers_include/stm8s.h)
+ */
+typedef struct ADC1_struct {
+    __IO uint8_t DB0RH;
+    __IO uint8_t DB0RL;
+    __IO uint8_t DB1RH;
+    __IO uint8_t DB1RL;
+    __IO uint8_t DB2RH;
+    __IO uint8_t DB2RL;
+    __IO uint8_t DB3RH;
+    __IO uint8_t DB3RL;
+    __IO uint8_t DB4RH;
+    __IO uint8_t DB4RL;
+    __IO uint8_t DB5RH;
+    __IO uint8_t DB5RL;
+    __IO uint8_t DB6RH;
+    __IO uint8_t DB6RL;
+    __IO uint8_t DB7RH;
+    __IO uint8_t DB7RL;
+    __IO uint8_t DB8RH;
+    __IO uint8_t DB8RL;
+    __IO uint8_t DB9RH;
+    __IO uint8_t DB9RL;
+    uint8_t RESERVED[12];
+    __IO uint8_t CSR;
+    __IO uint8_t CR1;
+    __IO uint8_t CR2;
+    __IO uint8_t CR3;
+    __IO uint8_t DRH;
+    __IO uint8_t DRL;
+    __IO uint8_t TDRH;
+    __IO uint8_t TDRL;
+    __IO uint8_t HTRH;
+    __IO uint8_t HTRL;
+    __IO uint8_t LTRH;
+    __IO uint8_t LTRL;
+    __IO uint8_t AWSRH;
+    __IO uint8_t AWSRL;
+    __IO uint8_t AWCRH;
+    __IO uint8_t AWCRL;
+} ADC1_TypeDef;
+
+#define ADC1_CSR_AWD     ((uint8_t)0x40)
+#define ADC1_CSR_EOCIE   ((uint8_t)0x20)
+#define ADC1_CSR_AWDIE   ((uint8_t)0x10)
+#define ADC1_CR1_CONT    ((uint8_t)0x02)
+#define ADC1_CR3_DBUF    ((uint8_t)0x80)
+
+extern ADC1_TypeDef host_adc1;
+#define ADC1    (&host_adc1)
+
+/**
+ * @brief Порти GPIO
+ */
+typedef struct GPIO_struct {
+    __IO uint8_t ODR;
+    __IO uint8_t IDR;
+    __IO uint8_t DDR;
+    __IO uint8_t CR1;
+    __IO uint8_t CR2;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef host_gpio[4];
+#define GPIOA   (&host_gpio[0])
+#define GPIOB   (&host_gpio[1])
+#define GPIOC   (&host_gpio[2])
+#define GPIOD   (&host_gpio[3])
+
+/**
+ * @brief TIM2 (розкладка STM8S103)
+ */
+typedef struct TIM2_struct {
+    __IO uint8_t CR1;
+    uint8_t RESERVED1;
+    uint8_t RESERVED2;
+    __IO uint8_t IER;
+    __IO uint8_t SR1;
+    __IO uint8_t SR2;
+    __IO uint8_t EGR;
+    __IO uint8_t CCMR1;
+    __IO uint8_t CCMR2;
+    __IO uint8_t CCMR3;
+    __IO uint8_t CCER1;
+    __IO uint8_t CCER2;
+    __IO uint8_t CNTRH;
+    __IO uint8_t CNTRL;
+    __IO uint8_t PSCR;
+    __IO uint8_t ARRH;
+    __IO uint8_t ARRL;
+    __IO uint8_t CCR1H;
+    __IO uint8_t CCR1L;
+    __IO uint8_t CCR2H;
+    __IO uint8_t CCR2L;
+    __IO uint8_t CCR3H;
+    __IO uint8_t CCR3L;
+} TIM2_TypeDef;
+
+#define TIM2_CR1_CEN     ((uint8_t)0x01)
+#define TIM2_IER_CC3IE   ((uint8_t)0x08)
+#define TIM2_IER_CC2IE   ((uint8_t)0x04)
+#define TIM2_IER_CC1IE   ((uint8_t)0x02)
+#define TIM2_IER_UIE     ((uint8_t)0x01)
+#define TIM2_SR1_CC3IF   ((uint8_t)0x08)
+#define TIM2_SR1_CC2IF   ((uint8_t)0x04)
+#define TIM2_SR1_CC1IF   ((uint8_t)0x02)
+#define TIM2_SR1_UIF     ((uint8_t)0x01)
+#define TIM2_EGR_UG      ((uint8_t)0x01)
+#define TIM2_CCER1_CC2P  ((uint8_t)0x20)
+#define TIM2_CCER1_CC2E  ((uint8_t)0x10)
+#define TIM2_CCER1_CC1P  ((uint8_t)0x02)
+#define TIM2_CCER1_CC1E  ((uint8_t)0x01)
+#define TIM2_CCER2_CC3P  ((uint8_t)0x02)
+#define TIM2_CCER2_CC3E  ((uint8_t)0x01)
+
+extern TIM2_TypeDef host_tim2;
+#define TIM2    (&host_tim2)
+
+/**
+ * @brief Прапорці причини скидання RST_SR (лише маски: регістр
+ *        читає watchdog.c, тести підміняють його функції)
+ */
+#define RST_SR_EMCF      ((uint8_t)0x10)
+#define RST_SR_SWIMF     ((uint8_t)0x08)
+#define RST_SR_ILLOPF    ((uint8_t)0x04)
+#define RST_SR_IWDGF     ((uint8_t)0x02)
+#define RST_SR_WWDGF     ((uint8_t)0x01)
+
+//================== FUNCTIONS PROTOTYPES ==================
+
+/**
+ * @brief Виконання вставки асемблера на хості
+ *
+ * @param[in] code Текст вставки
+ * @param[in] ...  Значення для регістра A ("pop cc")
+ * @return Значення регістра A після вставки (CC для "push cc")
+ */
+uint8_t host_asm(const char *code, ...);
+
+/**
+ * @brief 1 - переривання дозволені (прапорець I знятий)
+ */
+uint8_t host_interrupts_enabled(void);
+
+#endif /* __STM8S_H */
@@ -0,0 +1,260 @@
+/**
+ * @file    test_adc.c
+ * @author  Olexandr Makedonskyi
+ * @brief   Передача вибірок ADC з переривання основному циклу
+ * @date    17.10.2026
+ * @version 1.0
+ *
+ * Збирається двічі: з налаштуваннями прошивки (adc) та з іншим
+ * періодом, фільтром і дільником (adc_slow, див. Makefile).
+ *
+ * Тік запускає пачку, пачка емулюється заповненням буфера
+ * DB0R-DB9R та викликом adc1_eoc_irq_handler(). Перевіряється:
+ * - пачка - кожен ADC_SAMPLE_PERIOD_MS-й тік, регістри запуску
+ *   та зупинки, відкидання перших ADC_BURST_SKIP конверсій
+ * - після кожного переривання adc_get_filtered() одразу повертає
+ *   нове ковзне середнє (еталон - сума останніх вибірок), обробник
+ *   вибірки отримує те саме значення рівно один раз
+ * - між перериваннями значення не змінюється, зчитування не
+ *   чіпає ADC (без очікування конверсії)
+ * - очікування на AWD: тік не запускає пачки, середнє зберігається;
+ *   вихід (AWD або adc_watch_cancel()) - пачка на наступному тіку,
+ *   яка заповнює весь фільтр
+ *
+ * Повтор зчитування в adc_get_filtered() тут не навантажується:
+ * на хості 16-бітне зчитування атомарне, розрив байтів можливий
+ * лише на STM8.
+ */
+
+//==================== INCLUDES ========================
+#include "adc.h"
+#include "test_check.h"
+
+//==================== DEFINES =========================
+
+#define ADC_BUFFER_SIZE     10
+#define ADC_BURST_SKIP      (ADC_BUFFER_SIZE - ADC_BURST_SIZE)
+
+#define CR1_IDLE            ((uint8_t)((ADC_PRESCALER << 4) | ADC1_CR1_ADON))
+#define CR1_RUNNING         ((uint8_t)(CR1_IDLE | ADC1_CR1_CONT))
+
+#define SAMPLES             40
+
+//================ PRIVATE VARIABLES ===================
+
+/** @brief Вибірки, отримані обробником з переривання */
+static uint16_t handled[SAMPLES + 8];
+static uint8_t  handled_count;
+
+/** @brief Еталонний фільтр (хронологічний порядок) */
+static uint16_t reference[ADC_FILTER_SIZE];
+static uint8_t  reference_index;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static void on_sample(uint16_t filtered);
+static uint8_t burst_running(void);
+static uint8_t tick_until_burst(void);
+static void complete_burst(uint16_t value, uint16_t settling);
+static uint16_t reference_update(uint16_t value);
+static void reference_fill(uint16_t value);
+static void check_idle_between_bursts(uint16_t expected);
+static void check_watch_exit(uint8_t by_awd, uint16_t previous, uint16_t value);
+
+//==================== FAKES ===========================
+
+static void on_sample(uint16_t filtered) {
+    if (handled_count < sizeof(handled) / sizeof(handled[0])) {
+        handled[handled_count] = filtered;
+    }
+    handled_count++;
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+static uint8_t burst_running(void) {
+    return (uint8_t)(host_adc1.CR1 == CR1_RUNNING &&
+                     host_adc1.CR3 == ADC1_CR3_DBUF &&
+                     host_adc1.CSR == (ADC1_CHANNEL_3 | ADC1_CSR_EOCIE));
+}
+
+/**
+ * @brief Тіки до запуску пачки
+ *
+ * @return Кількість тіків (0 - пачка не запустилась за період)
+ */
+static uint8_t tick_until_burst(void) {
+    uint8_t ticks;
+
+    for (ticks = 1; ticks <= ADC_SAMPLE_PERIOD_MS; ++ticks) {
+        adc_trigger_tick();
+        if (burst_running()) {
+            return ticks;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Буфер заповнений: перші ADC_BURST_SKIP конверсій - час
+ *        встановлення (settling), решта - value
+ */
+static void complete_burst(uint16_t value, uint16_t settling) {
+    volatile uint8_t *buffer = &host_adc1.DB0RH;
+    uint16_t conversion;
+    uint8_t i;
+
+    for (i = 0; i < ADC_BUFFER_SIZE; ++i) {
+        conversion = (i < ADC_BURST_SKIP) ? settling : value;
+        buffer[2 * i] = (uint8_t)(conversion >> 8);
+        buffer[2 * i + 1] = (uint8_t)conversion;
+    }
+    adc1_eoc_irq_handler();
+
+    // Пачка зупинена, переривання до наступного тіку вимкнене
+    CHECK_EQ(host_adc1.CR1, CR1_IDLE);
+    CHECK_EQ(host_adc1.CSR, ADC1_CHANNEL_3);
+}
+
+static uint16_t reference_update(uint16_t value) {
+    uint16_t sum = 0;
+    uint8_t i;
+
+    reference[reference_index] = value;
+    reference_index = (uint8_t)((reference_index + 1) % ADC_FILTER_SIZE);
+    for (i = 0; i < ADC_FILTER_SIZE; ++i) {
+        sum += reference[i];
+    }
+    return (uint16_t)(sum / ADC_FILTER_SIZE);
+}
+
+static void reference_fill(uint16_t value) {
+    uint8_t i;
+
+    for (i = 0; i < ADC_FILTER_SIZE; ++i) {
+        reference[i] = value;
+    }
+}
+
+/**
+ * @brief Тіки періоду до наступної пачки (без останнього): середнє
+ *        не змінюється, зчитування не запускає конверсію
+ */
+static void check_idle_between_bursts(uint16_t expected) {
+    uint8_t i;
+
+    for (i = 1; i < ADC_SAMPLE_PERIOD_MS; ++i) {
+        adc_trigger_tick();
+        CHECK(!burst_running());
+        CHECK_EQ(adc_get_filtered(), expected);
+        CHECK_EQ(host_adc1.CR1, CR1_IDLE);
+        CHECK_EQ(host_adc1.CSR, ADC1_CHANNEL_3);
+    }
+}
+
+/**
+ * @brief Очікування на AWD та вихід з нього
+ */
+static void check_watch_exit(uint8_t by_awd, uint16_t previous, uint16_t value) {
+    uint8_t count;
+    uint8_t i;
+
+    adc_watch_above(500);
+    CHECK_EQ(host_adc1.CR1, CR1_RUNNING);
+    CHECK_EQ(host_adc1.CR3, 0);
+    CHECK_EQ(host_adc1.CSR, ADC1_CHANNEL_3 | ADC1_CSR_AWDIE);
+    CHECK_EQ((host_adc1.HTRH << 2) | host_adc1.HTRL, 500);
+
+    // Тіки не запускають пачки, основний цикл бачить останнє середнє
+    for (i = 0; i < 3 * ADC_SAMPLE_PERIOD_MS; ++i) {
+        adc_trigger_tick();
+        CHECK(!burst_running());
+        CHECK_EQ(adc_get_filtered(), previous);
+    }
+
+    count = handled_count;
+    if (by_awd) {
+        host_adc1.CSR |= ADC1_CSR_AWD;
+        adc1_eoc_irq_handler();
+    } else {
+        adc_watch_cancel();
+    }
+    CHECK_EQ(host_adc1.CR1, CR1_IDLE);
+    CHECK_EQ(host_adc1.CSR, ADC1_CHANNEL_3);
+    CHECK_EQ(handled_count, count);
+
+    // Перша пачка - одразу на наступному тіку і заповнює весь фільтр
+    adc_trigger_tick();
+    CHECK(burst_running());
+    complete_burst(value, 0);
+    reference_fill(value);
+    CHECK_EQ(adc_get_filtered(), value);
+    CHECK_EQ(handled_count, count + 1);
+    CHECK_EQ(handled[count], value);
+}
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+int main(void) {
+    uint16_t expected = 0;
+    uint16_t value;
+    uint8_t count;
+    uint8_t n;
+
+    initialize_adc();
+    adc_set_sample_handler(on_sample);
+    CHECK_EQ(host_adc1.CR1, CR1_IDLE);
+    CHECK_EQ(host_adc1.CR2, ADC1_CR2_ALIGN);
+    CHECK_EQ(host_adc1.CSR, ADC1_CHANNEL_3);
+    CHECK_EQ(adc_get_filtered(), 0);
+
+    // Перша пачка заповнює фільтр; конверсії встановлення відкидаються
+    CHECK_EQ(tick_until_burst(), ADC_SAMPLE_PERIOD_MS);
+    complete_burst(400, 1023);
+    reference_fill(400);
+    expected = 400;
+    CHECK_EQ(adc_get_filtered(), expected);
+    CHECK_EQ(handled_count, 1);
+    CHECK_EQ(handled[0], expected);
+
+    // Ковзне середнє: нове значення - одразу після переривання
+    for (n = 0; n < SAMPLES; ++n) {
+        check_idle_between_bursts(expected);
+        count = handled_count;
+        value = (uint16_t)((n * 157U) % 1024U);
+
+        adc_trigger_tick();
+        CHECK(burst_running());
+        CHECK_EQ(adc_get_filtered(), expected);
+        complete_burst(value, (uint16_t)(1023 - value));
+        expected = reference_update(value);
+
+        CHECK_EQ(adc_get_filtered(), expected);
+        CHECK_EQ(handled_count, count + 1);
+        CHECK_EQ(handled[count], expected);
+    }
+
+    check_watch_exit(1, expected, 900);
+    check_watch_exit(0, 900, 120);
+
+    // Скасування без очікування нічого не змінює
+    adc_watch_cancel();
+    CHECK_EQ(host_adc1.CR1, CR1_IDLE);
+    CHECK_EQ(tick_until_burst(), ADC_SAMPLE_PERIOD_MS);
+    complete_burst(200, 0);
+    CHECK_EQ(adc_get_filtered(), reference_update(200));
+
+    // Без обробника вибірки середнє оновлюється так само
+    adc_set_sample_handler(0);
+    count = handled_count;
+    CHECK_EQ(tick_until_burst(), ADC_SAMPLE_PERIOD_MS);
+    complete_burst(800, 0);
+    CHECK_EQ(adc_get_filtered(), reference_update(800));
+    CHECK_EQ(handled_count, count);
+
+#if (ADC_SAMPLE_PERIOD_MS == 1)
+    return TEST_RESULT("adc");
+#else
+    return TEST_RESULT("adc (slow rate, long filter)");
+#endif
+}
@@ -0,0 +1,228 @@
+/**
+ * @file    test_buttons_debounce.c
+ * @author  Olexandr Makedonskyi
+ * @brief   Відтворення дребезгу через переривання ADC
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Рівні драбини подаються помілісекундно через справжній
+ * ланцюжок прошивки: adc_trigger_tick() (тік) ->
+ * adc1_eoc_irq_handler() (пачка, фільтр) -> дебаунс кнопок ->
+ * черга подій. ADC емулюється: пачка заповнюється поточним
+ * рівнем, у режимі очікування AWD спрацьовує, коли рівень
+ * вище порогу (протягом мілісекунди перед тіком).
+ *
+ * Налаштування за замовчуванням: DEBOUNCE_SAMPLES = 20,
+ * ADC_FILTER_SIZE = 2 (перехід рівня дає одну проміжну
+ * вибірку - середнє старого та нового), смуги UP 101-579,
+ * DOWN 581-869, MODE 921-1023, гістерезис 12.
+ */
+
+//==================== INCLUDES ========================
+#include <string.h>
+
+#include "buttons.h"
+#include "eeprom.h"
+#include "test_check.h"
+
+//==================== DEFINES =========================
+
+#define LEVEL_NONE      0
+#define LEVEL_UP        300
+#define LEVEL_DOWN      700
+#define LEVEL_MODE      1000
+
+//================ PRIVATE VARIABLES ===================
+
+static uint32_t host_ms;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static void adc_step(uint16_t level);
+static void replay(const uint16_t *levels, uint8_t count);
+static void hold(uint16_t level, uint32_t until_ms);
+static uint8_t adc_watching(void);
+static void expect_event(ButtonID button, uint8_t pressed, uint16_t time_ms);
+static void expect_no_event(void);
+
+//==================== FAKES ===========================
+
+uint32_t systick_ms(void) {
+    return host_ms;
+}
+
+uint32_t systick_ms_isr(void) {
+    return host_ms;
+}
+
+/* Порожня EEPROM: діє таблиця смуг за замовчуванням */
+void eeprom_read(uint16_t offset, void *data, uint8_t size) {
+    memset(data, 0xFF, size);
+}
+
+uint8_t eeprom_write(uint16_t offset, const void *data, uint8_t size) {
+    return 0;
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Одна мілісекунда: AWD (якщо ADC чекає), тік, пачка
+ */
+static void adc_step(uint16_t level) {
+    uint16_t threshold;
+    volatile uint8_t *buffer;
+    uint8_t i;
+
+    host_ms++;
+
+    if (host_adc1.CSR & ADC1_CSR_AWDIE) {
+        threshold = (uint16_t)((host_adc1.HTRH << 2) | host_adc1.HTRL);
+        if (level > threshold) {
+            host_adc1.CSR |= ADC1_CSR_AWD;
+            adc1_eoc_irq_handler();
+        }
+    }
+
+    adc_trigger_tick();
+
+    if (host_adc1.CSR & ADC1_CSR_EOCIE) {
+        buffer = &host_adc1.DB0RH;
+        for (i = 0; i < 10; ++i) {
+            buffer[2 * i] = (uint8_t)(level >> 8);
+            buffer[2 * i + 1] = (uint8_t)level;
+        }
+        adc1_eoc_irq_handler();
+    }
+}
+
+static void replay(const uint16_t *levels, uint8_t count) {
+    uint8_t i;
+
+    for (i = 0; i < count; ++i) {
+        adc_step(levels[i]);
+    }
+}
+
+/**
+ * @brief Рівень до моменту until_ms включно
+ */
+static void hold(uint16_t level, uint32_t until_ms) {
+    while (host_ms < until_ms) {
+        adc_step(level);
+    }
+}
+
+static uint8_t adc_watching(void) {
+    return (uint8_t)((host_adc1.CSR & ADC1_CSR_AWDIE) != 0);
+}
+
+static void expect_event(ButtonID button, uint8_t pressed, uint16_t time_ms) {
+    ButtonEvent event;
+    uint8_t received = get_button_event(&event);
+
+    CHECK(received);
+    if (!received) {
+        return;
+    }
+    CHECK_EQ(event.button, button);
+    CHECK_EQ(event.pressed, pressed);
+    CHECK_EQ(event.repeat, 0);
+    CHECK_EQ(event.time_ms, time_ms);
+}
+
+static void expect_no_event(void) {
+    ButtonEvent event;
+
+    CHECK(!get_button_event(&event));
+}
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+int main(void) {
+    /*
+     * Дребезг натискання UP. Два нулі поспіль виводять середнє
+     * з смуги (NONE - стабільний стан, інтегратор -1), один
+     * нуль дає 150 - ще UP. Інтегратор не падає до нуля, тому
+     * час події - перша вибірка (100):
+     *   100: 300 (AWD, фільтр заповнюється)  UP  1
+     *   101: 0 -> 150                         UP  2
+     *   102: 0 -> 0                           NONE 1
+     *   103: 300 -> 150                       UP  2
+     *   104: 0 -> 150                         UP  3
+     *   105: 0 -> 0                           NONE 2
+     *   106: 300 -> 150, 107.. 300            UP  3..20 на 123
+     */
+    static const uint16_t press_bounce[] = {
+        LEVEL_UP, 0, 0, LEVEL_UP, 0, 0
+    };
+    /*
+     * Дребезг відпускання UP: 150 тримає UP (інтегратор 0),
+     * 0 на 304 - кандидат NONE, 305 повертає UP (інтегратор 0),
+     * тому відлік починається заново з 307:
+     *   300: 0 -> 150   301: 300 -> 150   302: 300 -> 300
+     *   303: 0 -> 150   304: 0 -> 0 NONE 1
+     *   305: 300 -> 150 UP 0   306: 0 -> 150 UP 0
+     *   307..: 0 -> 0   NONE 1..20 на 326
+     */
+    static const uint16_t release_bounce[] = {
+        0, LEVEL_UP, LEVEL_UP, 0, 0, LEVEL_UP, 0
+    };
+
+    initialize_buttons();
+
+    // Спокій: перша вибірка переводить ADC в очікування на AWD
+    hold(LEVEL_NONE, 99);
+    CHECK(adc_watching());
+    CHECK_EQ(get_button_value(), BTN_NONE);
+    expect_no_event();
+
+    replay(press_bounce, sizeof(press_bounce) / sizeof(press_bounce[0]));
+    CHECK(!adc_watching());
+    hold(LEVEL_UP, 122);
+    expect_no_event();
+    hold(LEVEL_UP, 123);
+    CHECK_EQ(get_button_value(), BTN_UP);
+    expect_event(BTN_UP, 1, 100);
+    expect_no_event();
+
+    hold(LEVEL_UP, 299);
+    replay(release_bounce, sizeof(release_bounce) / sizeof(release_bounce[0]));
+    hold(LEVEL_NONE, 325);
+    expect_no_event();
+    hold(LEVEL_NONE, 326);
+    CHECK_EQ(get_button_value(), BTN_NONE);
+    expect_event(BTN_UP, 0, 307);
+    expect_no_event();
+    CHECK(adc_watching());
+
+    /*
+     * Завада рівня DOWN на 5 мс під час спокою: кандидат DOWN
+     * (500..504, інтегратор 5), спад через смугу UP (505: 350)
+     * стає новим кандидатом, 506: 0 - стабільний NONE. Подій
+     * немає, ADC повертається в очікування
+     */
+    hold(LEVEL_NONE, 499);
+    hold(LEVEL_DOWN, 504);
+    hold(LEVEL_NONE, 507);
+    CHECK_EQ(get_button_value(), BTN_NONE);
+    expect_no_event();
+    CHECK(adc_watching());
+
+    /*
+     * Чисте натискання MODE: подія через 20 вибірок. Відпускання
+     * проходить смугу UP (700: 500), кандидат NONE - з 701
+     */
+    hold(LEVEL_NONE, 599);
+    hold(LEVEL_MODE, 618);
+    expect_no_event();
+    hold(LEVEL_MODE, 619);
+    expect_event(BTN_MODE, 1, 600);
+    hold(LEVEL_MODE, 699);
+    hold(LEVEL_NONE, 720);
+    expect_event(BTN_MODE, 0, 701);
+    expect_no_event();
+    CHECK(adc_watching());
+
+    return TEST_RESULT("buttons_debounce");
+}
@@ -0,0 +1,60 @@
+/**
+ * @file    test_check.h
+ * @author  Olexandr Makedonskyi
+ * @brief   Перевірки хост-тестів
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Кожен тест - окрема програма: перевірки рахують помилки,
+ * TEST_RESULT() друкує підсумок і повертає код завершення
+ * (0 - усі перевірки пройдено).
+ */
+
+#ifndef __TEST_CHECK_H
+#define __TEST_CHECK_H
+
+//==================== INCLUDES ========================
+#include <stdio.h>
+
+//================ PRIVATE VARIABLES ===================
+
+static int test_checks;
+static int test_failures;
+
+//==================== MACROS ==========================
+
+/**
+ * @brief Перевірка умови
+ */
+#define CHECK(cond) \
+    do { \
+        test_checks++; \
+        if (!(cond)) { \
+            test_failures++; \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+/**
+ * @brief Перевірка рівності цілих (виводить обидва значення)
+ */
+#define CHECK_EQ(actual, expected) \
+    do { \
+        long check_actual_ = (long)(actual); \
+        long check_expected_ = (long)(expected); \
+        test_checks++; \
+        if (check_actual_ != check_expected_) { \
+            test_failures++; \
+            fprintf(stderr, "%s:%d: %s == %ld, expected %s == %ld\n", __FILE__, __LINE__, \
+                    #actual, check_actual_, #expected, check_expected_); \
+        } \
+    } while (0)
+
+/**
+ * @brief Підсумок тесту та код завершення main()
+ */
+#define TEST_RESULT(name) \
+    (printf("%s: %d checks, %d failed\n", (name), test_checks, test_failures), \
+     test_failures != 0)
+
+#endif /* __TEST_CHECK_H */
@@ -0,0 +1,292 @@
+/**
+ * @file    test_hc_sr04.c
+ * @author  Olexandr Makedonskyi
+ * @brief   Дедлайн ECHO на моделі TIM2: точність в один тік
+ * @date    17.10.2026
+ * @version 1.0
+ *
+ * Модель TIM2 за RM0016 з кроком в один тік (1 мкс):
+ * - лічильник 0..ARR, на переповненні - UIF (початок періоду)
+ * - CC1IF, коли лічильник дорівнює CCR1 (вихідний канал,
+ *   прапорець не залежить від CC1E)
+ * - захоплення CH3: фронт ECHO потрібної полярності при
+ *   CC3E копіює лічильник у CCR3 та ставить CC3IF
+ * - UG скидає лічильник (без UIF: драйвер одразу чистить SR1)
+ * - SR1 - rc_w0: запис одиниці не змінює прапорець. Обробники
+ *   виконуються покроково (host_trace.h), кожен запис SR1
+ *   застосовується як "старе & записане", тому другий запис не
+ *   повертає прапорець, скинутий першим
+ * - зчитування CCRxL скидає CCxIF захопленого каналу (модель:
+ *   після обробника CC, якщо прапорець каналу був встановлений)
+ * Після кожного тіку викликаються обробники переривань з
+ * дозволеними прапорцями, основний цикл забирає вимірювання.
+ *
+ * Перевіряється, що вимірювання без відповіді коштує рівно
+ * timeout_us від тригера (±1 тік), а не період і не кількість
+ * ітерацій циклу.
+ */
+
+#define _GNU_SOURCE
+
+//==================== INCLUDES ========================
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hc_sr04.h"
+#include "host_trace.h"
+#include "test_check.h"
+
+//==================== DEFINES =========================
+
+#define PERIOD_US       60000U
+#define TIMEOUT_US      30000U
+
+/** @brief "Ніколи" для часу фронту ECHO */
+#define NEVER           0xFFFFFFFFUL
+
+//================ PRIVATE VARIABLES ===================
+
+/** @brief Час моделі, тіки TIM2 від hcsr04_ranging_start() */
+static uint32_t sim_us;
+static uint16_t tim2_cnt;
+
+/** @brief Початок поточного періоду (UIF) */
+static uint32_t period_start_us;
+
+/** @brief ECHO: високий рівень у [echo_rise_us; echo_fall_us) від початку періоду */
+static uint32_t echo_rise_us;
+static uint32_t echo_fall_us;
+static uint8_t  echo_level;
+
+static uint32_t trigger_count;
+
+/** @brief SR1 з урахуванням усіх записів обробника (rc_w0) */
+static volatile uint8_t sr1_flags;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static void tim2_tick(void);
+static void sr1_write_trap(int sig, siginfo_t *info, void *context);
+static void run_handler(void (*handler)(void));
+static void dispatch_interrupts(void);
+static void start(uint16_t period_us, uint16_t timeout_us);
+static uint8_t run_until_sample(uint32_t limit_us, HcSr04Sample *sample, uint32_t *elapsed_us);
+static void check_no_echo(uint16_t period_us, uint16_t timeout_us, uint32_t expected_us);
+
+//==================== FAKES ===========================
+
+/* Тригерний імпульс: TRIG має бути в HIGH на час затримки */
+void _delay_loops(uint8_t loops) {
+    CHECK(HCSR04_TRIG_PORT->ODR & HCSR04_TRIG_PIN);
+    CHECK(loops > 0);
+    trigger_count++;
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Один тік TIM2 та рівень ECHO
+ */
+static void tim2_tick(void) {
+    uint16_t arr = (uint16_t)((TIM2->ARRH << 8) | TIM2->ARRL);
+    uint16_t ccr1 = (uint16_t)((TIM2->CCR1H << 8) | TIM2->CCR1L);
+    uint32_t offset;
+    uint8_t level;
+    uint8_t edge;
+
+    if (TIM2->EGR & TIM2_EGR_UG) {
+        TIM2->EGR = 0;
+        tim2_cnt = 0;
+    }
+    if (!(TIM2->CR1 & TIM2_CR1_CEN)) {
+        return;
+    }
+
+    sim_us++;
+    if (tim2_cnt == arr) {
+        tim2_cnt = 0;
+        TIM2->SR1 |= TIM2_SR1_UIF;
+        period_start_us = sim_us;
+    } else {
+        tim2_cnt++;
+    }
+    if (tim2_cnt == ccr1) {
+        TIM2->SR1 |= TIM2_SR1_CC1IF;
+    }
+    TIM2->CNTRH = (uint8_t)(tim2_cnt >> 8);
+    TIM2->CNTRL = (uint8_t)tim2_cnt;
+
+    offset = sim_us - period_start_us;
+    level = (uint8_t)(offset >= echo_rise_us && offset < echo_fall_us);
+    if (echo_rise_us == 0) {
+        level = 1;
+    }
+    edge = (uint8_t)(level != echo_level);
+    echo_level = level;
+    if (level) {
+        HCSR04_ECHO_PORT->IDR |= HCSR04_ECHO_PIN;
+    } else {
+        HCSR04_ECHO_PORT->IDR &= (uint8_t)~HCSR04_ECHO_PIN;
+    }
+
+    if (edge && (TIM2->CCER2 & TIM2_CCER2_CC3E) &&
+        level == ((TIM2->CCER2 & TIM2_CCER2_CC3P) ? 0 : 1)) {
+        TIM2->CCR3H = (uint8_t)(tim2_cnt >> 8);
+        TIM2->CCR3L = (uint8_t)tim2_cnt;
+        TIM2->SR1 |= TIM2_SR1_CC3IF;
+    }
+}
+
+/**
+ * @brief Після кожної інструкції обробника: запис у SR1 лише
+ *        скидає прапорці, одиниці ігноруються
+ */
+static void sr1_write_trap(int sig, siginfo_t *info, void *context) {
+    uint8_t written = TIM2->SR1;
+
+    (void)sig;
+    (void)info;
+    (void)context;
+
+    if (written != sr1_flags) {
+        sr1_flags &= written;
+        TIM2->SR1 = sr1_flags;
+    }
+}
+
+static void run_handler(void (*handler)(void)) {
+    sr1_flags = TIM2->SR1;
+    host_trace_on();
+    handler();
+    host_trace_off();
+}
+
+static void dispatch_interrupts(void) {
+    uint8_t pending;
+    uint8_t captured;
+    int guard;
+
+    for (guard = 0; guard < 8; ++guard) {
+        pending = (uint8_t)(TIM2->SR1 & TIM2->IER);
+        if (pending & TIM2_SR1_UIF) {
+            run_handler(hcsr04_tim2_update_irq_handler);
+        } else if (pending & (TIM2_SR1_CC1IF | TIM2_SR1_CC2IF | TIM2_SR1_CC3IF)) {
+            captured = (uint8_t)(TIM2->SR1 & (TIM2_SR1_CC2IF | TIM2_SR1_CC3IF));
+            run_handler(hcsr04_tim2_cc_irq_handler);
+            TIM2->SR1 &= (uint8_t)~captured;
+        } else {
+            return;
+        }
+    }
+    CHECK(!"interrupt flag never cleared");
+}
+
+static void start(uint16_t period_us, uint16_t timeout_us) {
+    HcSr04Sample sample;
+
+    hcsr04_ranging_start(period_us, timeout_us);
+    while (hcsr04_read_sample(&sample)) {
+    }
+    sim_us = 0;
+    period_start_us = 0;
+    trigger_count = 0;
+}
+
+/**
+ * @brief Модель до першого вимірювання в черзі
+ *
+ * Час моделі та час драйвера (timestamp_us) обидва рахуються
+ * від hcsr04_ranging_start().
+ *
+ * @param[out] elapsed_us Від тригера (початку періоду) до вимірювання
+ */
+static uint8_t run_until_sample(uint32_t limit_us, HcSr04Sample *sample, uint32_t *elapsed_us) {
+    while (sim_us < limit_us) {
+        tim2_tick();
+        dispatch_interrupts();
+        if (hcsr04_read_sample(sample)) {
+            *elapsed_us = sim_us - sample->timestamp_us;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Немає відповіді: вимірювання рівно на дедлайні
+ */
+static void check_no_echo(uint16_t period_us, uint16_t timeout_us, uint32_t expected_us) {
+    HcSr04Sample sample;
+    uint32_t elapsed = 0;
+
+    echo_rise_us = NEVER;
+    echo_fall_us = NEVER;
+    start(period_us, timeout_us);
+
+    CHECK(run_until_sample(3UL * period_us, &sample, &elapsed));
+    CHECK_EQ(sample.status, HCSR04_ECHO_NO_RISE);
+    CHECK_EQ(sample.timestamp_us, period_us);
+    CHECK(labs((long)elapsed - (long)expected_us) <= 1);
+    if (expected_us < period_us) {
+        CHECK_EQ(trigger_count, 1);
+    }
+}
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+int main(void) {
+#if HOST_TRACE_SUPPORTED
+    struct sigaction action;
+    HcSr04Sample sample;
+    uint32_t elapsed = 0;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = sr1_write_trap;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGTRAP, &action, 0);
+
+    hcsr04_gpio_init();
+
+    // Немає об'єкта: вартість - рівно дедлайн, для будь-якого дедлайну
+    check_no_echo(PERIOD_US, TIMEOUT_US, TIMEOUT_US);
+    check_no_echo(PERIOD_US, 1000, 1000);
+    check_no_echo(PERIOD_US, 12345, 12345);
+    check_no_echo(40000, 38000, 38000);
+
+    // Дедлайн за межами періоду: вимірювання закриває переповнення
+    check_no_echo(20000, TIMEOUT_US, 20000);
+
+    // Відбиття: результат одразу на спадному фронті, тривалість точна
+    echo_rise_us = 500;
+    echo_fall_us = 500 + 5800;
+    start(PERIOD_US, TIMEOUT_US);
+    CHECK(run_until_sample(2UL * PERIOD_US, &sample, &elapsed));
+    CHECK_EQ(sample.status, HCSR04_ECHO_OK);
+    CHECK_EQ(sample.pulse_us, 5800);
+    CHECK_EQ(elapsed, 500 + 5800);
+
+    // Відбиття не закінчилось до дедлайну: тривалість - до дедлайну
+    echo_rise_us = 1000;
+    echo_fall_us = NEVER;
+    start(PERIOD_US, TIMEOUT_US);
+    CHECK(run_until_sample(2UL * PERIOD_US, &sample, &elapsed));
+    CHECK_EQ(sample.status, HCSR04_ECHO_NO_FALL);
+    CHECK_EQ(sample.pulse_us, TIMEOUT_US - 1000);
+    CHECK(labs((long)elapsed - (long)TIMEOUT_US) <= 1);
+
+    // ECHO в HIGH ще до тригера: лінія залипла
+    echo_rise_us = 0;
+    echo_fall_us = NEVER;
+    start(PERIOD_US, TIMEOUT_US);
+    CHECK(run_until_sample(2UL * PERIOD_US, &sample, &elapsed));
+    CHECK_EQ(sample.status, HCSR04_ECHO_STUCK_HIGH);
+    CHECK(labs((long)elapsed - (long)TIMEOUT_US) <= 1);
+
+    return TEST_RESULT("hc_sr04");
+#else
+    printf("hc_sr04: skipped (rc_w0 model needs single-step, x86-64)\n");
+    return 0;
+#endif
+}
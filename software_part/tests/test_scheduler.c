@@ -0,0 +1,346 @@
+/**
+ * @file    test_scheduler.c
+ * @author  Olexandr Makedonskyi
+ * @brief   Облік простою, навантаження та монітор дедлайнів планувальника
+ * @date    17.10.2026
+ * @version 1.0
+ *
+ * Час задає тест: systick_us() - лічильник хоста, задача
+ * збільшує його на свій час виконання, systick_idle_wait()
+ * "спить" до наступної мілісекунди (або на заданий час).
+ * Основний цикл - як у main(): scheduler_dispatch(), якщо
+ * нічого не виконано - scheduler_idle().
+ *
+ * - Простій та загальний час за 1 с з двома задачами (30%
+ *   навантаження), scheduler_idle_us() та нове вікно
+ * - Ділення лічильників навпіл на SCHEDULER_LOAD_LIMIT_US:
+ *   навантаження не змінюється, сумарний простій не ділиться
+ * - Монітор дедлайнів: IWDG оновлюється на кожному виклику,
+ *   крім перевищення виконаною задачею та простроченої задачі
+ *   в черзі; причина скидання - задача, що прострочила дедлайн
+ *   або виконувалась під час скидання
+ */
+
+//==================== INCLUDES ========================
+#include "scheduler.h"
+#include "systick.h"
+#include "watchdog.h"
+#include "test_check.h"
+
+//==================== DEFINES =========================
+
+#define TASK_COUNT          3
+
+/** @brief Поріг ділення навпіл (scheduler.c) */
+#define LOAD_LIMIT_US       0x80000000UL
+
+//================ PRIVATE VARIABLES ===================
+
+static uint32_t host_us;
+
+/** @brief Тривалість сну systick_idle_wait() (0 - до наступної мілісекунди) */
+static uint32_t idle_sleep_us;
+
+static uint32_t watchdog_inits;
+static uint32_t watchdog_refreshes;
+static uint8_t  reset_flags;
+
+static uint32_t task_cost_us[TASK_COUNT];
+static uint32_t task_runs[TASK_COUNT];
+
+/** @brief Причина скидання, яку побачила задача 2 ("скидання" під час виконання) */
+static SchedulerResetInfo reset_in_task;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static void task_0(void);
+static void task_1(void);
+static void task_2(void);
+static uint32_t run_until(uint32_t until_us);
+static uint8_t dispatch_refreshed(void);
+static void check_load_accounting(void);
+static void check_load_halving(void);
+static void check_deadline_monitor(void);
+
+//==================== FAKES ===========================
+
+uint32_t systick_ms(void) {
+    return host_us / 1000;
+}
+
+uint32_t systick_us(void) {
+    return host_us;
+}
+
+void systick_idle_wait(void) {
+    if (idle_sleep_us != 0) {
+        host_us += idle_sleep_us;
+    } else {
+        host_us = (host_us / 1000 + 1) * 1000;
+    }
+}
+
+void watchdog_init(void) {
+    watchdog_inits++;
+}
+
+void watchdog_refresh(void) {
+    watchdog_refreshes++;
+}
+
+uint8_t watchdog_take_reset_flags(void) {
+    uint8_t flags = reset_flags;
+
+    reset_flags = 0;
+    return flags;
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+static void task_0(void) {
+    task_runs[0]++;
+    host_us += task_cost_us[0];
+}
+
+static void task_1(void) {
+    task_runs[1]++;
+    host_us += task_cost_us[1];
+}
+
+/**
+ * @brief Задача, під час якої MCU "скидає" IWDG: облік
+ *        причини бачить задачу, що виконувалась
+ */
+static void task_2(void) {
+    task_runs[2]++;
+    host_us += task_cost_us[2];
+
+    reset_flags = WATCHDOG_RESET_IWDG;
+    scheduler_monitor_boot();
+    scheduler_get_reset_info(&reset_in_task);
+}
+
+/**
+ * @brief Основний цикл до моменту until_us
+ *
+ * @return Кількість викликів scheduler_dispatch()
+ */
+static uint32_t run_until(uint32_t until_us) {
+    uint32_t dispatches = 0;
+
+    while (host_us < until_us) {
+        dispatches++;
+        if (!scheduler_dispatch()) {
+            scheduler_idle();
+        }
+    }
+    return dispatches;
+}
+
+/**
+ * @brief Один виклик scheduler_dispatch()
+ *
+ * @return 1 - IWDG оновлено
+ */
+static uint8_t dispatch_refreshed(void) {
+    uint32_t refreshes = watchdog_refreshes;
+
+    scheduler_dispatch();
+    return (uint8_t)(watchdog_refreshes != refreshes);
+}
+
+/**
+ * @brief 2 мс кожні 10 мс та 0.5 мс кожні 5 мс: 30% навантаження
+ */
+static void check_load_accounting(void) {
+    static const SchedulerTask tasks[] = {
+        { task_0, 10, 0 },
+        { task_1, 5,  0 }
+    };
+    SchedulerLoadStats load;
+    SchedulerTaskStats stats;
+    uint32_t idle_before;
+
+    host_us = 0;
+    idle_sleep_us = 0;
+    task_cost_us[0] = 2000;
+    task_cost_us[1] = 500;
+    task_runs[0] = 0;
+    task_runs[1] = 0;
+
+    scheduler_init(tasks, 2);
+    CHECK_EQ(watchdog_inits, 1);
+    idle_before = scheduler_idle_us();
+
+    run_until(1000000UL);
+    CHECK_EQ(task_runs[0], 100);
+    CHECK_EQ(task_runs[1], 200);
+
+    scheduler_get_load(&load);
+    CHECK_EQ(load.elapsed_ms, 1000);
+    CHECK_EQ(load.idle_ms, 700);
+    CHECK_EQ(load.load_percent, 30);
+    CHECK_EQ(scheduler_idle_us() - idle_before, 700000UL);
+
+    scheduler_get_stats(0, &stats);
+    CHECK_EQ(stats.runs, 100);
+    CHECK_EQ(stats.wcet_us, 2000);
+    scheduler_get_stats(1, &stats);
+    CHECK_EQ(stats.wcet_us, 500);
+
+    // Нове вікно: сумарний простій продовжує рахуватись
+    scheduler_reset_load();
+    scheduler_get_load(&load);
+    CHECK_EQ(load.elapsed_ms, 0);
+    CHECK_EQ(load.idle_ms, 0);
+    CHECK_EQ(load.load_percent, 0);
+
+    scheduler_cancel(0);
+    scheduler_cancel(1);
+    run_until(1100000UL);
+    scheduler_get_load(&load);
+    CHECK_EQ(load.elapsed_ms, 100);
+    CHECK_EQ(load.idle_ms, 100);
+    CHECK_EQ(load.load_percent, 0);
+    CHECK_EQ(scheduler_idle_us() - idle_before, 800000UL);
+}
+
+/**
+ * @brief Вікно переходить SCHEDULER_LOAD_LIMIT_US: 3/4 простою,
+ *        1/4 роботи; після ділення співвідношення те саме
+ */
+static void check_load_halving(void) {
+    SchedulerLoadStats before;
+    SchedulerLoadStats after;
+    uint32_t idle_before;
+    uint32_t elapsed_us;
+
+    host_us = 1000;
+    scheduler_reset_load();
+    idle_before = scheduler_idle_us();
+
+    idle_sleep_us = 0x60000000UL;
+    scheduler_idle();
+    host_us += 0x20000000UL - 10;
+    scheduler_get_load(&before);
+    CHECK_EQ(before.elapsed_ms, (LOAD_LIMIT_US - 10) / 1000);
+
+    idle_sleep_us = 20;
+    scheduler_idle();
+    elapsed_us = LOAD_LIMIT_US + 10;
+    scheduler_get_load(&after);
+    CHECK_EQ(after.elapsed_ms, (elapsed_us >> 1) / 1000);
+    CHECK_EQ(after.idle_ms, ((0x60000000UL + 20) >> 1) / 1000);
+    CHECK_EQ(after.load_percent, before.load_percent);
+    CHECK(after.load_percent >= 24 && after.load_percent <= 25);
+
+    // Сумарний простій не ділиться
+    CHECK_EQ(scheduler_idle_us() - idle_before, 0x60000000UL + 20);
+    idle_sleep_us = 0;
+}
+
+static void check_deadline_monitor(void) {
+    static const SchedulerTask tasks[TASK_COUNT] = {
+        { task_0, 0,  2 },      /* одноразова, дедлайн 2 мс */
+        { task_1, 10, 5 },      /* періодична, дедлайн 5 мс */
+        { task_2, 0,  0 }       /* одноразова без контролю */
+    };
+    SchedulerOverrunStats overrun;
+    SchedulerResetInfo info;
+    uint32_t refreshes;
+    uint32_t dispatches;
+    uint8_t i;
+
+    // Вмикання живлення: таблиця в .noinit невалідна
+    reset_flags = 0;
+    scheduler_monitor_boot();
+    scheduler_get_reset_info(&info);
+    CHECK_EQ(info.watchdog_resets, 0);
+    CHECK_EQ(info.task, SCHEDULER_NO_TASK);
+
+    host_us = 0;
+    idle_sleep_us = 0;
+    watchdog_inits = 0;
+    for (i = 0; i < TASK_COUNT; ++i) {
+        task_cost_us[i] = 0;
+        task_runs[i] = 0;
+    }
+    task_cost_us[1] = 1000;
+    scheduler_init(tasks, TASK_COUNT);
+    CHECK_EQ(watchdog_inits, 1);
+
+    // Всі задачі встигають: IWDG оновлюється на кожному виклику
+    refreshes = watchdog_refreshes;
+    dispatches = run_until(50000UL);
+    CHECK_EQ(watchdog_refreshes - refreshes, dispatches);
+    CHECK_EQ(task_runs[1], 5);
+    scheduler_get_overrun(1, &overrun);
+    CHECK_EQ(overrun.count, 0);
+
+    // Задача виконується 7 мс при дедлайні 5 мс
+    task_cost_us[1] = 7000;
+    CHECK(!dispatch_refreshed());
+    scheduler_get_overrun(1, &overrun);
+    CHECK_EQ(overrun.count, 1);
+    CHECK_EQ(overrun.max_over_ms, 2);
+    task_cost_us[1] = 1000;
+    CHECK(dispatch_refreshed());
+
+    /*
+     * Задача 0 чекає в черзі (до 61 мс), задача 1 з 60 мс
+     * займає CPU 4 мс: задача 0 не запущена, але вже прострочена -
+     * IWDG не оновлюється, хоча виконана задача встигла
+     */
+    scheduler_run_after(0, 4);
+    run_until(60000UL);
+    task_cost_us[1] = 4000;
+    CHECK(!dispatch_refreshed());
+    CHECK_EQ(task_runs[0], 0);
+    scheduler_get_overrun(1, &overrun);
+    CHECK_EQ(overrun.count, 1);
+
+    CHECK(!dispatch_refreshed());
+    CHECK_EQ(task_runs[0], 1);
+    scheduler_get_overrun(0, &overrun);
+    CHECK_EQ(overrun.count, 1);
+    CHECK_EQ(overrun.max_over_ms, 1);
+    task_cost_us[1] = 1000;
+
+    // Скидання IWDG після перевищення: винуватець - задача 0
+    reset_flags = WATCHDOG_RESET_IWDG;
+    scheduler_monitor_boot();
+    scheduler_get_reset_info(&info);
+    CHECK_EQ(info.reset_flags, WATCHDOG_RESET_IWDG);
+    CHECK_EQ(info.watchdog_resets, 1);
+    CHECK_EQ(info.task, 0);
+    CHECK_EQ(info.hung, 0);
+    scheduler_get_overrun(1, &overrun);
+    CHECK_EQ(overrun.count, 1);
+
+    // Скидання під час виконання задачі 2: зависання
+    scheduler_run_after(2, 0);
+    scheduler_dispatch();
+    CHECK_EQ(task_runs[2], 1);
+    CHECK_EQ(reset_in_task.watchdog_resets, 2);
+    CHECK_EQ(reset_in_task.task, 2);
+    CHECK_EQ(reset_in_task.hung, 1);
+
+    // Прошивка (SWIM) очищує таблицю
+    reset_flags = WATCHDOG_RESET_SWIM;
+    scheduler_monitor_boot();
+    scheduler_get_reset_info(&info);
+    CHECK_EQ(info.watchdog_resets, 0);
+    CHECK_EQ(info.task, SCHEDULER_NO_TASK);
+    scheduler_get_overrun(0, &overrun);
+    CHECK_EQ(overrun.count, 0);
+}
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+int main(void) {
+    check_load_accounting();
+    check_load_halving();
+    check_deadline_monitor();
+
+    return TEST_RESULT("scheduler");
+}
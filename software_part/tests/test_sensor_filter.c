@@ -0,0 +1,193 @@
+/**
+ * @file    test_sensor_filter.c
+ * @author  Olexandr Makedonskyi
+ * @brief   Перевірка фільтра вимірювань та його вартості на вимірювання
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Збирається двічі: з медіаною (sensor_filter) та з усіченим
+ * середнім (sensor_filter_trimmed, див. Makefile).
+ *
+ * - Результат кожного оновлення порівнюється з еталоном:
+ *   повне сортування поточного вікна
+ * - Поодинокий викид не проходить на вихід
+ * - Вартість оновлення: такти хоста (rdtsc) на вимірювання
+ *   для випадкових значень та спадної послідовності (кожна
+ *   вставка зсуває всю відсортовану копію).
+ *   Лише для порівняння варіантів: такти STM8 дає
+ *   PROFILER_ZONE_FILTER на платі
+ */
+
+//==================== INCLUDES ========================
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "sensor_filter.h"
+#include "test_check.h"
+
+//==================== DEFINES =========================
+
+#define RANDOM_SAMPLES      20000
+#define BENCH_SAMPLES       4096
+#define BENCH_ROUNDS        50
+
+//================ PRIVATE VARIABLES ===================
+
+/** @brief Еталонне вікно (хронологічний порядок) */
+static uint16_t reference_window[SENSOR_FILTER_WINDOW];
+static uint8_t  reference_count;
+static uint8_t  reference_index;
+
+static uint32_t random_state = 12345;
+
+/** @brief Вхід вимірювання вартості (генератор не входить у час) */
+static uint16_t bench_input[BENCH_SAMPLES];
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static uint16_t random_u16(void);
+static uint16_t reference_update(uint16_t time_us);
+static void check_against_reference(uint16_t range);
+static void check_spike(void);
+static void bench(const char *name, int descending);
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+static uint16_t random_u16(void) {
+    random_state = random_state * 1103515245u + 12345u;
+    return (uint16_t)(random_state >> 16);
+}
+
+/**
+ * @brief Еталон: сортування копії вікна на кожному вимірюванні
+ */
+static uint16_t reference_update(uint16_t time_us) {
+    uint16_t sorted[SENSOR_FILTER_WINDOW];
+    uint16_t value;
+    uint32_t sum = 0;
+    uint8_t i;
+    uint8_t j;
+
+    reference_window[reference_index] = time_us;
+    reference_index = (uint8_t)((reference_index + 1) % SENSOR_FILTER_WINDOW);
+    if (reference_count < SENSOR_FILTER_WINDOW) {
+        reference_count++;
+    }
+
+    memcpy(sorted, reference_window, sizeof(sorted));
+    for (i = 1; i < reference_count; ++i) {
+        value = sorted[i];
+        for (j = i; j > 0 && sorted[j - 1] > value; --j) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+
+#if (SENSOR_FILTER_MODE == SENSOR_FILTER_MODE_TRIMMED_MEAN)
+    {
+        uint8_t trim = SENSOR_FILTER_TRIM;
+        uint8_t used;
+
+        if (2 * trim >= reference_count) {
+            trim = (uint8_t)((reference_count - 1) / 2);
+        }
+        used = (uint8_t)(reference_count - 2 * trim);
+        for (i = trim; i < reference_count - trim; ++i) {
+            sum += sorted[i];
+        }
+        return (uint16_t)((sum + used / 2) / used);
+    }
+#else
+    (void)sum;
+    return sorted[reference_count / 2];
+#endif
+}
+
+/**
+ * @brief Випадкові значення з діапазону range (малий діапазон -
+ *        багато однакових значень у вікні)
+ */
+static void check_against_reference(uint16_t range) {
+    uint16_t value;
+    int n;
+    int mismatches = 0;
+
+    sensor_filter_reset();
+    reference_count = 0;
+    reference_index = 0;
+
+    for (n = 0; n < RANDOM_SAMPLES; ++n) {
+        value = (uint16_t)(1 + random_u16() % range);
+        if (sensor_filter_update(0, value) != reference_update(value)) {
+            mismatches++;
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+/**
+ * @brief Поодинокий хибний час відбиття не змінює результат
+ */
+static void check_spike(void) {
+    int n;
+
+    sensor_filter_reset();
+    for (n = 0; n < SENSOR_FILTER_WINDOW; ++n) {
+        CHECK_EQ(sensor_filter_update(0, 5800), 5800);
+    }
+    CHECK_EQ(sensor_filter_update(0, 30000), 5800);
+    for (n = 0; n < SENSOR_FILTER_WINDOW; ++n) {
+        CHECK_EQ(sensor_filter_update(0, 5800), 5800);
+    }
+}
+
+static void bench(const char *name, int descending) {
+#if defined(__x86_64__) || defined(__i386__)
+    volatile uint16_t sink = 0;
+    uint64_t start;
+    uint64_t cycles;
+    int round;
+    int n;
+
+    for (n = 0; n < BENCH_SAMPLES; ++n) {
+        bench_input[n] = descending ? (uint16_t)(60000 - n) :
+                                      (uint16_t)(1 + random_u16() % 60000);
+    }
+
+    sensor_filter_reset();
+    start = __rdtsc();
+    for (round = 0; round < BENCH_ROUNDS; ++round) {
+        for (n = 0; n < BENCH_SAMPLES; ++n) {
+            sink = sensor_filter_update(0, bench_input[n]);
+        }
+    }
+    cycles = __rdtsc() - start;
+    (void)sink;
+
+    printf("sensor_filter: window %d, %s: %.1f host cycles/sample\n", SENSOR_FILTER_WINDOW,
+           name, (double)cycles / ((double)BENCH_SAMPLES * BENCH_ROUNDS));
+#else
+    (void)name;
+    (void)descending;
+#endif
+}
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+int main(void) {
+    check_against_reference(60000);
+    check_against_reference(4);
+    check_spike();
+
+    bench("random", 0);
+    bench("descending", 1);
+
+#if (SENSOR_FILTER_MODE == SENSOR_FILTER_MODE_TRIMMED_MEAN)
+    return TEST_RESULT("sensor_filter (trimmed mean)");
+#else
+    return TEST_RESULT("sensor_filter (median)");
+#endif
+}
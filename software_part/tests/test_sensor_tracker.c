@@ -0,0 +1,158 @@
+/**
+ * @file    test_sensor_tracker.c
+ * @author  Olexandr Makedonskyi
+ * @brief   Відтворення траєкторії через альфа-бета трекер
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * Об'єкт наближається з 2000 мм по 20 мм за вимірювання
+ * (період 60 мс: -333 мм/с). На траєкторію накладаються:
+ * - викид +600 мм (відбиття від іншого об'єкта)
+ * - два пропуски відбиття (рух за прогнозом) та три
+ *   (SENSOR_TRACKER_MAX_MISSES: втрата, повторне захоплення)
+ * - стрибок на 2500 мм (перешкоду прибрали): два вимірювання
+ *   відкидаються, третє перезахоплює об'єкт
+ * - межа вікна: відхилення 201 мм відкидається, 200 - ні
+ */
+
+//==================== INCLUDES ========================
+#include <stdlib.h>
+
+#include "sensor_tracker.h"
+#include "test_check.h"
+
+//==================== DEFINES =========================
+
+#define PERIOD_US       60000U
+#define START_MM        2000
+#define STEP_MM         20
+
+/** @brief Швидкість наближення: -20 мм за 60 мс */
+#define APPROACH_MM_S   (-333)
+
+//================ PRIVATE VARIABLES ===================
+
+static DistanceTrack track;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static int32_t true_mm(int k);
+static void step(uint16_t distance_mm, uint8_t accepted);
+static void expect_on_trajectory(int k, int32_t velocity_tolerance);
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+static int32_t true_mm(int k) {
+    return START_MM - STEP_MM * k;
+}
+
+/**
+ * @brief Вимірювання та перевірка рішення вікна
+ */
+static void step(uint16_t distance_mm, uint8_t accepted) {
+    CHECK_EQ(sensor_tracker_update(0, distance_mm, &track), accepted);
+}
+
+/**
+ * @brief Оцінка на траєкторії після вимірювання k, вікно -
+ *        навколо прогнозу на k + 1
+ */
+static void expect_on_trajectory(int k, int32_t velocity_tolerance) {
+    int32_t centre = ((int32_t)track.window_min_mm + track.window_max_mm) / 2;
+
+    CHECK(labs((long)track.distance_mm - true_mm(k)) <= 1);
+    CHECK(labs((long)track.velocity_mm_s - APPROACH_MM_S) <= velocity_tolerance);
+    CHECK_EQ(track.window_max_mm - track.window_min_mm, 2 * SENSOR_TRACKER_GATE_MM);
+    CHECK(labs((long)centre - true_mm(k + 1)) <= 1);
+}
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+int main(void) {
+    int k;
+
+    sensor_tracker_reset();
+    sensor_tracker_set_period(PERIOD_US, 1);
+
+    // Захоплення: перше вимірювання, швидкість 0
+    step(START_MM, 1);
+    CHECK_EQ(track.distance_mm, START_MM);
+    CHECK_EQ(track.velocity_mm_s, 0);
+    CHECK_EQ(track.window_min_mm, START_MM - SENSOR_TRACKER_GATE_MM);
+    CHECK_EQ(track.window_max_mm, START_MM + SENSOR_TRACKER_GATE_MM);
+
+    // Стале наближення: критично демпфований трекер сходиться
+    for (k = 1; k < 30; ++k) {
+        step((uint16_t)true_mm(k), 1);
+    }
+    expect_on_trajectory(29, 2);
+
+    // Викид: відкидається, оцінка йде за прогнозом
+    step((uint16_t)(true_mm(30) + 600), 0);
+    expect_on_trajectory(30, 2);
+    for (k = 31; k < 35; ++k) {
+        step((uint16_t)true_mm(k), 1);
+    }
+    expect_on_trajectory(34, 2);
+
+    // Два пропуски - менше SENSOR_TRACKER_MAX_MISSES: рух за прогнозом
+    step(0, 0);
+    expect_on_trajectory(35, 2);
+    step(0, 0);
+    expect_on_trajectory(36, 2);
+    for (k = 37; k < 41; ++k) {
+        step((uint16_t)true_mm(k), 1);
+    }
+    expect_on_trajectory(40, 2);
+
+    // Три пропуски поспіль: об'єкт втрачено
+    step(0, 0);
+    step(0, 0);
+    expect_on_trajectory(42, 2);
+    step(0, 0);
+    CHECK_EQ(track.distance_mm, 0);
+    CHECK_EQ(track.velocity_mm_s, 0);
+    CHECK_EQ(track.window_min_mm, 0);
+    CHECK_EQ(track.window_max_mm, DISTANCE_SENSOR_MAX_MM);
+
+    // Повторне захоплення та нове сходження
+    step((uint16_t)true_mm(44), 1);
+    CHECK_EQ(track.distance_mm, true_mm(44));
+    CHECK_EQ(track.velocity_mm_s, 0);
+    for (k = 45; k < 60; ++k) {
+        step((uint16_t)true_mm(k), 1);
+    }
+    expect_on_trajectory(59, 10);
+
+    // Стрибок на 2500 мм: два вимірювання поза вікном, третє - перезахоплення
+    step(2500, 0);
+    expect_on_trajectory(60, 10);
+    step(2500, 0);
+    expect_on_trajectory(61, 10);
+    step(2500, 1);
+    CHECK_EQ(track.distance_mm, 2500);
+    CHECK_EQ(track.velocity_mm_s, 0);
+    CHECK_EQ(track.window_min_mm, 2500 - SENSOR_TRACKER_GATE_MM);
+    CHECK_EQ(track.window_max_mm, 2500 + SENSOR_TRACKER_GATE_MM);
+    for (k = 0; k < 8; ++k) {
+        step(2500, 1);
+    }
+    CHECK_EQ(track.distance_mm, 2500);
+    CHECK_EQ(track.velocity_mm_s, 0);
+
+    /*
+     * Межа вікна: 201 мм від прогнозу - викид, 200 мм - корекція
+     * pos = 2500 + 0.5 * 200 = 2600,
+     * vel = round(200 * 16 * 43 / 256) = 538 (Q4) -> 560 мм/с,
+     * прогноз (2600 * 16 + 538) >> 4 = 2633
+     */
+    step(2500 + SENSOR_TRACKER_GATE_MM + 1, 0);
+    CHECK_EQ(track.distance_mm, 2500);
+    step(2500 + SENSOR_TRACKER_GATE_MM, 1);
+    CHECK_EQ(track.distance_mm, 2600);
+    CHECK_EQ(track.velocity_mm_s, 560);
+    CHECK_EQ(track.window_min_mm, 2633 - SENSOR_TRACKER_GATE_MM);
+    CHECK_EQ(track.window_max_mm, 2633 + SENSOR_TRACKER_GATE_MM);
+
+    return TEST_RESULT("sensor_tracker");
+}
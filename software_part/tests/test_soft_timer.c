@@ -0,0 +1,321 @@
+/**
+ * @file    test_soft_timer.c
+ * @author  Olexandr Makedonskyi
+ * @brief   Колесо таймерів: спрацювання при повному пулі та вартість
+ * @date    17.10.2026
+ * @version 1.0
+ *
+ * Збирається двічі: з налаштуваннями прошивки (soft_timer) та з
+ * пулом 64 таймери (soft_timer_wide, див. Makefile) - вартість
+ * запуску не повинна залежати від заповнення пулу.
+ *
+ * - Всі таймери зайняті: кожен спрацьовує рівно на своєму тіку,
+ *   наступний запуск повертає SOFT_TIMER_NONE
+ * - Затримки довші за оберт колеса, 0 та понад максимум
+ * - Скасування, перезапуск з callback при повному пулі,
+ *   відставання основного циклу, переповнення 16-бітного тіку
+ * - Вартість: такти хоста (rdtsc) на запуск, на спрацювання та
+ *   на тік з повною коміркою, що чекає наступного оберту.
+ *   Лише для порівняння варіантів: такти STM8 дає профайлер
+ *   на платі
+ */
+
+//==================== INCLUDES ========================
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "soft_timer.h"
+#include "systick.h"
+#include "test_check.h"
+
+//==================== DEFINES =========================
+
+#define BENCH_ROUNDS        20000
+
+/** @brief Більше, ніж таймерів: місце для перезапусків з callback */
+#define FIRED_MAX           (2 * SOFT_TIMER_SLOTS + 4)
+
+//================ PRIVATE VARIABLES ===================
+
+static uint32_t host_ms;
+
+/** @brief Час кожного спрацювання у порядку викликів */
+static uint32_t fired_ms[FIRED_MAX];
+static uint8_t  fired_count;
+
+/** @brief Затримка перезапуску з callback (0 - без перезапуску) */
+static uint16_t rearm_delay_ms;
+static uint8_t  rearm_id;
+
+static volatile uint32_t bench_calls;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static void on_timer(void);
+static void on_timer_rearm(void);
+static void on_bench(void);
+static void reset(uint32_t now_ms);
+static void advance(uint32_t until_ms);
+static void check_full_pool(uint32_t start_ms);
+static void check_delay_limits(void);
+static void check_cancel(void);
+static void check_rearm_from_callback(void);
+static void check_late_processing(void);
+static void bench(void);
+
+//==================== FAKES ===========================
+
+uint32_t systick_ms(void) {
+    return host_ms;
+}
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+static void on_timer(void) {
+    if (fired_count < FIRED_MAX) {
+        fired_ms[fired_count] = host_ms;
+    }
+    fired_count++;
+}
+
+/**
+ * @brief Спрацювання з перезапуском: пул повний, звільнений
+ *        таймер має бути доступний вже в callback
+ */
+static void on_timer_rearm(void) {
+    on_timer();
+    if (rearm_delay_ms != 0) {
+        rearm_id = soft_timer_start(on_timer, rearm_delay_ms);
+        rearm_delay_ms = 0;
+    }
+}
+
+static void on_bench(void) {
+    bench_calls++;
+}
+
+static void reset(uint32_t now_ms) {
+    host_ms = now_ms;
+    fired_count = 0;
+    soft_timer_init();
+}
+
+/**
+ * @brief Основний цикл викликає обробку кожну мілісекунду
+ */
+static void advance(uint32_t until_ms) {
+    while (host_ms < until_ms) {
+        host_ms++;
+        soft_timer_process();
+    }
+}
+
+/**
+ * @brief Всі таймери зайняті, затримки вперемішку: короткі,
+ *        довші за оберт, кілька в одній комірці
+ */
+static void check_full_pool(uint32_t start_ms) {
+    uint16_t delays[SOFT_TIMER_SLOTS];
+    uint16_t sorted[SOFT_TIMER_SLOTS];
+    uint16_t value;
+    uint8_t i;
+    uint8_t j;
+
+    reset(start_ms);
+    for (i = 0; i < SOFT_TIMER_SLOTS; ++i) {
+        delays[i] = (uint16_t)(1 + (i * 37U + (i & 1) * SOFT_TIMER_WHEEL_SIZE * 3U) %
+                               (SOFT_TIMER_WHEEL_SIZE * 5U));
+        CHECK(soft_timer_start(on_timer, delays[i]) != SOFT_TIMER_NONE);
+    }
+    CHECK_EQ(soft_timer_start(on_timer, 1), SOFT_TIMER_NONE);
+
+    for (i = 0; i < SOFT_TIMER_SLOTS; ++i) {
+        value = delays[i];
+        for (j = i; j > 0 && sorted[j - 1] > value; --j) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+
+    advance(start_ms + SOFT_TIMER_WHEEL_SIZE * 6U);
+    CHECK_EQ(fired_count, SOFT_TIMER_SLOTS);
+    for (i = 0; i < SOFT_TIMER_SLOTS; ++i) {
+        CHECK_EQ(fired_ms[i] - start_ms, sorted[i]);
+    }
+
+    // Всі таймери повернулись у пул
+    for (i = 0; i < SOFT_TIMER_SLOTS; ++i) {
+        CHECK(soft_timer_start(on_timer, 1) != SOFT_TIMER_NONE);
+    }
+    CHECK_EQ(soft_timer_start(on_timer, 1), SOFT_TIMER_NONE);
+}
+
+static void check_delay_limits(void) {
+    reset(1000);
+    CHECK(soft_timer_start(on_timer, 0) != SOFT_TIMER_NONE);
+    advance(1000 + SOFT_TIMER_WHEEL_SIZE);
+    CHECK_EQ(fired_count, 1);
+    CHECK_EQ(fired_ms[0], 1001);
+
+    // Понад максимум - обмежується SOFT_TIMER_MAX_DELAY_MS
+    reset(1000);
+    CHECK(soft_timer_start(on_timer, 0xFFFF) != SOFT_TIMER_NONE);
+    advance(1000 + SOFT_TIMER_MAX_DELAY_MS - 1);
+    CHECK_EQ(fired_count, 0);
+    advance(1000 + SOFT_TIMER_MAX_DELAY_MS);
+    CHECK_EQ(fired_count, 1);
+}
+
+/**
+ * @brief Скасований таймер не спрацьовує і повертається в пул,
+ *        коли колесо доходить до його комірки
+ */
+static void check_cancel(void) {
+    uint8_t cancelled = SOFT_TIMER_NONE;
+    uint8_t id;
+    uint8_t i;
+
+    reset(0);
+    for (i = 0; i < SOFT_TIMER_SLOTS; ++i) {
+        id = soft_timer_start(on_timer, (uint16_t)(10 + i));
+        if (i == 0) {
+            cancelled = id;
+        }
+    }
+    soft_timer_cancel(cancelled);
+    soft_timer_cancel(SOFT_TIMER_NONE);
+    CHECK_EQ(soft_timer_start(on_timer, 1), SOFT_TIMER_NONE);
+
+    advance(10);
+    CHECK_EQ(fired_count, 0);
+    CHECK(soft_timer_start(on_timer, 100) != SOFT_TIMER_NONE);
+
+    advance(10 + SOFT_TIMER_SLOTS);
+    CHECK_EQ(fired_count, SOFT_TIMER_SLOTS - 1);
+    CHECK_EQ(fired_ms[0], 11);
+}
+
+static void check_rearm_from_callback(void) {
+    uint8_t i;
+
+    reset(0);
+    CHECK(soft_timer_start(on_timer_rearm, 5) != SOFT_TIMER_NONE);
+    for (i = 1; i < SOFT_TIMER_SLOTS; ++i) {
+        CHECK(soft_timer_start(on_timer, 1000) != SOFT_TIMER_NONE);
+    }
+    rearm_delay_ms = SOFT_TIMER_WHEEL_SIZE;
+    rearm_id = SOFT_TIMER_NONE;
+
+    advance(5);
+    CHECK_EQ(fired_count, 1);
+    CHECK(rearm_id != SOFT_TIMER_NONE);
+    CHECK_EQ(soft_timer_start(on_timer, 1), SOFT_TIMER_NONE);
+
+    // Перезапущений таймер - в тій самій комірці, але через оберт
+    advance(5 + SOFT_TIMER_WHEEL_SIZE - 1);
+    CHECK_EQ(fired_count, 1);
+    advance(5 + SOFT_TIMER_WHEEL_SIZE);
+    CHECK_EQ(fired_count, 2);
+    CHECK_EQ(fired_ms[1], 5 + SOFT_TIMER_WHEEL_SIZE);
+}
+
+/**
+ * @brief Основний цикл відстав на кілька обертів: всі таймери,
+ *        час яких минув, спрацьовують за один виклик; запуск
+ *        рахується від поточного часу, а не від тіку колеса
+ */
+static void check_late_processing(void) {
+    uint8_t i;
+
+    reset(0);
+    for (i = 0; i < SOFT_TIMER_SLOTS; ++i) {
+        soft_timer_start(on_timer, (uint16_t)(SOFT_TIMER_SLOTS - i));
+    }
+    host_ms = SOFT_TIMER_SLOTS + 3 * SOFT_TIMER_WHEEL_SIZE;
+    CHECK_EQ(soft_timer_process(), SOFT_TIMER_SLOTS);
+    CHECK_EQ(fired_count, SOFT_TIMER_SLOTS);
+
+    reset(0);
+    host_ms = 7;
+    CHECK(soft_timer_start(on_timer, 3) != SOFT_TIMER_NONE);
+    CHECK_EQ(soft_timer_process(), 0);
+    advance(10);
+    CHECK_EQ(fired_count, 1);
+    CHECK_EQ(fired_ms[0], 10);
+}
+
+/**
+ * @brief Вартість при повному пулі, всі таймери в одній комірці
+ *        (гірший випадок обробки тіку)
+ */
+static void bench(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t insert_cycles = 0;
+    uint64_t expire_cycles = 0;
+    uint64_t rotate_cycles = 0;
+    uint64_t idle_cycles = 0;
+    uint64_t start;
+    int round;
+    uint8_t i;
+
+    for (round = 0; round < BENCH_ROUNDS; ++round) {
+        // Запуск до повного пулу, спрацювання всіх на одному тіку
+        host_ms = 0;
+        soft_timer_init();
+        start = __rdtsc();
+        for (i = 0; i < SOFT_TIMER_SLOTS; ++i) {
+            soft_timer_start(on_bench, 1);
+        }
+        insert_cycles += __rdtsc() - start;
+
+        host_ms = 1;
+        start = __rdtsc();
+        soft_timer_process();
+        expire_cycles += __rdtsc() - start;
+
+        // Повна комірка з таймерами на наступних обертах
+        for (i = 0; i < SOFT_TIMER_SLOTS; ++i) {
+            soft_timer_start(on_bench, SOFT_TIMER_MAX_DELAY_MS);
+        }
+        host_ms += SOFT_TIMER_WHEEL_SIZE - 1;
+        start = __rdtsc();
+        soft_timer_process();
+        idle_cycles += __rdtsc() - start;
+
+        host_ms++;
+        start = __rdtsc();
+        soft_timer_process();
+        rotate_cycles += __rdtsc() - start;
+    }
+
+    printf("soft_timer: %d slots, wheel %d: insert %.1f, expire %.1f host cycles/timer\n",
+           SOFT_TIMER_SLOTS, SOFT_TIMER_WHEEL_SIZE,
+           (double)insert_cycles / ((double)BENCH_ROUNDS * SOFT_TIMER_SLOTS),
+           (double)expire_cycles / ((double)BENCH_ROUNDS * SOFT_TIMER_SLOTS));
+    printf("soft_timer: full bucket tick %.1f, empty tick %.1f host cycles\n",
+           (double)rotate_cycles / BENCH_ROUNDS,
+           (double)idle_cycles / ((double)BENCH_ROUNDS * (SOFT_TIMER_WHEEL_SIZE - 1)));
+    CHECK_EQ(bench_calls, (uint32_t)BENCH_ROUNDS * SOFT_TIMER_SLOTS);
+#endif
+}
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+int main(void) {
+    check_full_pool(1000);
+    // Переповнення 16-бітного тіку колеса під час очікування
+    check_full_pool(0xFFFFUL - SOFT_TIMER_WHEEL_SIZE);
+    check_delay_limits();
+    check_cancel();
+    check_rearm_from_callback();
+    check_late_processing();
+
+    bench();
+
+#if (SOFT_TIMER_SLOTS == 4)
+    return TEST_RESULT("soft_timer");
+#else
+    return TEST_RESULT("soft_timer (wide pool)");
+#endif
+}
@@ -0,0 +1,341 @@
+/**
+ * @file    test_spsc_queue.c
+ * @author  Olexandr Makedonskyi
+ * @brief   Стрес-тест spsc_queue: переривання на кожній межі інструкцій
+ * @date    16.10.2026
+ * @version 1.0
+ *
+ * "Переривання" емулюється покроковим виконанням x86 (прапорець
+ * TF): після кожної інструкції основного коду ядро надсилає
+ * SIGTRAP, обробник якого виконує іншу сторону черги.
+ *
+ * 1. Споживач перерваний виробником (кнопки, HC-SR04: ISR пише,
+ *    основний цикл читає) - для кожного заповнення черги та
+ *    кожної межі інструкцій spsc_queue_pop()
+ * 2. Виробник перерваний споживачем (UART TX: основний цикл
+ *    пише, ISR читає) - так само для spsc_queue_push()
+ * 3. Довгий прогін: переривання на псевдовипадкових межах
+ *
+ * Перевіряється: елемент ніколи не читається недописаним,
+ * порядок зберігається, елементи не губляться і не
+ * дублюються, повна черга відкидає запис.
+ */
+
+#define _GNU_SOURCE
+
+//==================== INCLUDES ========================
+#include <signal.h>
+#include <string.h>
+
+#include "host_trace.h"
+#include "spsc_queue.h"
+#include "test_check.h"
+
+#if HOST_TRACE_SUPPORTED
+
+//==================== DEFINES =========================
+
+#define ELEMENT_SIZE    4
+#define CAPACITY        8
+
+#define ISR_PUSH        0       /**< Переривання - виробник */
+#define ISR_POP         1       /**< Переривання - споживач */
+
+#define STRESS_OPERATIONS   3000
+
+//================ PRIVATE VARIABLES ===================
+
+static uint8_t   storage[CAPACITY * ELEMENT_SIZE];
+static SpscQueue queue;
+
+/** @brief Межі інструкцій з початку трасованої операції */
+static volatile uint32_t step_count;
+/** @brief Межа, на якій спрацьовує переривання (0 - ніколи) */
+static volatile uint32_t fire_at;
+/** @brief Період переривань у довгому прогоні (0 - вимкнено) */
+static volatile uint32_t fire_every;
+static volatile int      isr_mode;
+static volatile int      isr_fired;
+static volatile uint8_t  isr_result;
+static uint8_t           isr_element[ELEMENT_SIZE];
+/** @brief Наступний номер, який запише переривання-виробник */
+static volatile uint8_t  isr_next_seq;
+/** @brief Наступний номер, який має прочитати переривання-споживач */
+static volatile uint8_t  isr_pop_seq;
+/** @brief Елементи, прочитані перериванням не по порядку або пошкодженими */
+static volatile uint32_t isr_errors;
+
+//=============== PRIVATE FUNCTION PROTOTYPES ==========
+
+static void make_element(uint8_t seq, uint8_t *element);
+static int  element_seq(const uint8_t *element);
+static void isr_run(void);
+static void trap_handler(int sig, siginfo_t *info, void *context);
+static void prefill(uint8_t fill);
+static int  drain_expect(uint8_t first_seq);
+static void test_consumer_interrupted(uint8_t fill);
+static void test_producer_interrupted(uint8_t fill);
+static void test_stress(void);
+
+//=========== PRIVATE FUNCTION IMPLEMENTATIONS =========
+
+/**
+ * @brief Елемент з номером: усі байти залежать від номера,
+ *        недописаний елемент не проходить element_seq()
+ */
+static void make_element(uint8_t seq, uint8_t *element) {
+    element[0] = seq;
+    element[1] = (uint8_t)~seq;
+    element[2] = (uint8_t)(seq ^ 0x5A);
+    element[3] = (uint8_t)(seq + 0x33);
+}
+
+/**
+ * @return Номер елемента або -1 для пошкодженого
+ */
+static int element_seq(const uint8_t *element) {
+    uint8_t expected[ELEMENT_SIZE];
+
+    make_element(element[0], expected);
+    return memcmp(element, expected, ELEMENT_SIZE) == 0 ? element[0] : -1;
+}
+
+/**
+ * @brief Тіло "переривання": інша сторона черги
+ */
+static void isr_run(void) {
+    isr_fired = 1;
+    if (isr_mode == ISR_PUSH) {
+        make_element(isr_next_seq, isr_element);
+        isr_result = spsc_queue_push(&queue, isr_element);
+        if (isr_result) {
+            isr_next_seq++;
+        }
+    } else {
+        isr_result = spsc_queue_pop(&queue, isr_element);
+        if (isr_result) {
+            if (element_seq(isr_element) != isr_pop_seq) {
+                isr_errors++;
+            }
+            isr_pop_seq++;
+        }
+    }
+}
+
+static void trap_handler(int sig, siginfo_t *info, void *context) {
+    uint32_t step = ++step_count;
+
+    (void)sig;
+    (void)info;
+    (void)context;
+
+    if (step == fire_at || (fire_every != 0 && (step * 2654435761u) % fire_every == 0)) {
+        isr_run();
+    }
+}
+
+/**
+ * @brief Порожня черга з елементами 0..fill-1
+ */
+static void prefill(uint8_t fill) {
+    uint8_t element[ELEMENT_SIZE];
+    uint8_t seq;
+
+    spsc_queue_init(&queue, storage, ELEMENT_SIZE, CAPACITY);
+    memset(storage, 0xEE, sizeof(storage));
+    for (seq = 0; seq < fill; ++seq) {
+        make_element(seq, element);
+        CHECK(spsc_queue_push(&queue, element));
+    }
+    isr_next_seq = fill;
+    isr_pop_seq = 0;
+    isr_errors = 0;
+}
+
+/**
+ * @brief Вичитування черги: номери мають іти поспіль
+ *
+ * @return Номер, наступний за останнім прочитаним
+ */
+static int drain_expect(uint8_t first_seq) {
+    uint8_t element[ELEMENT_SIZE];
+    int seq = first_seq;
+
+    while (spsc_queue_pop(&queue, element)) {
+        CHECK_EQ(element_seq(element), seq);
+        seq++;
+    }
+    CHECK_EQ(spsc_queue_count(&queue), 0);
+    return seq;
+}
+
+/**
+ * @brief Виробник перериває spsc_queue_pop() на кожній межі
+ */
+static void test_consumer_interrupted(uint8_t fill) {
+    uint8_t element[ELEMENT_SIZE];
+    uint32_t boundaries;
+    uint32_t k;
+    uint8_t popped;
+    int next;
+
+    // Пробний прохід: кількість меж у трасованому виклику
+    prefill(fill);
+    fire_at = 0;
+    step_count = 0;
+    host_trace_on();
+    popped = spsc_queue_pop(&queue, element);
+    host_trace_off();
+    boundaries = step_count;
+    CHECK(boundaries > 10);
+
+    for (k = 1; k <= boundaries; ++k) {
+        prefill(fill);
+        isr_mode = ISR_PUSH;
+        isr_fired = 0;
+        fire_at = k;
+        step_count = 0;
+        host_trace_on();
+        popped = spsc_queue_pop(&queue, element);
+        host_trace_off();
+        fire_at = 0;
+
+        CHECK(isr_fired);
+        if (fill > 0) {
+            CHECK_EQ(popped, 1);
+        }
+        if (popped) {
+            // Порожня черга: видно лише повністю записаний елемент
+            CHECK_EQ(element_seq(element), 0);
+        }
+        if (fill < CAPACITY) {
+            CHECK_EQ(isr_result, 1);
+        }
+
+        next = drain_expect(popped ? 1 : 0);
+        CHECK_EQ(next, isr_next_seq);
+    }
+}
+
+/**
+ * @brief Споживач перериває spsc_queue_push() на кожній межі
+ */
+static void test_producer_interrupted(uint8_t fill) {
+    uint8_t element[ELEMENT_SIZE];
+    uint32_t boundaries;
+    uint32_t k;
+    uint8_t pushed;
+
+    prefill(fill);
+    make_element(fill, element);
+    fire_at = 0;
+    step_count = 0;
+    host_trace_on();
+    pushed = spsc_queue_push(&queue, element);
+    host_trace_off();
+    boundaries = step_count;
+    CHECK(boundaries > 10);
+
+    for (k = 1; k <= boundaries; ++k) {
+        prefill(fill);
+        make_element(fill, element);
+        isr_mode = ISR_POP;
+        isr_fired = 0;
+        fire_at = k;
+        step_count = 0;
+        host_trace_on();
+        pushed = spsc_queue_push(&queue, element);
+        host_trace_off();
+        fire_at = 0;
+
+        CHECK(isr_fired);
+        if (fill > 0) {
+            CHECK_EQ(isr_result, 1);
+        }
+        CHECK_EQ(isr_errors, 0);
+        if (fill < CAPACITY) {
+            CHECK_EQ(pushed, 1);
+        } else if (!isr_result) {
+            CHECK_EQ(pushed, 0);
+        }
+
+        // Після вичитування: усі записані елементи по порядку
+        CHECK_EQ(drain_expect(isr_pop_seq), pushed ? fill + 1 : fill);
+    }
+}
+
+/**
+ * @brief Довгий прогін: основний цикл читає, переривання пише
+ *        на псевдовипадкових межах (та навпаки)
+ */
+static void test_stress(void) {
+    uint8_t element[ELEMENT_SIZE];
+    uint8_t expected = 0;
+    uint8_t next = 0;
+    uint32_t received = 0;
+    uint32_t written = 0;
+    int i;
+
+    // Споживач у основному циклі
+    prefill(0);
+    isr_mode = ISR_PUSH;
+    fire_every = 7;
+    host_trace_on();
+    for (i = 0; i < STRESS_OPERATIONS; ++i) {
+        if (spsc_queue_pop(&queue, element)) {
+            CHECK_EQ(element_seq(element), expected);
+            expected++;
+            received++;
+        }
+    }
+    host_trace_off();
+    fire_every = 0;
+    CHECK_EQ(drain_expect(expected), isr_next_seq);
+    CHECK(received > STRESS_OPERATIONS / 4);
+
+    // Виробник у основному циклі: повна черга відкидає запис
+    prefill(0);
+    isr_mode = ISR_POP;
+    fire_every = 11;
+    host_trace_on();
+    for (i = 0; i < STRESS_OPERATIONS; ++i) {
+        make_element(next, element);
+        if (spsc_queue_push(&queue, element)) {
+            next++;
+            written++;
+        }
+    }
+    host_trace_off();
+    fire_every = 0;
+    CHECK_EQ(isr_errors, 0);
+    CHECK_EQ(drain_expect(isr_pop_seq), next);
+    CHECK(written > STRESS_OPERATIONS / 4);
+}
+
+#endif /* HOST_TRACE_SUPPORTED */
+
+//============ PUBLIC FUNCTION IMPLEMENTATIONS =========
+
+int main(void) {
+#if HOST_TRACE_SUPPORTED
+    struct sigaction action;
+    uint8_t fill;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = trap_handler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGTRAP, &action, 0);
+
+    for (fill = 0; fill <= CAPACITY; ++fill) {
+        test_consumer_interrupted(fill);
+        test_producer_interrupted(fill);
+    }
+    test_stress();
+
+    return TEST_RESULT("spsc_queue");
+#else
+    printf("spsc_queue: skipped (single-step needs x86-64)\n");
+    return 0;
+#endif
+}